@@ -5,11 +5,28 @@
 #include <WiFi.h>
 #include <WiFiManager.h>  // https://github.com/tzapu/WiFiManager
 #include "config.h"
+#include "deferred_log.h"
 #include "encoder.h"
 #include "motor_control.h"
 #include "storage.h"
 #include "web_server.h"
 #include "ota_manager.h"
+#include "control_loop.h"
+#include "profiler.h"
+#include "rotctld_server.h"
+#include "rotator_protocol.h"
+#if SAT_TRACKER_ENABLED
+#include "sat_tracker.h"
+#endif
+#if JOURNAL_ENABLED
+#include "position_journal.h"
+#endif
+#if PLANT_SIMULATION
+#include "sim_benchmark.h"
+#endif
+#if MT6701_ENABLED
+#include "absolute_encoder.h"
+#endif
 
 WiFiManager wm;  // Gerenciador WiFi
 
@@ -18,37 +35,53 @@ StorageManager storage;
 MotorController motorController(&encoder, &storage);
 WebServerManager webServer(&motorController, &encoder, &storage);
 OTAManager otaManager;
+RotctldServer rotctld(&motorController, &storage);
+RotatorProtocolServer rotatorProtocol(&motorController, &storage);
 
 // Handle da tarefa de controle do motor
 TaskHandle_t motorTaskHandle = NULL;
 
 unsigned long lastPositionSave = 0;
-unsigned long lastStatusBroadcast = 0;
 const unsigned long POSITION_SAVE_INTERVAL = 5000;
-const unsigned long STATUS_BROADCAST_INTERVAL = 100;  // 10x por segundo (sem enfileirar)
 
 // Tarefa dedicada ao controle do motor e leitura do encoder (Core 0)
 void motorTask(void *pvParameters) {
     Serial.print("Motor Task running on core ");
     Serial.println(xPortGetCoreID());
     
+    // Periodo fixo: esp_timer notifica esta tarefa a cada CONTROL_LOOP_PERIOD_US
+    controlLoop.begin(xTaskGetCurrentTaskHandle(), CONTROL_LOOP_PERIOD_US);
+    
     // Loop infinito da tarefa
     for(;;) {
-        // 1. Atualizar leitura do encoder (filtragem rapida)
-        encoder.update();
+        // Bloqueia ate o proximo tick (libera o core para Idle/WiFi entre ciclos)
+        controlLoop.waitNextCycle();
+        
+        #if PLANT_SIMULATION
+        unsigned long cycleStart = micros();
+        #endif
         
-        // 2. Atualizar controle do motor (PID)
-        motorController.update();
+        {
+            PROFILE_STAGE(PROFILE_STAGE_CYCLE);
+            
+            // 1. Atualizar leitura do encoder (filtragem rapida)
+            encoder.update();
+            
+            // 2. Atualizar controle do motor (PID)
+            motorController.update();
+        }
+        PROFILE_END_CYCLE();
         
-        // Pequeno delay para evitar watchdog e permitir outras tarefas do sistema no Core 0
-        // 1ms eh suficiente para ~1kHz de loop, o que eh otimo para PID
-        vTaskDelay(pdMS_TO_TICKS(1));
+        #if PLANT_SIMULATION
+        simBenchmark.recordUpdateTime(micros() - cycleStart);
+        #endif
     }
 }
 
 void setup() {
     Serial.begin(115200);
     delay(2000);
+    deferredLog.begin();  // LOG_*() das tasks de controle/armazenamento sai por aqui
     
     Serial.println("\n\n========================================");
     Serial.println("Rotor de Antena VHF - ESP32-S3");
@@ -74,6 +107,9 @@ void setup() {
     Serial.println("\n[3/5] Inicializando motor...");
     motorController.begin();
     Serial.println("Motor OK");
+    #if TRACE_ENABLED
+    traceRecorder.begin();  // Anel do trace alocado antes da motorTask gravar
+    #endif
     
     // Criar tarefa do motor no Core 0 (prioridade alta)
     xTaskCreatePinnedToCore(
@@ -81,14 +117,31 @@ void setup() {
         "MotorTask",        // Nome
         4096,               // Stack size (4KB deve ser suficiente)
         NULL,               // Parametros
-        1,                  // Prioridade (1 = acima do Idle, mas cuidado com WiFi que roda no Core 0 as vezes)
+        CONTROL_TASK_PRIORITY, // Prioridade: acorda no tick sem esperar tasks da aplicacao
         &motorTaskHandle,   // Handle
         0                   // Core 0
     );
     Serial.println("Tarefa de controle do motor iniciada no Core 0");
     
-    if (storage.hasLastPosition()) {
-        float lastPos = storage.loadLastPosition();
+    #if PLANT_SIMULATION
+    Serial.println("!!! MODO SIMULACAO: motor e encoder substituidos pelo modelo fisico");
+    simBenchmark.begin(&motorController, &encoder);
+    simBenchmark.start();
+    #endif
+    
+    #if MT6701_ENABLED
+    absoluteEncoder.begin(&encoder, &motorController, &storage);
+    #endif
+    
+    // Journal de posicao: mais recente que a NVS se houve queda no meio do movimento
+    JournalEntry journaled;
+    bool fromJournal = false;
+    #if JOURNAL_ENABLED
+    fromJournal = positionJournal.recover(journaled);
+    #endif
+    
+    if (fromJournal || storage.hasLastPosition()) {
+        float lastPos = fromJournal ? journaled.angle : storage.loadLastPosition();
         Serial.print("Ultima posicao: ");
         Serial.print(lastPos);
         Serial.println(" graus");
@@ -99,7 +152,18 @@ void setup() {
         Serial.println(lastPos);
         
         // Restaurar posição absoluta acumulada
-        float absPos = storage.loadAbsolutePosition();
+        float absPos = fromJournal ? journaled.absolutePosition : storage.loadAbsolutePosition();
+        #if MT6701_ENABLED
+        // A posicao salva escolhe a volta do eixo; o angulo fino vem do MT6701
+        float recovered;
+        if (absoluteEncoder.recoverPosition(absPos, recovered)) {
+            Serial.printf("MT6701: posicao salva %.2f -> %.2f (erro %+.2f graus)\n",
+                          absPos, recovered, recovered - absPos);
+            lastPos += recovered - absPos;
+            encoder.setCalibrationOffset(lastPos);
+            absPos = recovered;
+        }
+        #endif
         motorController.resetAbsolutePosition(absPos);
         Serial.print("Posicao absoluta restaurada: ");
         Serial.println(absPos);
@@ -107,11 +171,14 @@ void setup() {
         // Restaurar o último alvo
         float lastTarget = storage.loadLastTarget();
         if (lastTarget != 0.0) {
-            motorController.moveToAngle(lastTarget);
+            motorController.moveToAngle(lastTarget, COMMAND_SOURCE_LOOP);
             Serial.print("Alvo restaurado: ");
             Serial.println(lastTarget);
         }
     }
+    #if MT6701_ENABLED
+    absoluteEncoder.startFusion();
+    #endif
     
     Serial.println("\n[4/5] Conectando WiFi...");
     
@@ -140,6 +207,18 @@ void setup() {
     Serial.println("\n[5/5] Inicializando OTA e WebServer...");
     otaManager.begin();
     webServer.begin();
+    #if ROTCTLD_ENABLED
+    rotctld.begin();
+    #endif
+    rotatorProtocol.begin();
+    #if JOURNAL_ENABLED
+    positionJournal.begin(&motorController);
+    #endif
+    #if SAT_TRACKER_ENABLED
+    // Relogio UTC via NTP (SGP4 precisa de tempo absoluto)
+    configTime(0, 0, NTP_SERVER_1, NTP_SERVER_2);
+    satTracker.begin(&motorController, &storage);
+    #endif
     
     Serial.println("\n========================================");
     Serial.println("Sistema pronto!");
@@ -154,16 +233,17 @@ void setup() {
 }
 
 void loop() {
+    // GS-232/EasyComm pela serial (nao depende do WiFi)
+    rotatorProtocol.pollSerial();
+    
     // Verificar se WiFi está conectado
     if (WiFi.status() == WL_CONNECTED) {
         otaManager.handle();
         webServer.update();
         
-        // Enviar status via WebSocket periodicamente
-        if (millis() - lastStatusBroadcast > STATUS_BROADCAST_INTERVAL) {
-            webServer.broadcastStatus();
-            lastStatusBroadcast = millis();
-        }
+        // Status via WebSocket: cada cliente tem sua taxa (legado ou {"stream":hz}),
+        // entao o broadcast roda a cada passada do loop (~10ms)
+        webServer.broadcastStatus();
     } else {
         // WiFi desconectado! Reabrir portal de configuração
         Serial.println("\n!!! WiFi desconectado! Abrindo portal de configuração...");
@@ -172,6 +252,8 @@ void loop() {
         
         if (!reconnected) {
             Serial.println("Falha ao reconectar. Reiniciando...");
+            storage.flush();  // Nao perder o que o write-behind ainda nao gravou
+            deferredLog.flush();
             delay(3000);
             ESP.restart();
         } else {
@@ -0,0 +1,244 @@
+#include "absolute_encoder.h"
+#include <Wire.h>
+#include "deferred_log.h"
+#if PLANT_SIMULATION
+#include "plant_simulator.h"
+#endif
+
+AbsoluteEncoder absoluteEncoder;
+
+static float wrap180(float deg) {
+    deg = fmodf(deg, 360.0f);
+    if (deg > 180.0f) deg -= 360.0f;
+    if (deg <= -180.0f) deg += 360.0f;
+    return deg;
+}
+
+void AbsoluteEncoder::begin(Encoder* enc, MotorController* motorController, StorageManager* store) {
+    encoder = enc;
+    motor = motorController;
+    storage = store;
+    published.store(AbsoluteReading{0, 0, 0});
+
+    phaseKnown = storage->loadAbsolutePhase(phaseDeg);
+    if (phaseKnown) LOG_INFO("[MT6701] Fase salva: %.2f graus do eixo", phaseDeg);
+
+    #if !PLANT_SIMULATION
+    Wire.begin(MT6701_SDA_PIN, MT6701_SCL_PIN, MT6701_I2C_CLOCK_HZ);
+    Wire.setTimeOut(MT6701_I2C_TIMEOUT_MS);
+    #endif
+    xTaskCreatePinnedToCore(taskEntry, "MT6701", 3072, this, 1, &taskHandle, 0);
+}
+
+// ==================================================================================
+// LEITURA (task MT6701)
+// ==================================================================================
+
+void AbsoluteEncoder::taskEntry(void* param) {
+    static_cast<AbsoluteEncoder*>(param)->run();
+}
+
+void AbsoluteEncoder::run() {
+    TickType_t lastWake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(1000 / MT6701_READ_HZ));
+        if (rephaseRequested) handleRephaseRequest();
+
+        uint32_t start = micros();
+        uint16_t raw;
+        bool ok = readAngle(raw);
+        uint32_t elapsed = micros() - start;
+        if (elapsed > maxReadUs) maxReadUs = elapsed;
+        if (!ok) {
+            readErrors++;
+            mismatchReads = 0;
+            fusionHealthy = false;
+            continue;
+        }
+        reads++;
+        AbsoluteReading reading = published.load();
+        reading.raw = raw;
+        reading.timeUs = start;
+        reading.sequence++;
+        published.store(reading);
+
+        float shaft = shaftDegrees(raw);
+        // Desenrolado a cada leitura (tambem em movimento): < meia volta do eixo por periodo
+        if (shaftTracking) unwrappedShaft += wrap180(shaft - lastShaft);
+        else unwrappedShaft = shaft;
+        lastShaft = shaft;
+        shaftTracking = true;
+        if (fusionStarted) checkConsistency(shaft);
+        fusionHealthy = fusionStarted && phaseKnown && !rephasePending && !directionFault;
+    }
+}
+
+// Registro 0x03 (ANGLE[13:6]) e 0x04 (ANGLE[5:0] nos bits 7:2) numa leitura so
+bool AbsoluteEncoder::readAngle(uint16_t& raw) {
+    #if PLANT_SIMULATION
+    float shaft = fmodf(plantSimulator.getPositionDeg() * GEAR_RATIO, 360.0f);
+    if (shaft < 0.0f) shaft += 360.0f;
+    raw = (uint16_t)(shaft * MT6701_COUNTS / 360.0f) & (MT6701_COUNTS - 1);
+    return true;
+    #else
+    Wire.beginTransmission(MT6701_I2C_ADDRESS);
+    Wire.write(MT6701_REG_ANGLE_H);
+    if (Wire.endTransmission(false) != 0) return false;   // Repeated start
+    if (Wire.requestFrom((uint8_t)MT6701_I2C_ADDRESS, (uint8_t)2) != 2) return false;
+    uint8_t high = Wire.read();
+    uint8_t low = Wire.read();
+    raw = ((uint16_t)high << 6) | (low >> 2);
+    return true;
+    #endif
+}
+
+// Mesmo sentido da contagem A/B (inversoes de compilacao e de runtime do Encoder)
+float AbsoluteEncoder::shaftDegrees(uint16_t raw) {
+    float shaft = raw * (360.0f / MT6701_COUNTS);
+    bool invert = MT6701_INVERT;
+    #if INVERT_ENCODER_DIRECTION
+    invert = !invert;
+    #endif
+    if (encoder->isRuntimeInverted()) invert = !invert;
+    if (invert && shaft > 0.0f) shaft = 360.0f - shaft;
+    return shaft;
+}
+
+// Volta do eixo mais proxima da posicao dada: erro em ±180/GEAR_RATIO graus da antena
+float AbsoluteEncoder::positionError(float shaftDeg, float absolutePosition) {
+    return wrap180(shaftDeg - phaseDeg - GEAR_RATIO * absolutePosition) / GEAR_RATIO;
+}
+
+// ==================================================================================
+// FUSAO COM A CONTAGEM
+// ==================================================================================
+
+void AbsoluteEncoder::checkConsistency(float shaftDeg) {
+    MotorState state = motor->getState();
+    uint32_t now = millis();
+    if ((state.flags & MOTOR_FLAG_IN_MOTION) || fabs(state.velocityDegPerSec) > 0.5f) {
+        lastMotionMs = now;
+        mismatchReads = 0;
+        return;
+    }
+    if (now - lastMotionMs < MT6701_SETTLE_MS || (int32_t)(now - holdUntilMs) < 0) return;
+
+    float absolutePosition = state.absolutePosition;
+    if (!phaseKnown || rephasePending) {
+        phaseDeg = wrap180(shaftDeg - GEAR_RATIO * absolutePosition);
+        phaseKnown = true;
+        rephasePending = false;
+        referenceValid = false;
+        storage->saveAbsolutePhase(phaseDeg);
+        LOG_INFO("[MT6701] Fase medida: %.2f graus do eixo (abs %.2f)", phaseDeg, absolutePosition);
+        return;
+    }
+
+    // Sentido: entre dois pontos parados o eixo anda GEAR_RATIO vezes o que a contagem
+    // andou. Antes da correcao: com o sentido trocado a "divergencia" seria o movimento
+    if (referenceValid && !directionFault) {
+        float moved = absolutePosition - referenceAbsolute;
+        if (fabs(moved) >= 1.0f) {
+            float shaftMoved = unwrappedShaft - referenceShaft;
+            if (fabs(shaftMoved + GEAR_RATIO * moved) < fabs(shaftMoved - GEAR_RATIO * moved)) {
+                directionFault = true;
+                LOG_ERROR("[MT6701] Sentido oposto ao da contagem (abs %+.1f, eixo %+.1f): fusao desligada, verifique MT6701_INVERT",
+                          moved, shaftMoved);
+                return;
+            }
+        }
+    }
+    referenceShaft = unwrappedShaft;
+    referenceAbsolute = absolutePosition;
+    referenceValid = true;
+    if (directionFault) return;
+
+    float error = positionError(shaftDeg, absolutePosition);
+    lastErrorDeg = error;
+    if (fabs(error) <= MT6701_MISMATCH_DEG) {
+        mismatchReads = 0;
+        return;
+    }
+    if (++mismatchReads < MT6701_MISMATCH_READS) return;
+    mismatchReads = 0;
+    mismatches++;
+    LOG_WARN("[MT6701] Contagem diverge do absoluto: %+.2f graus (abs %.2f)", error, absolutePosition);
+    #if MT6701_AUTO_CORRECT
+    applyCorrection(absolutePosition, error);
+    #endif
+}
+
+// Contagem perdida: posicao absoluta e angulo calibrado andam juntos pelo erro
+void AbsoluteEncoder::applyCorrection(float absolutePosition, float errorDeg) {
+    float offset = encoder->getCalibrationOffset() + errorDeg;
+    encoder->setCalibrationOffset(offset);
+    storage->saveCalibrationOffset(offset);
+    motor->resetAbsolutePosition(absolutePosition + errorDeg);
+    storage->saveAbsolutePosition(absolutePosition + errorDeg);
+    corrections++;
+    referenceValid = false;
+    holdUntilMs = millis() + MT6701_SETTLE_MS;   // resetAbsolutePosition aplica no proximo ciclo
+}
+
+// ==================================================================================
+// BOOT E REFERENCIAL
+// ==================================================================================
+
+bool AbsoluteEncoder::recoverPosition(float savedAbsolute, float& recovered) {
+    if (!phaseKnown || directionFault) return false;
+    uint32_t start = millis();
+    AbsoluteReading reading = published.load();
+    while (reading.sequence == 0 && millis() - start < MT6701_BOOT_WAIT_MS) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+        reading = published.load();
+    }
+    if (reading.sequence == 0) {
+        LOG_WARN("[MT6701] Sem leitura no boot: posicao salva mantida");
+        return false;
+    }
+    recovered = savedAbsolute + positionError(shaftDegrees(reading.raw), savedAbsolute);
+    return true;
+}
+
+void AbsoluteEncoder::startFusion() {
+    lastMotionMs = millis();
+    fusionStarted = true;
+}
+
+// Chamado de async_tcp/SimBench: so a flag; o estado da fusao e da task MT6701
+void AbsoluteEncoder::rephase() {
+    rephaseRequested = true;
+}
+
+void AbsoluteEncoder::handleRephaseRequest() {
+    rephaseRequested = false;
+    rephasePending = true;
+    fusionHealthy = false;
+    shaftTracking = false;         // Inversao muda o sentido do angulo do eixo
+    referenceValid = false;
+    mismatchReads = 0;
+    lastMotionMs = millis();
+}
+
+bool AbsoluteEncoder::getReading(AbsoluteReading& reading) {
+    reading = published.load();
+    return reading.sequence != 0;
+}
+
+void AbsoluteEncoder::writeJSON(JsonObject out) {
+    AbsoluteReading reading = published.load();
+    out["valid"] = reading.sequence != 0;
+    out["raw"] = reading.raw;
+    out["shaftDeg"] = reading.raw * (360.0f / MT6701_COUNTS);
+    out["ageMs"] = reading.sequence != 0 ? (micros() - reading.timeUs) / 1000 : 0;
+    out["reads"] = reads;
+    out["errors"] = readErrors;
+    out["maxReadUs"] = maxReadUs;
+    out["phaseKnown"] = phaseKnown && !rephasePending && !rephaseRequested;
+    out["phaseDeg"] = phaseDeg;
+    out["errorDeg"] = lastErrorDeg;
+    out["mismatches"] = mismatches;
+    out["corrections"] = corrections;
+    out["directionFault"] = directionFault;
+    out["healthy"] = (bool)fusionHealthy;
+}
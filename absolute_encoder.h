@@ -0,0 +1,100 @@
+#ifndef ABSOLUTE_ENCODER_H
+#define ABSOLUTE_ENCODER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "seqlock.h"
+#include "encoder.h"
+#include "motor_control.h"
+#include "storage.h"
+
+// ==================================================================================
+// ENCODER ABSOLUTO MT6701 (I2C) FUNDIDO COM A CONTAGEM A/B
+// ==================================================================================
+// O controle continua na contagem A/B (PCNT, 1 kHz). O angulo absoluto de 14
+// bits do mesmo chip e lido a MT6701_READ_HZ numa task de baixa prioridade (o
+// driver I2C e por interrupcao: a task dorme durante a transferencia, com
+// timeout) e publicado por seqlock; a motorTask nunca toca no barramento.
+//
+// O MT6701 fica no eixo do motor: GEAR_RATIO voltas por volta da antena. Com a
+// fase salva (angulo do eixo na posicao absoluta 0):
+//
+//   angulo_eixo = fase + GEAR_RATIO * posicao_absoluta   (mod 360)
+//
+// - Boot: a posicao salva (NVS/journal) so escolhe a volta do eixo (±180/GEAR_RATIO
+//   graus da antena); o angulo fino vem do sensor, nao do offset salvo.
+// - Parado: contagem e absoluto devem concordar; divergencia persistente =
+//   contagem perdida, corrigida pelo absoluto (MT6701_AUTO_CORRECT).
+// - Entre dois pontos parados o eixo tem de andar no mesmo sentido da contagem;
+//   se andar ao contrario (MT6701_INVERT errado) a fusao e desligada.
+// Calibrar o norte ou inverter o encoder redefine o referencial: rephase().
+
+#define MT6701_REG_ANGLE_H 0x03        // ANGLE[13:6]; 0x04 traz ANGLE[5:0] nos bits 7:2
+#define MT6701_COUNTS 16384
+
+struct AbsoluteReading {
+    uint16_t raw;                  // 0..MT6701_COUNTS-1, lado fisico
+    uint32_t timeUs;
+    uint32_t sequence;             // Leituras validas (0 = nenhuma ainda)
+};
+
+class AbsoluteEncoder {
+private:
+    Encoder* encoder = nullptr;
+    MotorController* motor = nullptr;
+    StorageManager* storage = nullptr;
+    TaskHandle_t taskHandle = NULL;
+    SeqLock<AbsoluteReading> published;
+
+    // Fase e estado da fusao (so a task escreve, exceto as flags de controle)
+    float phaseDeg = 0.0f;         // ±180 graus do eixo
+    bool phaseKnown = false;
+    volatile bool fusionStarted = false;
+    volatile bool rephaseRequested = false;   // Escrito por outras tasks (rephase())
+    bool rephasePending = false;
+    volatile bool fusionHealthy = false;   // Lido pela motorTask na chegada ao alvo
+    bool directionFault = false;
+    uint8_t mismatchReads = 0;
+    uint32_t lastMotionMs = 0;
+    uint32_t holdUntilMs = 0;
+    bool shaftTracking = false;
+    float lastShaft = 0.0f;
+    float unwrappedShaft = 0.0f;   // Angulo do eixo acumulado entre leituras (graus)
+    bool referenceValid = false;   // Ultimo ponto parado (verificacao do sentido)
+    float referenceShaft = 0.0f;
+    float referenceAbsolute = 0.0f;
+
+    // Estatisticas
+    uint32_t reads = 0;
+    uint32_t readErrors = 0;
+    uint32_t maxReadUs = 0;
+    uint32_t mismatches = 0;
+    uint32_t corrections = 0;
+    float lastErrorDeg = 0.0f;
+
+    static void taskEntry(void* param);
+    void run();
+    bool readAngle(uint16_t& raw);
+    float shaftDegrees(uint16_t raw);                        // Referencial da contagem
+    float positionError(float shaftDeg, float absolutePosition);   // Graus da antena
+    void handleRephaseRequest();
+    void checkConsistency(float shaftDeg);
+    void applyCorrection(float absolutePosition, float errorDeg);
+
+public:
+    void begin(Encoder* enc, MotorController* motorController, StorageManager* store);
+    // Boot: posicao salva -> posicao pelo absoluto (false = sem fase ou sem leitura)
+    bool recoverPosition(float savedAbsolute, float& recovered);
+    void startFusion();            // Depois do restauro do boot
+    void rephase();                // Referencial redefinido: fase medida de novo parado
+    // Ultima leitura OK, fase valida e sem falha de sentido: a deriva da contagem e
+    // corrigida aqui (sem isso a chegada volta a sincronizar a posicao com o alvo)
+    bool isFusionHealthy() { return fusionHealthy; }
+    bool getReading(AbsoluteReading& reading);
+    void writeJSON(JsonObject out);
+};
+
+extern AbsoluteEncoder absoluteEncoder;
+
+#endif
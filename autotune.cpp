@@ -0,0 +1,241 @@
+#include "autotune.h"
+
+static const char* const PHASE_NAMES[] = {"idle", "settle", "ramp", "stepLow", "stepHigh", "done", "failed"};
+
+// ==================================================================================
+// MAQUINA DE ESTADOS (motorTask)
+// ==================================================================================
+
+bool Autotuner::start(float absolutePosition, uint32_t nowUs) {
+    float roomCW = MAX_ANGLE - AUTOTUNE_LIMIT_MARGIN_DEG - absolutePosition;
+    float roomCCW = absolutePosition + MAX_ANGLE - AUTOTUNE_LIMIT_MARGIN_DEG;
+    memset(results, 0, sizeof(results));
+    directionsDone = 0;
+    if (max(roomCW, roomCCW) < AUTOTUNE_MAX_TRAVEL_DEG) {
+        fail("sem espaco ate o limite do cabo");
+        return false;
+    }
+    direction = roomCW >= roomCCW ? 1 : -1;
+    directionStartPosition = absolutePosition;
+    failReason = "";
+    settleThen(AUTOTUNE_RAMP, absolutePosition, nowUs);
+    return true;
+}
+
+void Autotuner::enterPhase(AutotunePhase next, float position, uint32_t nowUs) {
+    phase = next;
+    phaseStartUs = nowUs;
+    phaseStartPosition = position;
+    lastPosition = position;
+    stillSinceUs = nowUs;
+    lastSampleUs = nowUs;
+    firstMotionUs = 0;
+    sampleCount = 0;
+    samples[sampleCount++] = position;
+
+    if (next == AUTOTUNE_STEP_LOW) {
+        AutotuneDirection& r = results[directionsDone];
+        r.lowPWM = r.breakawayPWM + AUTOTUNE_STEP_LOW_FRACTION * (PWM_MAX - r.breakawayPWM);
+        r.highPWM = r.breakawayPWM + AUTOTUNE_STEP_HIGH_FRACTION * (PWM_MAX - r.breakawayPWM);
+        pwm = (int)r.lowPWM;
+    } else if (next == AUTOTUNE_STEP_HIGH) {
+        pwm = (int)results[directionsDone].highPWM;
+    } else if (next == AUTOTUNE_RAMP) {
+        pwm = AUTOTUNE_RAMP_START_PWM;
+    } else {
+        pwm = 0;
+    }
+}
+
+void Autotuner::settleThen(AutotunePhase next, float position, uint32_t nowUs) {
+    afterSettle = next;
+    enterPhase(AUTOTUNE_SETTLE, position, nowUs);
+}
+
+void Autotuner::fail(const char* reason) {
+    phase = AUTOTUNE_FAILED;
+    failReason = reason;
+    pwm = 0;
+}
+
+void Autotuner::abort(const char* reason) {
+    if (isActive()) fail(reason);
+}
+
+int Autotuner::update(float position, uint32_t nowUs) {
+    if (!isActive()) return 0;
+    if (fabs(position) > MAX_ANGLE - AUTOTUNE_LIMIT_MARGIN_DEG / 2) {
+        fail("limite do cabo");
+        return 0;
+    }
+    uint32_t elapsedUs = nowUs - phaseStartUs;
+
+    switch (phase) {
+        case AUTOTUNE_SETTLE:
+            // Parado = menos de meio AUTOTUNE_MOTION_DEG em 100 ms
+            if (nowUs - stillSinceUs >= 100000UL) {
+                bool still = fabs(position - lastPosition) < AUTOTUNE_MOTION_DEG / 2;
+                lastPosition = position;
+                stillSinceUs = nowUs;
+                if (still && elapsedUs >= AUTOTUNE_SETTLE_MS * 1000UL) {
+                    enterPhase(afterSettle, position, nowUs);
+                } else if (elapsedUs > AUTOTUNE_SETTLE_MS * 10000UL) {
+                    fail("rotor nao parou");
+                }
+            }
+            break;
+
+        case AUTOTUNE_RAMP:
+            pwm = AUTOTUNE_RAMP_START_PWM + (int)(AUTOTUNE_RAMP_PWM_PER_S * (elapsedUs / 1000000.0f));
+            if (fabs(position - phaseStartPosition) >= AUTOTUNE_MOTION_DEG) {
+                results[directionsDone].breakawayPWM = pwm;
+                settleThen(AUTOTUNE_STEP_LOW, position, nowUs);
+            } else if (pwm > PWM_MAX) {
+                fail("sem movimento ate PWM_MAX");
+            }
+            break;
+
+        case AUTOTUNE_STEP_LOW:
+        case AUTOTUNE_STEP_HIGH: {
+            if (firstMotionUs == 0 && fabs(position - phaseStartPosition) >= AUTOTUNE_MOTION_DEG) {
+                firstMotionUs = nowUs;
+            }
+            if (nowUs - lastSampleUs >= AUTOTUNE_SAMPLE_MS * 1000UL && sampleCount < AUTOTUNE_MAX_SAMPLES) {
+                lastSampleUs += AUTOTUNE_SAMPLE_MS * 1000UL;
+                samples[sampleCount++] = position;
+            }
+            bool timeUp = elapsedUs >= AUTOTUNE_STEP_MS * 1000UL || sampleCount >= AUTOTUNE_MAX_SAMPLES;
+            bool travelUp = fabs(position - directionStartPosition) >= AUTOTUNE_MAX_TRAVEL_DEG;
+            if (timeUp || travelUp) finishStep(position, nowUs);
+            break;
+        }
+
+        default:
+            break;
+    }
+    return pwm * direction;
+}
+
+// ==================================================================================
+// IDENTIFICACAO
+// ==================================================================================
+
+// Minimos quadrados nos ultimos 40% do degrau (regime), no sentido do teste
+float Autotuner::steadyVelocity() {
+    int first = (sampleCount * 3) / 5;
+    int n = sampleCount - first;
+    float dt = AUTOTUNE_SAMPLE_MS / 1000.0f;
+    float sumT = 0, sumX = 0, sumTT = 0, sumTX = 0;
+    for (int i = first; i < sampleCount; i++) {
+        float t = i * dt;
+        float x = (samples[i] - samples[0]) * direction;
+        sumT += t;
+        sumX += x;
+        sumTT += t * t;
+        sumTX += t * x;
+    }
+    float den = n * sumTT - sumT * sumT;
+    return den > 0 ? (n * sumTX - sumT * sumX) / den : 0.0f;
+}
+
+bool Autotuner::finishStep(float position, uint32_t nowUs) {
+    if (sampleCount < 10) {
+        fail("degrau curto demais (curso)");
+        return false;
+    }
+    AutotuneDirection& r = results[directionsDone];
+    float velocity = steadyVelocity();
+    if (velocity <= 0.0f) {
+        fail("sem velocidade de regime");
+        return false;
+    }
+
+    if (phase == AUTOTUNE_STEP_LOW) {
+        if (firstMotionUs == 0) {
+            fail("sem movimento no degrau");
+            return false;
+        }
+        r.lowVelocity = velocity;
+        r.deadTimeS = (firstMotionUs - phaseStartUs) / 1000000.0f;
+        // Assintota x = v (t - L - tau): cruza a posicao inicial em t0 = L + tau
+        float tEnd = (sampleCount - 1) * (AUTOTUNE_SAMPLE_MS / 1000.0f);
+        float xEnd = (samples[sampleCount - 1] - samples[0]) * direction;
+        float t0 = tEnd - xEnd / velocity;
+        r.timeConstantS = max(t0 - r.deadTimeS, 0.005f);
+        enterPhase(AUTOTUNE_STEP_HIGH, position, nowUs);
+        return true;
+    }
+
+    r.highVelocity = velocity;
+    r.gainDpsPerPwm = (r.highVelocity - r.lowVelocity) / (r.highPWM - r.lowPWM);
+    if (r.gainDpsPerPwm <= 0.0f) {
+        fail("velocidade nao cresce com o PWM");
+        return false;
+    }
+    r.frictionPWM = r.lowPWM - r.lowVelocity / r.gainDpsPerPwm;
+
+    directionsDone++;
+    if (directionsDone >= 2) {
+        settleThen(AUTOTUNE_DONE, position, nowUs);
+    } else {
+        direction = -direction;
+        directionStartPosition = position;
+        settleThen(AUTOTUNE_RAMP, position, nowUs);
+    }
+    return true;
+}
+
+bool Autotuner::computeTuning(ControlTuning& out) {
+    if (phase != AUTOTUNE_DONE) return false;
+
+    // Modelo combinado: ganho medio, atrito e atraso do pior sentido
+    float gain = (results[0].gainDpsPerPwm + results[1].gainDpsPerPwm) / 2;
+    float friction = max(max(results[0].frictionPWM, results[1].frictionPWM), 0.0f);
+    float deadTime = max(results[0].deadTimeS, results[1].deadTimeS);
+    float timeConstant = (results[0].timeConstantS + results[1].timeConstantS) / 2;
+    if (!(gain > 0.0f && gain < 100.0f)) return false;  // Tambem rejeita NaN
+
+    // SIMC, processo integrador: Kc = 1 / (k (tc + L)), Ti = 4 (tc + L), Td = tau
+    float tc = max((float)AUTOTUNE_CLOSED_LOOP_TC_S, deadTime);
+    float kc = 1.0f / (gain * (tc + deadTime));    // PWM por grau
+    float ti = 4.0f * (tc + deadTime);
+    float td = timeConstant;
+
+    // O PID do firmware sai em 0..PID_OUTPUT_LIMIT, mapeado em pidMinPWM..pidMaxPWM:
+    // o minimo vence o atrito e a faixa cobre o Kc ate PROFILE_MIN_DEG de erro
+    int minPWM = constrain((int)(friction * AUTOTUNE_FRICTION_MARGIN + 0.5f), 50, PWM_MAX - 100);
+    int maxPWM = constrain((int)(minPWM + kc * PROFILE_MIN_DEG), minPWM + 50, PWM_MAX);
+    float scale = (float)PID_OUTPUT_LIMIT / (maxPWM - minPWM);
+
+    out.kp = kc * scale;
+    out.ki = out.kp / ti;
+    out.kd = out.kp * td;
+    out.pidMinPWM = minPWM;
+    out.pidMaxPWM = maxPWM;
+    out.ffStaticPWM = (int16_t)(friction + 0.5f);
+    out.ffPwmPerDps = 1.0f / gain;
+    out.timeConstantS = timeConstant;
+    out.deadTimeS = deadTime;
+    out.autotuned = 1;
+    return true;
+}
+
+void Autotuner::writeJSON(JsonObject out) {
+    out["phase"] = PHASE_NAMES[phase];
+    if (phase == AUTOTUNE_FAILED) out["error"] = failReason;
+    JsonArray directions = out.createNestedArray("directions");
+    for (int i = 0; i < 2; i++) {
+        const AutotuneDirection& r = results[i];
+        if (r.breakawayPWM == 0) continue;
+        JsonObject d = directions.createNestedObject();
+        d["breakawayPWM"] = r.breakawayPWM;
+        d["lowPWM"] = r.lowPWM;
+        d["lowDps"] = r.lowVelocity;
+        d["highPWM"] = r.highPWM;
+        d["highDps"] = r.highVelocity;
+        d["gainDpsPerPwm"] = r.gainDpsPerPwm;
+        d["frictionPWM"] = r.frictionPWM;
+        d["deadTimeMs"] = r.deadTimeS * 1000.0f;
+        d["timeConstantMs"] = r.timeConstantS * 1000.0f;
+    }
+}
@@ -0,0 +1,120 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// ==================================================================================
+// AJUSTE DO CONTROLE (ganhos + modelo da planta)
+// ==================================================================================
+// Tudo que antes era #define fixo no firmware e depende do rotor (carga do
+// mastro, atrito do sem-fim). Padroes = config.h; o autotune substitui e o
+// registro de estado persiste (storage.h).
+
+struct __attribute__((packed)) ControlTuning {
+    float kp;                      // PID da zona 2°..PROFILE_MIN_DEG (saida 0..PID_OUTPUT_LIMIT)
+    float ki;
+    float kd;
+    int16_t pidMinPWM;             // Saida 0 do PID (vence o auto-travamento)
+    int16_t pidMaxPWM;             // Saida PID_OUTPUT_LIMIT
+    int16_t ffStaticPWM;           // Atrito: PWM em que a velocidade extrapolada zera
+    float ffPwmPerDps;             // 1 / ganho da planta (PWM por grau/s)
+    float timeConstantS;           // Constante de tempo mecanica
+    float deadTimeS;               // Atraso ate o primeiro movimento (informativo)
+    uint8_t autotuned;             // 0 = padroes do config.h
+};
+
+inline ControlTuning defaultControlTuning() {
+    ControlTuning t;
+    t.kp = KP;
+    t.ki = KI;
+    t.kd = KD;
+    t.pidMinPWM = PID_MIN_PWM;
+    t.pidMaxPWM = PID_MAX_PWM;
+    t.ffStaticPWM = TRAJ_FF_STATIC_PWM;
+    t.ffPwmPerDps = TRAJ_FF_PWM_PER_DPS;
+    t.timeConstantS = PROFILE_TIME_CONSTANT_S;
+    t.deadTimeS = 0.0f;
+    t.autotuned = 0;
+    return t;
+}
+
+// ==================================================================================
+// AUTOTUNE POR RESPOSTA AO DEGRAU
+// ==================================================================================
+// Roda dentro da motorTask, em malha aberta, nos dois sentidos:
+//   1. rampa lenta de PWM ate o primeiro movimento (atrito de partida)
+//   2. degrau baixo a partir do repouso: atraso (primeiro movimento) e
+//      constante de tempo (intercepto da assintota de posicao)
+//   3. degrau alto em seguida: a inclinacao entre as duas velocidades de
+//      regime da o ganho (graus/s por PWM) e o atrito dinamico (intercepto)
+// Planta resultante: integradora com 1a ordem e atraso. Ganhos pelas regras
+// SIMC (Skogestad) para processo integrador, com constante de malha fechada
+// AUTOTUNE_CLOSED_LOOP_TC_S. O curso de cada sentido e limitado e o primeiro
+// sentido e o que tem espaco ate o limite do cabo.
+
+enum AutotunePhase : uint8_t {
+    AUTOTUNE_IDLE,
+    AUTOTUNE_SETTLE,               // Freio, esperando parar
+    AUTOTUNE_RAMP,
+    AUTOTUNE_STEP_LOW,
+    AUTOTUNE_STEP_HIGH,
+    AUTOTUNE_DONE,
+    AUTOTUNE_FAILED
+};
+
+struct AutotuneDirection {
+    float breakawayPWM;            // Rampa: PWM no primeiro movimento
+    float deadTimeS;
+    float timeConstantS;
+    float lowPWM, highPWM;
+    float lowVelocity, highVelocity;   // Graus/s de regime (no sentido do teste)
+    float gainDpsPerPwm;
+    float frictionPWM;             // Intercepto da reta velocidade x PWM
+};
+
+#define AUTOTUNE_MAX_SAMPLES ((AUTOTUNE_STEP_MS / AUTOTUNE_SAMPLE_MS) + 1)
+
+class Autotuner {
+private:
+    AutotunePhase phase = AUTOTUNE_IDLE;
+    AutotunePhase afterSettle = AUTOTUNE_IDLE;
+    const char* failReason = "";
+    int8_t direction = 0;          // +1 CW, -1 CCW (sentido do teste atual)
+    uint8_t directionsDone = 0;
+    AutotuneDirection results[2];
+
+    uint32_t phaseStartUs = 0;
+    float phaseStartPosition = 0.0f;
+    float directionStartPosition = 0.0f;
+    float lastPosition = 0.0f;
+    uint32_t stillSinceUs = 0;
+    int pwm = 0;
+
+    // Amostras de posicao do degrau atual (a cada AUTOTUNE_SAMPLE_MS)
+    float samples[AUTOTUNE_MAX_SAMPLES];
+    uint16_t sampleCount = 0;
+    uint32_t lastSampleUs = 0;
+    uint32_t firstMotionUs = 0;
+
+    void enterPhase(AutotunePhase next, float position, uint32_t nowUs);
+    void settleThen(AutotunePhase next, float position, uint32_t nowUs);
+    bool finishStep(float position, uint32_t nowUs);
+    float steadyVelocity();
+    void fail(const char* reason);
+
+public:
+    // Escolhe o primeiro sentido pelo espaco ate ±180°; false = sem espaco
+    bool start(float absolutePosition, uint32_t nowUs);
+    // Um ciclo da motorTask: devolve o PWM com sinal (+ = CW)
+    int update(float absolutePosition, uint32_t nowUs);
+    void abort(const char* reason);
+    bool isActive() { return phase != AUTOTUNE_IDLE && phase != AUTOTUNE_DONE && phase != AUTOTUNE_FAILED; }
+    AutotunePhase getPhase() { return phase; }
+    // Depois de AUTOTUNE_DONE: modelo combinado e ganhos
+    bool computeTuning(ControlTuning& out);
+    void writeJSON(JsonObject out);
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "braking_model.h"
+
+BrakingModel::BrakingModel() {
+    reset(BRAKE_NOMINAL_DEG_PER_DPS);
+}
+
+void BrakingModel::reset(float degPerDps) {
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) theta[i] = 0.0f;
+    theta[1] = degPerDps * BRAKE_RLS_VELOCITY_SCALE;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        for (int j = 0; j < BRAKE_MODEL_PARAMS; j++) {
+            p[i][j] = (i == j) ? BRAKE_RLS_INITIAL_COVARIANCE : 0.0f;
+        }
+    }
+    noiseVariance = BRAKE_RLS_NOISE_PRIOR_DEG2;
+    samples = 0;
+    lastResidual = 0.0f;
+}
+
+// Velocidade normalizada: regressores na mesma ordem de grandeza (float)
+void BrakingModel::regressors(float velocityDps, float pwm, float phi[BRAKE_MODEL_PARAMS]) {
+    float v = fabs(velocityDps) / BRAKE_RLS_VELOCITY_SCALE;
+    float u = constrain(pwm / PWM_MAX, 0.0f, 1.0f);
+    phi[0] = 1.0f;
+    phi[1] = v;
+    phi[2] = v * v;
+    phi[3] = v * u;
+}
+
+float BrakingModel::quadratic(const float phi[BRAKE_MODEL_PARAMS]) {
+    float sum = 0.0f;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        for (int j = 0; j < BRAKE_MODEL_PARAMS; j++) sum += phi[i] * p[i][j] * phi[j];
+    }
+    return sum;
+}
+
+// ==================================================================================
+// RLS COM ESQUECIMENTO
+// ==================================================================================
+
+void BrakingModel::update(float velocityDps, float pwm, float distanceDeg) {
+    float phi[BRAKE_MODEL_PARAMS];
+    regressors(velocityDps, pwm, phi);
+
+    float pPhi[BRAKE_MODEL_PARAMS];
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        pPhi[i] = 0.0f;
+        for (int j = 0; j < BRAKE_MODEL_PARAMS; j++) pPhi[i] += p[i][j] * phi[j];
+    }
+    float phiPPhi = 0.0f;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) phiPPhi += phi[i] * pPhi[i];
+
+    float error = distanceDeg - predict(velocityDps, pwm);
+    samples++;
+    const float lambda = BRAKE_RLS_FORGETTING;
+    float denominator = lambda + phiPPhi;
+    float gain[BRAKE_MODEL_PARAMS];
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        gain[i] = pPhi[i] / denominator;
+        theta[i] += gain[i] * error;
+    }
+
+    // Residuo a posteriori (ja com o theta novo): nao carrega o erro do prior,
+    // entao a variancia do ruido converge junto com o modelo
+    float residual = error * lambda / denominator;
+    lastResidual = residual;
+    float weight = 1.0f / (min((int)samples, 10) + 1);   // O prior conta como uma amostra
+    noiseVariance += weight * (residual * residual - noiseVariance);
+
+    // P = (P - K phi' P) / lambda, simetrizada
+    float trace = 0.0f;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        for (int j = i; j < BRAKE_MODEL_PARAMS; j++) {
+            float value = (p[i][j] - gain[i] * pPhi[j]) / lambda;
+            p[i][j] = value;
+            p[j][i] = value;
+        }
+        trace += p[i][i];
+    }
+    // Sem excitacao nova o esquecimento infla P nas direcoes nao observadas
+    // (mesma velocidade/PWM toda vez): limitar ao valor inicial
+    float maxTrace = BRAKE_MODEL_PARAMS * BRAKE_RLS_INITIAL_COVARIANCE;
+    if (trace > maxTrace) {
+        float scale = maxTrace / trace;
+        for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+            for (int j = 0; j < BRAKE_MODEL_PARAMS; j++) p[i][j] *= scale;
+        }
+    }
+}
+
+float BrakingModel::predict(float velocityDps, float pwm) {
+    float phi[BRAKE_MODEL_PARAMS];
+    regressors(velocityDps, pwm, phi);
+    float distance = 0.0f;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) distance += theta[i] * phi[i];
+    return max(distance, 0.0f);
+}
+
+float BrakingModel::predictionBound(float velocityDps, float pwm) {
+    float phi[BRAKE_MODEL_PARAMS];
+    regressors(velocityDps, pwm, phi);
+    return 2.0f * sqrtf(noiseVariance * max(quadratic(phi), 0.0f));
+}
+
+bool BrakingModel::isTrusted(float velocityDps, float pwm) {
+    return samples >= BRAKE_RLS_MIN_SAMPLES && predictionBound(velocityDps, pwm) <= BRAKE_RLS_TRUST_DEG;
+}
+
+// ==================================================================================
+// PERSISTENCIA E DIAGNOSTICO
+// ==================================================================================
+
+void BrakingModel::save(BrakingModelState& out) {
+    int k = 0;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        out.theta[i] = theta[i];
+        for (int j = i; j < BRAKE_MODEL_PARAMS; j++) out.covariance[k++] = p[i][j];
+    }
+    out.noiseVariance = noiseVariance;
+    out.samples = samples;
+}
+
+bool BrakingModel::load(const BrakingModelState& in) {
+    // Diagonal positiva e valores finitos (x == x falha so para NaN)
+    bool valid = in.noiseVariance >= 0.0f;
+    for (int i = 0; i < BRAKE_MODEL_COVARIANCE_TERMS && valid; i++) valid = in.covariance[i] == in.covariance[i];
+    for (int i = 0; i < BRAKE_MODEL_PARAMS && valid; i++) valid = in.theta[i] == in.theta[i];
+    int k = 0;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS && valid; i++) {
+        valid = in.covariance[k] > 0.0f;   // Diagonal: primeiro termo de cada linha
+        k += BRAKE_MODEL_PARAMS - i;
+    }
+    if (!valid) return false;
+
+    k = 0;
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        theta[i] = in.theta[i];
+        for (int j = i; j < BRAKE_MODEL_PARAMS; j++) {
+            p[i][j] = in.covariance[k];
+            p[j][i] = in.covariance[k];
+            k++;
+        }
+    }
+    noiseVariance = in.noiseVariance;
+    samples = in.samples;
+    return true;
+}
+
+void BrakingModel::writeJSON(JsonObject out) {
+    float refVelocity = BRAKE_RLS_REFERENCE_DPS;
+    float refPWM = PWM_MIN;
+    out["samples"] = samples;
+    out["trusted"] = isTrusted(refVelocity, refPWM);
+    JsonArray params = out.createNestedArray("theta");
+    JsonArray sigmas = out.createNestedArray("thetaSigma");
+    for (int i = 0; i < BRAKE_MODEL_PARAMS; i++) {
+        params.add(theta[i]);
+        sigmas.add(sqrtf(max(noiseVariance * p[i][i], 0.0f)));
+    }
+    out["noiseSigmaDeg"] = sqrtf(noiseVariance);
+    out["lastResidualDeg"] = lastResidual;
+    // Previsao no ponto de referencia (fim de aproximacao tipico) com banda de 2 sigma
+    out["refDistanceDeg"] = predict(refVelocity, refPWM);
+    out["refBoundDeg"] = predictionBound(refVelocity, refPWM);
+}
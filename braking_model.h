@@ -0,0 +1,61 @@
+#ifndef BRAKING_MODEL_H
+#define BRAKING_MODEL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// ==================================================================================
+// MODELO DE FRENAGEM (minimos quadrados recursivos)
+// ==================================================================================
+// Distancia percorrida depois do corte do PWM (freio ativo), um modelo por
+// sentido (CW/CCW: a carga do mastro nao e simetrica):
+//
+//   s = th0 + th1 * v + th2 * v^2 + th3 * v * u      v = |velocidade| / escala
+//                                                    u = PWM no corte / PWM_MAX
+//
+// O termo constante cobre folga/elasticidade do sem-fim e o atraso do filtro
+// do encoder, v o atraso ate o freio pegar, v^2 a energia cinetica e v*u a
+// corrente do motor no instante do corte. Cada frenagem observada (qualquer
+// queda do PWM para 0 acima de BRAKE_RLS_MIN_VELOCITY_DPS) e uma amostra. A
+// covariancia P da a incerteza de cada previsao: o controle so usa o modelo
+// quando o intervalo de 2 sigma daquela previsao e estreito.
+
+#define BRAKE_MODEL_PARAMS 4
+#define BRAKE_MODEL_COVARIANCE_TERMS (BRAKE_MODEL_PARAMS * (BRAKE_MODEL_PARAMS + 1) / 2)
+
+struct __attribute__((packed)) BrakingModelState {
+    float theta[BRAKE_MODEL_PARAMS];
+    float covariance[BRAKE_MODEL_COVARIANCE_TERMS];  // Triangulo superior de P, linha a linha
+    float noiseVariance;           // Graus^2, residuo a posteriori
+    uint16_t samples;
+};
+
+class BrakingModel {
+private:
+    float theta[BRAKE_MODEL_PARAMS];
+    float p[BRAKE_MODEL_PARAMS][BRAKE_MODEL_PARAMS];
+    float noiseVariance;
+    uint16_t samples;
+    float lastResidual = 0.0f;
+
+    static void regressors(float velocityDps, float pwm, float phi[BRAKE_MODEL_PARAMS]);
+    float quadratic(const float phi[BRAKE_MODEL_PARAMS]);   // phi' P phi
+
+public:
+    BrakingModel();
+    // Prior: s = degPerDps * |velocidade|, com covariancia inicial (pouca confianca)
+    void reset(float degPerDps);
+    void update(float velocityDps, float pwm, float distanceDeg);
+    float predict(float velocityDps, float pwm);
+    float predictionBound(float velocityDps, float pwm);   // 2 sigma, graus
+    // Convergiu para este ponto: amostras minimas e 2 sigma <= BRAKE_RLS_TRUST_DEG
+    bool isTrusted(float velocityDps, float pwm);
+    uint16_t getSamples() { return samples; }
+
+    void save(BrakingModelState& out);
+    bool load(const BrakingModelState& in);   // false = estado invalido (mantem o atual)
+    void writeJSON(JsonObject out);
+};
+
+#endif
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+# Gera web_assets_gz.h a partir de web_assets.h (fonte editavel do painel Web).
+#
+# Para cada asset: minificacao conservadora (so espacos/comentarios de linha
+# inteira, sem reescrever codigo), gzip deterministico (mtime=0) e hash SHA-256
+# do conteudo. O hash vira o ETag e o "?v=" das URLs de style.css/app.js no
+# index, entao CSS/JS podem ser servidos com Cache-Control immutable.
+#
+# Uso (rodar sempre que web_assets.h mudar, antes de compilar):
+#   python build_web_assets.py          # regenera web_assets_gz.h
+#   python build_web_assets.py --check  # falha se web_assets_gz.h estiver desatualizado
+
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+SOURCE = os.path.join(ROOT, "web_assets.h")
+OUTPUT = os.path.join(ROOT, "web_assets_gz.h")
+
+# (nome no web_assets.h, prefixo gerado, mime, URL)
+ASSETS = [
+    ("STYLE_CSS", "STYLE_CSS", "text/css", "/style.css"),
+    ("APP_JS", "APP_JS", "application/javascript", "/app.js"),
+    ("INDEX_HTML", "INDEX_HTML", "text/html", "/"),
+]
+
+
+def read_literals(text):
+    literals = {}
+    pattern = re.compile(r'const char (\w+)\[\] PROGMEM = R"rawliteral\((.*?)\)rawliteral";', re.S)
+    for name, body in pattern.findall(text):
+        literals[name] = body
+    return literals
+
+
+def strip_lines(text, comment_prefix=None):
+    out = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line:
+            continue
+        if comment_prefix and line.startswith(comment_prefix):
+            continue
+        out.append(line)
+    return "\n".join(out) + "\n"
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return strip_lines(text)
+
+
+def minify_js(text):
+    # Template strings multi-linha dependem da indentacao: nao mexer
+    if "`" in text:
+        return text
+    # Apenas comentarios de linha inteira; as quebras de linha ficam (ASI)
+    return strip_lines(text, "//")
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    if re.search(r"<(pre|textarea)\b", text):
+        return text
+    return strip_lines(text)
+
+
+def gzip_bytes(data):
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def content_hash(data):
+    return hashlib.sha256(data).hexdigest()[:16]
+
+
+def c_array(name, data):
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "const uint8_t %s[] PROGMEM = {\n%s\n};\n" % (name, "\n".join(lines))
+
+
+def generate():
+    with open(SOURCE, "r", encoding="utf-8") as f:
+        source_text = f.read()
+    literals = read_literals(source_text)
+
+    minifiers = {"text/css": minify_css, "application/javascript": minify_js, "text/html": minify_html}
+    hashes = {}
+    blocks = []
+    summary = []
+
+    for name, prefix, mime, url in ASSETS:
+        if name not in literals:
+            sys.exit("build_web_assets: %s nao encontrado em web_assets.h" % name)
+        text = minifiers[mime](literals[name])
+        if name == "INDEX_HTML":
+            # Referencias versionadas: um deploy novo muda a URL, o cache antigo nunca e usado
+            for asset_url, asset_hash in hashes.items():
+                text = text.replace('"%s"' % asset_url, '"%s?v=%s"' % (asset_url, asset_hash))
+        raw = text.encode("utf-8")
+        digest = content_hash(raw)
+        hashes[url] = digest
+        packed = gzip_bytes(raw)
+        summary.append("// %-10s %6d -> %6d bytes (gzip), etag %s" % (name, len(literals[name].encode("utf-8")), len(packed), digest))
+        blocks.append(c_array(prefix + "_GZ", packed))
+        blocks.append("const size_t %s_GZ_LEN = %d;\n" % (prefix, len(packed)))
+        blocks.append('#define %s_ETAG "\\"%s\\""\n' % (prefix, digest))
+
+    header = [
+        "#pragma once\n",
+        "// GERADO por build_web_assets.py a partir de web_assets.h - NAO EDITAR\n",
+        "// Fonte: sha256 %s\n" % content_hash(source_text.encode("utf-8")),
+        "\n".join(summary) + "\n",
+        "\n#include <Arduino.h>\n\n",
+    ]
+    return "".join(header) + "\n".join(blocks)
+
+
+def main():
+    generated = generate()
+    if "--check" in sys.argv:
+        current = ""
+        if os.path.exists(OUTPUT):
+            with open(OUTPUT, "r", encoding="utf-8") as f:
+                current = f.read()
+        if current != generated:
+            sys.exit("web_assets_gz.h desatualizado: rode python build_web_assets.py")
+        print("web_assets_gz.h atualizado")
+        return
+    with open(OUTPUT, "w", encoding="utf-8", newline="\n") as f:
+        f.write(generated)
+    print("Gerado %s" % os.path.basename(OUTPUT))
+
+
+if __name__ == "__main__":
+    main()
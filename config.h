@@ -12,6 +12,31 @@
 #define ENCODER_PPR 4096
 #define GEAR_RATIO 5.0
 #define INVERT_ENCODER_DIRECTION true
+#define ENCODER_FILTER_WINDOW 7  // Janela da media movel (amostras); soma corrente O(1)
+// Velocidade por instante de borda: interrupcao em A e B grava o micros() da
+// ultima borda; em baixa rotacao a velocidade sai do tempo entre bordas
+#define ENCODER_EDGE_CAPTURE true
+#define ENCODER_EDGE_COUNTS 8            // Periodo medido sobre ate N contagens
+#define ENCODER_EDGE_WINDOW_MS 100       // Bordas mais antigas nao entram na medida
+#define ENCODER_EDGE_TIMEOUT_MS 200      // Sem borda ha mais que isso = parado
+#define ENCODER_EDGE_MAX_DPS 20.0        // Acima disso vale a velocidade por contagem (EMA)
+
+// ========== Encoder MT6701 absoluto (I2C, ver absolute_encoder.h) ==========
+// Angulo de 14 bits do eixo do encoder, lido numa task propria e fundido com a
+// contagem A/B: boot sem depender so da posicao salva e deteccao de contagem perdida
+#define MT6701_ENABLED true
+#define MT6701_SDA_PIN 8
+#define MT6701_SCL_PIN 9
+#define MT6701_I2C_ADDRESS 0x06
+#define MT6701_I2C_CLOCK_HZ 400000
+#define MT6701_I2C_TIMEOUT_MS 5          // Transferencia travada nao segura a task
+#define MT6701_READ_HZ 20                // Leituras por segundo
+#define MT6701_INVERT false              // true se o angulo I2C cresce no sentido em que a contagem A/B diminui
+#define MT6701_SETTLE_MS 300             // Parado ha este tempo = compara contagem x absoluto
+#define MT6701_MISMATCH_DEG 0.3          // Divergencia (graus da antena) acima disso...
+#define MT6701_MISMATCH_READS 5          // ...em N leituras seguidas = contagem perdida
+#define MT6701_AUTO_CORRECT true         // Corrige a posicao pelo absoluto (so parado)
+#define MT6701_BOOT_WAIT_MS 200          // Boot: espera pela primeira leitura valida
 
 // ========== Motor BTS7960 (ESP32-S3 compatible pins) ==========
 #define MOTOR_RPWM 6
@@ -37,39 +62,187 @@
 #define KP 2.5                   // Ganho proporcional
 #define KI 0.01                  // Integral reduzido (evita oscillação)
 #define KD 0.35                  // Damping maior para eliminar oscilação
-#define PID_OUTPUT_LIMIT 600     // Acompanha PWM_MAX
+#define PID_OUTPUT_LIMIT 600     // Escala da saida do PID (mapeada em PID_MIN_PWM..PID_MAX_PWM)
+#define PID_MIN_PWM 150          // Saida 0 do PID: vence o auto-travamento
+#define PID_MAX_PWM 450          // Saida PID_OUTPUT_LIMIT
+// Ganhos, faixa de PWM e modelo do feedforward sao os padroes: o autotune
+// (POST /api/autotune) mede a planta de cada rotor e grava os seus
+
+// ========== Autotune (resposta ao degrau, ver autotune.h) ==========
+#define AUTOTUNE_SETTLE_MS 400           // Parado por este tempo antes de cada etapa
+#define AUTOTUNE_RAMP_START_PWM 40
+#define AUTOTUNE_RAMP_PWM_PER_S 150.0    // Rampa lenta: atrito de partida
+#define AUTOTUNE_MOTION_DEG 0.15         // Deslocamento que conta como movimento (> ruido do encoder)
+#define AUTOTUNE_STEP_MS 1000            // Duracao maxima de cada degrau
+#define AUTOTUNE_SAMPLE_MS 10            // Amostragem da posicao no degrau
+#define AUTOTUNE_STEP_LOW_FRACTION 0.35  // Degraus entre o atrito de partida e PWM_MAX
+#define AUTOTUNE_STEP_HIGH_FRACTION 0.8
+#define AUTOTUNE_MAX_TRAVEL_DEG 120.0    // Curso maximo por sentido
+#define AUTOTUNE_LIMIT_MARGIN_DEG 10.0   // Distancia minima do limite do cabo
+#define AUTOTUNE_CLOSED_LOOP_TC_S 0.4    // Constante de malha fechada desejada (SIMC)
+#define AUTOTUNE_FRICTION_MARGIN 1.1     // PID_MIN_PWM = atrito medido x margem
 
 // ========== Controle de Precisao (Sistema de Zonas) ==========
-// Motor auto-travante: começar a freiar MUITO antes para distâncias longas
-#define ZONE_FAST 100.0          // Começa desaceleração muito cedo (era 60)
-#define ZONE_MEDIUM 50.0         // Segunda etapa de freio (era 30)
-#define ZONE_SLOW 20.0           // Zona PID expandida (era 12)
-#define ZONE_MEDIUM_SLOW 5.0     // Novo: Frenagem adicional antes do CRAWL
-#define ZONE_CRAWL 0.5           
-// Distribuição de PWM por zona:
-// > 100° = PWM máximo com aceleração suave
-// 50-100° = Reduz PWM linearmente (começa freio)
-// 20-50° = PWM reduzido mais agressivamente
-// 5-20° = PWM muito reduzido (frenagem fina)
-// 0.5-5° = PWM proporcional decrescente
-// 0.2-0.5° = pulsos curtos (60ms ON / 90ms OFF) - reduzido 25%
-// < 0.2° = micro pulsos (37ms ON / 150ms OFF) - reduzido 25%
+// Distribuição por erro:
+// >= PROFILE_MIN_DEG = perfil curva S em malha fechada (ver abaixo)
+// 2° a PROFILE_MIN_DEG = PID
+// < 2° = pulsos curtos (23-45ms ON a cada 250ms)
+
+// ========== Perfil de Movimento (curva S com jerk limitado) ==========
+// Movimentos longos seguem uma referencia planejada (posicao/velocidade/aceleracao)
+// com o mesmo feedforward + PI da trajetoria; a velocidade maxima sai do modelo
+// de feedforward (PWM maximo da velocidade configurada, com margem para o PI)
+#define PROFILE_MIN_DEG 5.0          // Erro a partir do qual o perfil e planejado
+#define PROFILE_VEL_MARGIN 0.85      // Fracao da velocidade alcancavel usada no cruzeiro
+#define PROFILE_MAX_ACCEL_DPS2 120.0 // Graus/s^2
+#define PROFILE_MAX_JERK_DPS3 600.0  // Graus/s^3
+#define PROFILE_TIME_CONSTANT_S 0.08 // Constante de tempo mecanica (feedforward da aceleracao)
+
+// ========== Modelo de Frenagem (RLS, ver braking_model.h) ==========
+// Distancia de frenagem aprendida por sentido a cada corte do PWM com o rotor
+// andando; so e usada (frenagem antecipada na zona PID) quando o intervalo de
+// 2 sigma da previsao fica abaixo de BRAKE_RLS_TRUST_DEG
+#define BRAKE_RLS_FORGETTING 0.98         // Memoria efetiva ~50 frenagens (acompanha desgaste/temperatura)
+#define BRAKE_RLS_INITIAL_COVARIANCE 10.0 // Incerteza do prior (graus^2 por regressor^2)
+#define BRAKE_RLS_VELOCITY_SCALE 10.0     // Normalizacao da velocidade nos regressores (graus/s)
+#define BRAKE_RLS_NOISE_PRIOR_DEG2 0.01   // Variancia inicial do residuo (0.1 grau de desvio)
+#define BRAKE_RLS_MIN_VELOCITY_DPS 2.0    // Cortes mais lentos nao viram amostra (ruido do encoder)
+#define BRAKE_RLS_MIN_SAMPLES 3
+#define BRAKE_RLS_TRUST_DEG 0.15          // 2 sigma maximo para o controle usar a previsao
+#define BRAKE_RLS_REFERENCE_DPS 10.0      // Ponto de referencia (com PWM_MIN) dos valores exibidos
+#define BRAKE_NOMINAL_DEG_PER_DPS 0.1     // Prior: graus de frenagem por grau/s
+#define BRAKE_STILL_DEG 0.05              // Deslocamento abaixo disso = parado (~2 contagens)
+#define BRAKE_STILL_MS 30                 // Parado por este tempo = fim da frenagem
+#define BRAKE_TIMEOUT_MS 2000             // Frenagem mais longa que isso e descartada
+
+// ========== Dinamica por Setor (ver sector_dynamics.h) ==========
+// Desvio da frenagem e atrito de partida por setor de azimute e sentido: um
+// setor "pegajoso" recebe PWM minimo maior sem deixar os outros mais lentos
+#define DYNAMICS_SECTOR_COUNT 36        // Setores de 10 graus, por sentido
+#define DYNAMICS_LEARNING_RATE 0.3      // Peso de cada amostra (depois das primeiras)
+#define DYNAMICS_MIN_SAMPLES 2          // Celula usada a partir de N amostras
+#define DYNAMICS_BREAKAWAY_DEG 0.05     // Deslocamento que marca a saida do lugar (~3 contagens)
+#define DYNAMICS_STALL_MS 100           // Travado com PWM aplicado por mais que isso = amostra de partida
+#define DYNAMICS_BREAKAWAY_TIMEOUT_MS 1000   // Parado com PWM esse tempo = limite inferior
+#define DYNAMICS_STALL_STEP_PWM 20      // Limite inferior: PWM travado + passo
+#define DYNAMICS_BREAKAWAY_MARGIN_PWM 60 // Piso no setor: atrito de partida + margem (pulso, PID, trajetoria)
+#define DYNAMICS_NVS_KEY "dyntab"
+
+// ========== Observador de Estado (ver state_observer.h) ==========
+// Posicao de controle sem o atraso do filtro do encoder: previsao pelo PWM
+// aplicado + correcao pela contagem bruta (o display continua com a filtrada)
+#define OBSERVER_ENABLED true
+#define OBSERVER_ALPHA 0.1                  // Ganho de posicao por ciclo (beta sai de Benedict-Bordner)
+#define OBSERVER_BRAKE_TIME_CONSTANT_S 0.025 // PWM 0: freio ativo + sem-fim auto-travante
+#define OBSERVER_RESYNC_DEG 1.0             // Residuo maior (reset, inversao) = reinicia na medida
+
+// ========== Trajetoria (alvo em movimento) ==========
+// Fila de waypoints (tempo, azimute) interpolada a cada ciclo; PWM = feedforward
+// da velocidade da referencia + PI no erro de posicao. Sem zonas nem pulsos.
+#define TRAJECTORY_MAX_WAYPOINTS 32
+#define TRAJ_FF_PWM_PER_DPS 8.0      // PWM por grau/s acima do atrito (~ (PWM_MAX - atrito) / vel. maxima)
+#define TRAJ_FF_STATIC_PWM 110       // PWM para vencer o atrito do sem-fim
+#define TRAJ_FF_MIN_DPS 0.05         // Abaixo disso a referencia e considerada parada
+#define TRAJ_KP 40.0                 // PWM por grau de atraso
+#define TRAJ_KI 20.0                 // PWM por grau*segundo de atraso acumulado
+#define TRAJ_HOLD_DEG 0.3            // Atraso tolerado com o motor travado (referencia lenta)
 
 // ========== Behavior ==========
 #define MAX_ANGLE 180.0
 #define ANGLE_TOLERANCE 0.25     // Tolerancia de 0.25 graus (mais realista para motor com engrenagem)
 #define UPDATE_INTERVAL 10       // Atualizar a cada 10ms (100Hz - mais responsivo)
+#define CONTROL_LOOP_PERIOD_US 1000  // Periodo do timer da motorTask (1kHz)
+#define MOTOR_COMMAND_QUEUE_SIZE 16   // Slots por fila de comandos (potencia de 2; 15 uteis)
+#define PROFILER_ENABLED true        // Ciclos de CPU por etapa da motorTask (/api/profile); false = sem custo
+#define CONTROL_TASK_PRIORITY 10     // Acima das tasks de rede da aplicacao (esp_timer = 22)
 #define SAVE_POSITION_INTERVAL 5000
 
 // ========== Storage (NVS) ==========
 #define CALIBRATION_KEY "calib"
 #define POSITION_KEY "lastpos"
+#define STORAGE_WRITEBACK_DELAY_MS 1000  // Atualizacoes dentro desta janela viram uma gravacao
+#define STORAGE_WRITEBACK_POLL_MS 100    // Periodo da task de write-behind
+
+// ========== Journal de Posicao (queda de energia) ==========
+#define JOURNAL_ENABLED true
+#define JOURNAL_RATE_HZ 50                 // Amostragem da posicao publicada
+#define JOURNAL_RTC_THRESHOLD_DEG 0.1      // Nova entrada na RTC quando a posicao andar isto
+#define JOURNAL_FLASH_THRESHOLD_DEG 1.0    // Nova entrada na flash (e sempre na parada)
+#define JOURNAL_RTC_ENTRIES 32
+#define JOURNAL_PARTITION_LABEL "spiffs"   // Particao de dados sem uso (o firmware nao usa SPIFFS)
+#define JOURNAL_FLASH_SECTORS 4            // 4 x 4 KB = 1024 entradas de 16 bytes
+
+// ========== Log Diferido ==========
+// LOG_*() so enfileira; a task Log formata e escreve na Serial (ver deferred_log.h)
+#define LOG_LEVEL LOG_LEVEL_INFO     // NONE, ERROR, WARN, INFO ou DEBUG (niveis acima nao sao compilados)
+#define LOG_QUEUE_SIZE 64            // Registros na fila (potencia de 2, 44 bytes cada no ESP32)
+#define LOG_LINE_MAX 160             // Linha formatada
+#define LOG_DRAIN_INTERVAL_MS 20
+
+// ========== Gravador de Trace (ajuste do controle) ==========
+// Uma amostra de 24 bytes por ciclo da motorTask (ver trace_recorder.h)
+#define TRACE_ENABLED true
+#define TRACE_PSRAM_SAMPLES 65536        // Potencia de 2: 1.5 MB na PSRAM = ~65 s a 1 kHz
+#define TRACE_FALLBACK_SAMPLES 1024      // Sem PSRAM: 24 KB na RAM interna (~1 s)
+#define TRACE_AUTO_ON_MOVE true          // Cada alvo ponto a ponto inicia uma captura
+#define TRACE_POST_MOTION_MS 500         // Continua gravando depois da parada (assentamento)
 
 // ========== Web Server ==========
 #define WEB_SERVER_PORT 80
+#define WS_STREAM_MAX_HZ 50          // Taxa maxima de streaming por cliente ({"stream":hz})
+#define WS_STREAM_KEYFRAME_MS 1000   // Frame completo periodico entre os deltas
+
+// ========== Hamlib rotctld (gpredict, loggers) ==========
+#define ROTCTLD_ENABLED true
+#define ROTCTLD_PORT 4533
+#define ROTCTLD_MAX_CLIENTS 4
+
+// ========== GS-232A/B e EasyComm II (programas de estacao) ==========
+// Na serial, os logs de debug dividem a mesma porta: use com DEBUG_SERIAL false
+// ou aponte ROTATOR_SERIAL para outra porta (ex.: Serial0 = UART do S3)
+#define ROTATOR_SERIAL_ENABLED false
+#define ROTATOR_SERIAL Serial            // USB-CDC com "USB CDC On Boot" habilitado
+#define ROTATOR_TCP_ENABLED true
+#define ROTATOR_TCP_PORT 4534
+#define ROTATOR_TCP_MAX_CLIENTS 2
+#define GS232_VARIANT_B true             // Formato das respostas: true = "AZ=nnn", false = GS-232A "+0nnn"
+
+// ========== Rastreio de Satelites (SGP4) ==========
+#define SAT_TRACKER_ENABLED true
+#define NTP_SERVER_1 "pool.ntp.org"
+#define NTP_SERVER_2 "a.st1.ntp.br"
+#define QTH_DEFAULT_LAT -22.8            // Graus (norte +); ajustavel via /api/sat/qth
+#define QTH_DEFAULT_LON -47.0            // Graus (leste +)
+#define QTH_DEFAULT_ALT 600.0            // Metros
+#define SAT_USE_FLOAT false              // true = SGP4 em float (FPU do S3), ~dezenas de metros de erro
+#define SAT_TRACK_RATE_HZ 10             // Passos de propagacao por segundo
+#define SAT_TRACK_STEP_DEG 1.0           // Novo alvo quando o azimute andar isto desde o ultimo comando
+#define SAT_MIN_ELEVATION_DEG 0.0        // Horizonte (AOS/LOS)
+#define SAT_PREPOSITION_S 120            // Antes do AOS: apontar para o azimute de entrada
+#define SAT_TRACK_TRAJECTORY true        // Durante a passagem: waypoints (sem anda-para) em vez de moveToAngle
+#define SAT_TRAJ_LEAD_MS 2000            // Antecedencia do waypoint mais a frente (um novo por segundo)
+#define SAT_MAX_PASSES 8                 // Tabela de passagens pre-calculadas
+#define SAT_PASS_HORIZON_H 24            // Janela de busca de passagens
+#define SAT_PASS_SCAN_STEP_S 60          // Passo grosso da busca (passagens < 1 min podem ser perdidas)
 
 // ========== Debug ==========
 #define DEBUG_SERIAL true
 #define SERIAL_BAUDRATE 115200
 
+// ========== Simulador de Planta (bancada sem motor/torre) ==========
+// true = encoder e motor substituidos pelo modelo fisico (plant_simulator)
+// e os cenarios de benchmark rodam automaticamente no boot (o build de host/ forca true)
+#ifndef PLANT_SIMULATION
+#define PLANT_SIMULATION false
+#endif
+#define SIM_MAX_SPEED_DPS 60.0           // Velocidade da antena em PWM_MAX (graus/s)
+#define SIM_BREAKAWAY_PWM 110            // PWM minimo para vencer atrito do sem-fim
+#define SIM_STICKY_CENTER_DEG 90.0       // Trecho com atrito maior (posicao do eixo simulado)
+#define SIM_STICKY_WIDTH_DEG 0.0         // Largura do trecho (0 = atrito uniforme)
+#define SIM_STICKY_EXTRA_PWM 70          // Atrito adicional dentro do trecho
+#define SIM_TIME_CONSTANT_MS 80          // Constante de tempo mecanica (aceleracao)
+#define SIM_BRAKE_TIME_CONSTANT_MS 25    // Frenagem ativa (auto-travante para rapido)
+#define SIM_ENCODER_NOISE_PULSES 1       // Ruido do encoder (+/- pulsos)
+#define SIM_SCENARIO_TIMEOUT_MS 30000    // Tempo maximo por cenario
+
 #endif
@@ -0,0 +1,97 @@
+#include "control_loop.h"
+#include "config.h"
+
+ControlLoopTimer controlLoop;
+
+// Limites superiores (us) de cada faixa do histograma de jitter; a ultima e "acima"
+static const uint32_t JITTER_BUCKET_LIMITS[CONTROL_JITTER_BUCKETS - 1] = {
+    10, 25, 50, 100, 250, 500, 1000
+};
+
+ControlLoopTimer::ControlLoopTimer() {
+    for (int i = 0; i < CONTROL_JITTER_BUCKETS; i++) histogram[i] = 0;
+}
+
+void ControlLoopTimer::onTimer(void* arg) {
+    ControlLoopTimer* self = static_cast<ControlLoopTimer*>(arg);
+    xTaskNotifyGive(self->task);
+}
+
+bool ControlLoopTimer::begin(TaskHandle_t controlTask, uint32_t period) {
+    task = controlTask;
+    periodUs = period;
+
+    esp_timer_create_args_t args = {};
+    args.callback = &ControlLoopTimer::onTimer;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "ctrl_loop";
+
+    if (esp_timer_create(&args, &timer) != ESP_OK) {
+        Serial.println("[Loop] ERRO: falha ao criar esp_timer");
+        return false;
+    }
+    if (esp_timer_start_periodic(timer, periodUs) != ESP_OK) {
+        Serial.println("[Loop] ERRO: falha ao iniciar esp_timer");
+        return false;
+    }
+    lastWakeUs = esp_timer_get_time();
+    Serial.printf("[Loop] Timer de controle: %u us (%.0f Hz)\n", (unsigned)periodUs, 1000000.0f / periodUs);
+    return true;
+}
+
+uint32_t ControlLoopTimer::waitNextCycle() {
+    // Mais de uma notificacao pendente = ticks perdidos enquanto o ciclo rodava
+    uint32_t pending = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(10));
+    if (pending > 1) {
+        overruns += pending - 1;
+    }
+
+    int64_t now = esp_timer_get_time();
+    uint32_t dt = (uint32_t)(now - lastWakeUs);
+    lastWakeUs = now;
+
+    if (pending == 0) {
+        // Timeout: timer parado; contar como overrun e seguir (nao travar o controle)
+        overruns++;
+        return dt;
+    }
+
+    uint32_t jitter = (dt > periodUs) ? dt - periodUs : periodUs - dt;
+    if (jitter > maxJitterUs) maxJitterUs = jitter;
+
+    int bucket = CONTROL_JITTER_BUCKETS - 1;
+    for (int i = 0; i < CONTROL_JITTER_BUCKETS - 1; i++) {
+        if (jitter < JITTER_BUCKET_LIMITS[i]) {
+            bucket = i;
+            break;
+        }
+    }
+    histogram[bucket]++;
+    cycles++;
+    return dt;
+}
+
+void ControlLoopTimer::resetStats() {
+    for (int i = 0; i < CONTROL_JITTER_BUCKETS; i++) histogram[i] = 0;
+    cycles = 0;
+    overruns = 0;
+    maxJitterUs = 0;
+}
+
+void ControlLoopTimer::writeStatsJSON(JsonObject out) {
+    out["periodUs"] = periodUs;
+    out["cycles"] = cycles;
+    out["overruns"] = overruns;
+    out["maxJitterUs"] = maxJitterUs;
+    JsonArray hist = out.createNestedArray("jitterHistogram");
+    for (int i = 0; i < CONTROL_JITTER_BUCKETS; i++) {
+        JsonObject bin = hist.createNestedObject();
+        if (i < CONTROL_JITTER_BUCKETS - 1) {
+            bin["ltUs"] = JITTER_BUCKET_LIMITS[i];
+        } else {
+            bin["geUs"] = JITTER_BUCKET_LIMITS[CONTROL_JITTER_BUCKETS - 2];
+        }
+        bin["count"] = histogram[i];
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef CONTROL_LOOP_H
+#define CONTROL_LOOP_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <esp_timer.h>
+#include "config.h"
+
+// ==================================================================================
+// AGENDADOR DE PERIODO FIXO DO LOOP DE CONTROLE
+// ==================================================================================
+// Um esp_timer periodico notifica a motorTask a cada CONTROL_LOOP_PERIOD_US.
+// O periodo nao depende do tick do FreeRTOS nem de quanto o ciclo demorou,
+// e cada acordar e medido em microssegundos para o histograma de jitter.
+
+#define CONTROL_JITTER_BUCKETS 8
+
+class ControlLoopTimer {
+private:
+    esp_timer_handle_t timer = nullptr;
+    TaskHandle_t task = NULL;
+    uint32_t periodUs = CONTROL_LOOP_PERIOD_US;
+    int64_t lastWakeUs = 0;
+
+    // Estatisticas (escritas apenas pela motorTask)
+    volatile uint32_t cycles = 0;
+    volatile uint32_t overruns = 0;          // Ticks perdidos (ciclo anterior passou do periodo)
+    volatile uint32_t maxJitterUs = 0;
+    volatile uint32_t histogram[CONTROL_JITTER_BUCKETS];
+
+    static void onTimer(void* arg);
+
+public:
+    ControlLoopTimer();
+    bool begin(TaskHandle_t controlTask, uint32_t period);
+    uint32_t waitNextCycle();                // Bloqueia ate o proximo tick; retorna dt real (us)
+    void resetStats();
+
+    uint32_t getPeriodUs() { return periodUs; }
+    uint32_t getCycles() { return cycles; }
+    uint32_t getOverruns() { return overruns; }
+    uint32_t getMaxJitterUs() { return maxJitterUs; }
+    void writeStatsJSON(JsonObject out);
+};
+
+extern ControlLoopTimer controlLoop;
+
+#endif
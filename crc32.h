@@ -0,0 +1,20 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <Arduino.h>
+
+// CRC-32 (IEEE 802.3, refletido) bit a bit. Usado nos registros gravados na
+// flash (storage.cpp, position_journal.cpp): poucas dezenas de bytes por
+// chamada, a tabela de 1 KB nao compensa.
+static inline uint32_t crc32Ieee(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include "deferred_log.h"
+
+DeferredLog deferredLog;
+
+static const char* const LEVEL_TAGS[] = {"", "E", "W", "I", "D"};
+
+DeferredLog::DeferredLog() {
+    drainMutex = xSemaphoreCreateMutex();
+    for (uint32_t i = 0; i < LOG_QUEUE_SIZE; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+void DeferredLog::begin() {
+    xTaskCreatePinnedToCore(taskEntry, "Log", 3072, this, 1, &taskHandle, 0);
+}
+
+// ==================================================================================
+// FILA (varios produtores, um consumidor)
+// ==================================================================================
+
+bool DeferredLog::enqueue(const LogRecord& record) {
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos % LOG_QUEUE_SIZE];
+        uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+        int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            // Slot livre na vez desta posicao: reservar
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.record = record;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                written.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+            // CAS falhou: pos recebeu o valor atual, tentar de novo
+        } else if (diff < 0) {
+            // Slot ainda nao consumido desde a volta anterior: fila cheia
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool DeferredLog::dequeue(LogRecord& record) {
+    Slot& slot = slots[dequeuePos % LOG_QUEUE_SIZE];
+    uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+    if (seq != dequeuePos + 1) return false;
+    record = slot.record;
+    slot.sequence.store(dequeuePos + LOG_QUEUE_SIZE, std::memory_order_release);
+    dequeuePos++;
+    return true;
+}
+
+// ==================================================================================
+// FORMATACAO (task Log)
+// ==================================================================================
+
+size_t DeferredLog::format(const LogRecord& record, char* out, size_t outSize) {
+    size_t used = snprintf(out, outSize, "[%lu.%03lu %s] ",
+                           (unsigned long)(record.timestampMs / 1000), (unsigned long)(record.timestampMs % 1000),
+                           LEVEL_TAGS[record.level < 5 ? record.level : 0]);
+    const char* p = record.format;
+    uint8_t arg = 0;
+
+    while (*p && used < outSize - 1) {
+        if (*p != '%') {
+            out[used++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[used++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Copiar a especificacao (flags, largura, precisao) sem o modificador de
+        // tamanho: os argumentos ja estao em 32 bits / float
+        char spec[16];
+        size_t specLen = 0;
+        spec[specLen++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLen < sizeof(spec) - 2) spec[specLen++] = *p++;
+        while (*p && strchr("hlzjtL", *p)) p++;
+        char conversion = *p ? *p++ : 's';
+        spec[specLen++] = conversion;
+        spec[specLen] = '\0';
+
+        if (arg >= record.argCount) break;  // Formato pede mais do que foi capturado
+        const LogArgValue& value = record.args[arg];
+        LogArgType type = record.types[arg];
+        arg++;
+
+        int n;
+        switch (conversion) {
+            case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+                n = snprintf(out + used, outSize - used, spec,
+                             type == LOG_ARG_FLOAT ? (double)value.f :
+                             type == LOG_ARG_INT ? (double)value.i : (double)value.u);
+                break;
+            case 's':
+                n = snprintf(out + used, outSize - used, spec, type == LOG_ARG_STRING ? value.s : "?");
+                break;
+            case 'd': case 'i': case 'c':
+                n = snprintf(out + used, outSize - used, spec, type == LOG_ARG_FLOAT ? (int)value.f : (int)value.i);
+                break;
+            default:  // u, x, X, o
+                n = snprintf(out + used, outSize - used, spec, type == LOG_ARG_FLOAT ? (unsigned)value.f : (unsigned)value.u);
+                break;
+        }
+        if (n > 0) used += min((size_t)n, outSize - 1 - used);
+    }
+    out[used] = '\0';
+    return used;
+}
+
+void DeferredLog::flush() {
+    // So o lado consumidor usa o mutex; quem chama LOG_*() nunca espera
+    if (xSemaphoreTake(drainMutex, pdMS_TO_TICKS(1000)) != pdTRUE) return;
+    uint32_t depth = enqueuePos.load(std::memory_order_relaxed) - dequeuePos;
+    if (depth > maxDepth) maxDepth = depth;
+    
+    LogRecord record;
+    char line[LOG_LINE_MAX];
+    while (dequeue(record)) {
+        format(record, line, sizeof(line));
+        Serial.println(line);
+    }
+
+    uint32_t lost = dropped.load(std::memory_order_relaxed);
+    if (lost != reportedDropped) {
+        Serial.printf("[log] %u registros descartados (fila cheia)\n", (unsigned)(lost - reportedDropped));
+        reportedDropped = lost;
+    }
+    xSemaphoreGive(drainMutex);
+}
+
+void DeferredLog::taskEntry(void* param) {
+    static_cast<DeferredLog*>(param)->run();
+}
+
+void DeferredLog::run() {
+    for (;;) {
+        flush();
+        vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_INTERVAL_MS));
+    }
+}
+
+void DeferredLog::writeStatsJSON(JsonObject out) {
+    out["level"] = LOG_LEVEL;
+    out["written"] = written.load(std::memory_order_relaxed);
+    out["dropped"] = dropped.load(std::memory_order_relaxed);
+    out["maxDepth"] = maxDepth;
+    out["capacity"] = LOG_QUEUE_SIZE;
+}
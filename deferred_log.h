@@ -0,0 +1,161 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include <type_traits>
+#include "config.h"
+
+// ==================================================================================
+// LOG DIFERIDO (fora do caminho de controle)
+// ==================================================================================
+// Serial.printf a 115200 baud bloqueia a task chamadora enquanto o texto sai.
+// LOG_*() so copia o ponteiro do formato (o "ID": literal na flash) e os
+// argumentos crus num anel sem lock; a task "Log", de prioridade baixa,
+// formata e escreve. Fila cheia = registro descartado e contado, nunca espera.
+//
+// Regras: um registro = uma linha (sem "\n" no formato); no maximo
+// LOG_MAX_ARGS argumentos; %s so com strings estaticas (literais), porque o
+// texto e lido depois. Niveis abaixo de LOG_LEVEL nem sao compilados
+// (argumentos tambem nao sao avaliados).
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#define LOG_MAX_ARGS 6
+
+enum LogArgType : uint8_t {
+    LOG_ARG_INT,
+    LOG_ARG_UINT,
+    LOG_ARG_FLOAT,
+    LOG_ARG_STRING
+};
+
+union LogArgValue {
+    int32_t i;
+    uint32_t u;
+    float f;
+    const char* s;
+};
+
+struct LogRecord {
+    const char* format;
+    uint32_t timestampMs;
+    uint8_t level;
+    uint8_t argCount;
+    LogArgType types[LOG_MAX_ARGS];
+    LogArgValue args[LOG_MAX_ARGS];
+};
+
+class DeferredLog {
+private:
+    // Fila limitada de varios produtores / um consumidor (Vyukov): cada slot tem
+    // sua sequencia; o produtor reserva a posicao com CAS e publica o slot
+    // gravando a sequencia. Seguro entre tasks dos dois nucleos, sem secao critica
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        LogRecord record;
+    };
+    static_assert((LOG_QUEUE_SIZE & (LOG_QUEUE_SIZE - 1)) == 0, "LOG_QUEUE_SIZE deve ser potencia de 2");
+    Slot slots[LOG_QUEUE_SIZE];
+    std::atomic<uint32_t> enqueuePos{0};
+    uint32_t dequeuePos = 0;           // Consumidor (protegido por drainMutex)
+    SemaphoreHandle_t drainMutex;      // Task Log x flush() antes de reiniciar
+
+    std::atomic<uint32_t> written{0};
+    std::atomic<uint32_t> dropped{0};
+    uint32_t reportedDropped = 0;
+    uint32_t maxDepth = 0;
+    TaskHandle_t taskHandle = NULL;
+
+    static void pack(LogRecord&) {}
+
+    template <typename T, typename... Rest>
+    static void pack(LogRecord& record, T value, Rest... rest) {
+        packValue(record, record.argCount++, value);
+        pack(record, rest...);
+    }
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    packValue(LogRecord& record, uint8_t n, T value) {
+        if (std::is_signed<T>::value) {
+            record.types[n] = LOG_ARG_INT;
+            record.args[n].i = (int32_t)value;
+        } else {
+            record.types[n] = LOG_ARG_UINT;
+            record.args[n].u = (uint32_t)value;
+        }
+    }
+
+    static void packValue(LogRecord& record, uint8_t n, const char* value) {
+        record.types[n] = LOG_ARG_STRING;
+        record.args[n].s = value;
+    }
+
+    // double vira float: 4 bytes por argumento, precisao de sobra para log
+    template <typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value>::type
+    packValue(LogRecord& record, uint8_t n, T value) {
+        record.types[n] = LOG_ARG_FLOAT;
+        record.args[n].f = (float)value;
+    }
+
+    bool enqueue(const LogRecord& record);
+    bool dequeue(LogRecord& record);
+    size_t format(const LogRecord& record, char* out, size_t outSize);
+    static void taskEntry(void* param);
+    void run();
+
+public:
+    DeferredLog();
+    void begin();                      // Cria a task de escrita (antes dela, os registros esperam na fila)
+
+    template <typename... Args>
+    void write(uint8_t level, const char* fmt, Args... args) {
+        static_assert(sizeof...(Args) <= LOG_MAX_ARGS, "LOG_*: argumentos demais");
+        LogRecord record;
+        record.format = fmt;
+        record.timestampMs = millis();
+        record.level = level;
+        record.argCount = 0;
+        pack(record, args...);
+        enqueue(record);
+    }
+
+    void flush();                      // Escreve o que estiver na fila (antes de reiniciar)
+    void writeStatsJSON(JsonObject out);
+    uint32_t getDropped() { return dropped.load(std::memory_order_relaxed); }
+};
+
+extern DeferredLog deferredLog;
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(format, ...) deferredLog.write(LOG_LEVEL_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(format, ...) deferredLog.write(LOG_LEVEL_WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(format, ...) deferredLog.write(LOG_LEVEL_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(format, ...) deferredLog.write(LOG_LEVEL_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) do {} while (0)
+#endif
+
+#endif
@@ -1,10 +1,18 @@
 #include "encoder.h"
 #include "config.h"
+#include "deferred_log.h"
+#include "profiler.h"
+#if PLANT_SIMULATION
+#include "plant_simulator.h"
+#endif
+
+static_assert(ENCODER_FILTER_WINDOW >= 1 && ENCODER_FILTER_WINDOW <= 255,
+              "ENCODER_FILTER_WINDOW deve caber no indice de 8 bits");
 
 Encoder::Encoder(int pA, int pB, uint16_t ppr, float gearRatio)
     : pinA(pA), pinB(pB), calibrationOffset(0.0), lastFilteredCount(0) {
     degreesPerPulse = 360.0 / (ppr * gearRatio);
-    mutex = xSemaphoreCreateMutex();
+    edgeMaxVelocityQ8 = (int32_t)(ENCODER_EDGE_MAX_DPS / degreesPerPulse * (1 << ENCODER_VEL_FRAC_BITS));
     
     Serial.println("[Encoder] Configuracao:");
     Serial.printf("  PPR: %d\n", ppr);
@@ -24,49 +32,136 @@ void Encoder::begin() {
     
     encoder.clearCount();
     
+    #if ENCODER_EDGE_CAPTURE && !PLANT_SIMULATION
+    // O PCNT continua contando; a interrupcao so marca o instante de cada borda
+    attachInterruptArg(pinA, onEdge, this, CHANGE);
+    attachInterruptArg(pinB, onEdge, this, CHANGE);
+    Serial.println("  Captura de bordas: interrupcao em A e B");
+    #endif
+    
     Serial.println("[Encoder] Iniciado com Full Quadrature");
 }
 
+void IRAM_ATTR Encoder::onEdge(void* arg) {
+    Encoder* self = (Encoder*)arg;
+    // Contagem lida aqui, colada ao instante: a borda seguinte pode ja estar no PCNT
+    // antes da task ler, mas nao entra no par desta (getCount() e seguro em ISR)
+    uint32_t now = micros();
+    int32_t count = (int32_t)self->encoder.getCount();
+    portENTER_CRITICAL_ISR(&self->edgeMux);
+    self->isrEdgeUs = now;
+    self->isrEdgeCount = count;
+    self->isrEdges++;
+    portEXIT_CRITICAL_ISR(&self->edgeMux);
+}
+
+// Par contagem/instante gravado pela ISR da ultima borda. false = nenhuma borda nova.
+// Borda com a ISR ainda pendente fica inteira (contagem e instante) para o proximo ciclo
+bool Encoder::readEdge(EdgeSample& sample, uint32_t& edges) {
+    #if PLANT_SIMULATION
+    long count;
+    unsigned long timeUs;
+    plantSimulator.getEdge(count, timeUs, edges);
+    sample.count = (int32_t)count;
+    sample.timeUs = timeUs;
+    #else
+    portENTER_CRITICAL(&edgeMux);
+    edges = isrEdges;
+    sample.timeUs = isrEdgeUs;
+    sample.count = isrEdgeCount;
+    portEXIT_CRITICAL(&edgeMux);
+    #endif
+    return edges != lastEdgeTotal;
+}
+
+// Velocidade pelas bordas: da ultima borda volta ate ENCODER_EDGE_COUNTS contagens
+// (ou ENCODER_EDGE_WINDOW_MS). Contagem e instante sao exatos em cada borda, entao
+// nao ha a quantizacao de 1 contagem por ciclo da diferenca de contagens.
+// valid = false so sem nenhuma borda registrada (vale a EMA)
+int32_t Encoder::edgeVelocityQ8(uint32_t nowUs, bool& valid) {
+    valid = edgeFill > 0;
+    if (!valid) return 0;
+    const EdgeSample& newest = edgeHistory[(edgeHead + ENCODER_EDGE_HISTORY - 1) % ENCODER_EDGE_HISTORY];
+    uint32_t sinceEdgeUs = nowUs - newest.timeUs;
+    if (sinceEdgeUs > ENCODER_EDGE_TIMEOUT_MS * 1000UL) return 0;
+    
+    int32_t deltaCounts = 0;
+    uint32_t spanUs = 0;
+    for (uint8_t k = 1; k < edgeFill; k++) {
+        const EdgeSample& older = edgeHistory[(edgeHead + ENCODER_EDGE_HISTORY - 1 - k) % ENCODER_EDGE_HISTORY];
+        uint32_t span = newest.timeUs - older.timeUs;
+        if (span > ENCODER_EDGE_WINDOW_MS * 1000UL) break;
+        deltaCounts = newest.count - older.count;
+        spanUs = span;
+        if (abs(deltaCounts) >= ENCODER_EDGE_COUNTS) break;
+    }
+    // Uma borda indo e voltando (vibracao com o rotor parado) nao e movimento
+    if (abs(deltaCounts) < 2 || spanUs == 0) return 0;
+    
+    int64_t velocity = (int64_t)deltaCounts * (1000000LL << ENCODER_VEL_FRAC_BITS) / spanUs;
+    // Sem borda nova desde entao: no maximo 1 contagem no tempo decorrido (desacelerando)
+    int64_t bound = (1000000LL << ENCODER_VEL_FRAC_BITS) / max(sinceEdgeUs, (uint32_t)1);
+    if (velocity > bound) velocity = bound;
+    if (velocity < -bound) velocity = -bound;
+    return (int32_t)velocity;
+}
+
 void Encoder::update() {
-    long rawCount = encoder.getCount();
+    PROFILE_STAGE(PROFILE_STAGE_ENCODER);
+    
+    // Reset solicitado por outra task: aplicar aqui, dono dos buffers de filtro
+    if (resetRequested) {
+        encoder.clearCount();
+        #if PLANT_SIMULATION
+        plantSimulator.reset();
+        #endif
+        filterInitialized = false;
+        resetRequested = false;
+        edgeFill = 0;
+    }
+    
+    int32_t rawCount = (int32_t)getCount();
 
     // Inicializacao dos buffers de filtro
     if (!filterInitialized) {
         for (int i=0;i<3;i++) medBuf[i] = rawCount;
-        for (int i=0;i<7;i++) movBuf[i] = rawCount;
+        for (int i=0;i<ENCODER_FILTER_WINDOW;i++) movBuf[i] = rawCount;
+        movSum = rawCount * ENCODER_FILTER_WINDOW;
         lastFilteredCount = rawCount;
         lastRawCount = rawCount;
+        lastSignedCount = rawCount;
+        velocityCountsQ8 = 0;
+        lastVelTime = micros();
         filterInitialized = true;
     }
 
     // Rejeitar saltos grosseiros (> ~300 pulsos ~5 graus) em um ciclo
-    long rawDelta = rawCount - lastRawCount;
+    int32_t rawDelta = rawCount - lastRawCount;
     lastRawCount = rawCount;
-    if (abs(rawDelta) > 300) {
+    if (rawDelta > 300 || rawDelta < -300) {
         rawCount = lastFilteredCount; // descarta espirro
     }
 
+    int32_t signedRawCount = rawCount;
+    #if INVERT_ENCODER_DIRECTION
+    signedRawCount = -signedRawCount;
+    #endif
+    if (runtimeInvert) signedRawCount = -signedRawCount;
+
     // Filtro de mediana 3
     medBuf[medIdx] = rawCount;
-    medIdx = (medIdx + 1) % 3;
-    long a = medBuf[0], b = medBuf[1], c = medBuf[2];
-    long med = (a + b + c) - min(a, min(b, c)) - max(a, max(b, c));
+    if (++medIdx == 3) medIdx = 0;
+    int32_t a = medBuf[0], b = medBuf[1], c = medBuf[2];
+    int32_t med = (a + b + c) - min(a, min(b, c)) - max(a, max(b, c));
 
-    // Média móvel de 7
+    // Média móvel com soma corrente (sem re-somar o buffer)
+    movSum += med - movBuf[movIdx];
     movBuf[movIdx] = med;
-    movIdx = (movIdx + 1) % 7;
-    long sum = 0;
-    for (int i=0;i<7;i++) sum += movBuf[i];
-    long filteredCount = sum / 7;
-
-    long prevFiltered = lastFilteredCount;
-    // Anti-jitter: travar se variação < 1 pulso
-    long delta = abs(filteredCount - prevFiltered);
-    if (delta < 1) {
-        filteredCount = prevFiltered;
-    } else {
-        lastFilteredCount = filteredCount;
-    }
+    if (++movIdx == ENCODER_FILTER_WINDOW) movIdx = 0;
+    int32_t filteredCount = movSum / ENCODER_FILTER_WINDOW;
+
+    // Referencia para o descarte de espirros (contagem inteira: sem jitter sub-pulso)
+    lastFilteredCount = filteredCount;
 
     // Inverter se configurado (compile-time)
     #if INVERT_ENCODER_DIRECTION
@@ -77,54 +172,68 @@ void Encoder::update() {
     if (runtimeInvert) {
         filteredCount = -filteredCount;
     }
+
+    #if ENCODER_EDGE_CAPTURE
+    EdgeSample edge;
+    uint32_t edges;
+    if (readEdge(edge, edges)) {
+        edgeHistory[edgeHead] = edge;
+        edgeHead = (edgeHead + 1) % ENCODER_EDGE_HISTORY;
+        if (edgeFill < ENCODER_EDGE_HISTORY) edgeFill++;
+        lastEdgeTotal = edges;
+    }
+    #endif
+
+    // Velocidade em contagens/s (Q8), EMA 0.8/0.2 em inteiro
+    unsigned long now = micros();
+    uint32_t dtUs = now - lastVelTime;
+    if (dtUs == 0) dtUs = 1000;
+    int32_t deltaCounts = filteredCount - lastSignedCount;
+    int32_t instVelQ8 = (int32_t)(((int64_t)deltaCounts * (1000000LL << ENCODER_VEL_FRAC_BITS)) / dtUs);
+    velocityCountsQ8 += (instVelQ8 - velocityCountsQ8) / 5;
+    lastSignedCount = filteredCount;
+    lastVelTime = now;
     
-    float angle = filteredCount * degreesPerPulse;
-
-    // Estimar velocidade angular filtrada (baixa ordem)
-    static unsigned long lastVelTime = millis();
-    unsigned long now = millis();
-    float dt = (now - lastVelTime) / 1000.0f;
-    if (dt <= 0) dt = 0.001f;
-    float deltaDeg = (filteredCount - prevFiltered) * degreesPerPulse;
-    float instVel = deltaDeg / dt;
-    
-    // Atualizar variaveis protegidas
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        velocityDegPerSec = (0.8f * velocityDegPerSec) + (0.2f * instVel);
-        currentAngle = angle;
-        xSemaphoreGive(mutex);
+    // Baixa rotacao (pulsos, final da aproximacao): tempo entre bordas.
+    // Alta rotacao: varias contagens por ciclo, a EMA ja e boa
+    int32_t velocityQ8 = velocityCountsQ8;
+    uint8_t velocitySource = ENCODER_VEL_SOURCE_COUNTS;
+    #if ENCODER_EDGE_CAPTURE
+    bool edgeValid;
+    int32_t edgeVelocity = edgeVelocityQ8(now, edgeValid);
+    #if INVERT_ENCODER_DIRECTION
+    edgeVelocity = -edgeVelocity;
+    #endif
+    if (runtimeInvert) edgeVelocity = -edgeVelocity;
+    if (edgeValid && abs(edgeVelocity) < edgeMaxVelocityQ8) {
+        velocityQ8 = edgeVelocity;
+        velocitySource = ENCODER_VEL_SOURCE_EDGES;
     }
+    #endif
     
-    lastVelTime = now;
+    // Publicar snapshot (leitores nunca bloqueiam esta task)
+    EncoderState state;
+    state.filteredCount = filteredCount;
+    state.rawCount = signedRawCount;
+    state.velocityCountsQ8 = velocityQ8;
+    state.velocitySource = velocitySource;
+    published.store(state);
+}
+
+EncoderState Encoder::getState() {
+    return published.load();
 }
 
 float Encoder::getAngle() {
-    float angle = getRawAngle(); // Pega valor protegido
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        angle += calibrationOffset;
-        xSemaphoreGive(mutex);
-    } else {
-        angle += calibrationOffset; // Fallback sem lock
-    }
-    return normalizeAngle(angle);
+    return normalizeAngle(countsToDegrees(published.load().filteredCount) + calibrationOffset);
 }
 
 float Encoder::getRawAngle() {
-    float angle = 0.0f;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        angle = currentAngle;
-        xSemaphoreGive(mutex);
-    }
-    return angle;
+    return countsToDegrees(published.load().filteredCount);
 }
 
 float Encoder::getVelocityDegPerSec() {
-    float vel = 0.0f;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        vel = velocityDegPerSec;
-        xSemaphoreGive(mutex);
-    }
-    return vel;
+    return velocityToDegPerSec(published.load().velocityCountsQ8);
 }
 
 float Encoder::normalizeAngle(float angle) {
@@ -134,48 +243,39 @@ float Encoder::normalizeAngle(float angle) {
 }
 
 void Encoder::setCalibrationOffset(float offset) {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        calibrationOffset = offset;
-        xSemaphoreGive(mutex);
-        Serial.printf("[Encoder] Calibracao: %.2f graus\n", offset);
-    }
+    calibrationOffset = offset;
+    LOG_INFO("[Encoder] Calibracao: %.2f graus", offset);
 }
 
 float Encoder::getCalibrationOffset() {
-    float offset = 0.0f;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        offset = calibrationOffset;
-        xSemaphoreGive(mutex);
-    }
-    return offset;
+    return calibrationOffset;
 }
 
 void Encoder::resetPosition() {
-    encoder.clearCount();
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        lastFilteredCount = 0;
-        currentAngle = 0.0f;
-        xSemaphoreGive(mutex);
-    }
-    Serial.println("[Encoder] Posicao resetada");
+    resetRequested = true;
+    LOG_INFO("[Encoder] Posicao resetada");
 }
 
 long Encoder::getCount() {
+    #if PLANT_SIMULATION
+    return plantSimulator.getCount();
+    #else
     return encoder.getCount();
+    #endif
 }
 
 void Encoder::setRuntimeInvert(bool invert) {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        runtimeInvert = invert;
-        xSemaphoreGive(mutex);
-    }
+    runtimeInvert = invert;
 }
 
 bool Encoder::isRuntimeInverted() {
-    bool inv = false;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        inv = runtimeInvert;
-        xSemaphoreGive(mutex);
-    }
-    return inv;
+    return runtimeInvert;
+}
+
+uint32_t Encoder::getSnapshotRetries() {
+    return published.getReadRetries();
+}
+
+uint32_t Encoder::getEdgeCount() {
+    return lastEdgeTotal;
 }
@@ -4,6 +4,31 @@
 #include <Arduino.h>
 #include <ESP32Encoder.h>
 #include "config.h"
+#include "seqlock.h"
+
+// Velocidade em contagens/s com 8 bits fracionarios (Q8)
+#define ENCODER_VEL_FRAC_BITS 8
+
+// Pares (instante da ultima borda, contagem) guardados, no maximo um por update()
+#define ENCODER_EDGE_HISTORY 16
+
+#define ENCODER_VEL_SOURCE_COUNTS 0      // Diferenca de contagens por ciclo (EMA)
+#define ENCODER_VEL_SOURCE_EDGES 1       // Tempo entre bordas
+
+// Estado publicado pelo Encoder::update() (leitura sem bloqueio)
+// Mantido em contagens inteiras; conversao para graus so na leitura
+struct EncoderState {
+    int32_t filteredCount;       // Contagem filtrada (ja com inversoes)
+    int32_t rawCount;            // Contagem sem mediana/media (ja com inversoes): observador
+    int32_t velocityCountsQ8;    // Velocidade filtrada (contagens/s, Q8)
+    uint8_t velocitySource;      // ENCODER_VEL_SOURCE_*
+};
+
+// Posicao exata num instante exato: contagem logo depois da ultima borda
+struct EdgeSample {
+    uint32_t timeUs;
+    int32_t count;
+};
 
 class Encoder {
 private:
@@ -11,23 +36,43 @@ private:
     int pinA;
     int pinB;
     float degreesPerPulse;
-    float calibrationOffset;
+    volatile float calibrationOffset;   // Configuracao: escrita atomica (32 bits)
     
     // Variáveis de filtro (movidas de estáticas para membros)
-    long medBuf[3] = {0,0,0};
+    // Mediana 3 + média móvel de ENCODER_FILTER_WINDOW com soma corrente: O(1) por ciclo
+    int32_t medBuf[3] = {0,0,0};
     uint8_t medIdx = 0;
-    long movBuf[7] = {0,0,0,0,0,0,0};
+    int32_t movBuf[ENCODER_FILTER_WINDOW];
     uint8_t movIdx = 0;
+    int32_t movSum = 0;
     bool filterInitialized = false;
     
-    long lastFilteredCount;
-    long lastRawCount = 0;
-    bool runtimeInvert = false;
+    int32_t lastFilteredCount;
+    int32_t lastRawCount = 0;
+    volatile bool runtimeInvert = false;
+    volatile bool resetRequested = false;  // resetPosition() aplicado pela task do encoder
+    
+    // Estado da task do encoder, publicado a cada update()
+    int32_t lastSignedCount = 0;        // Contagem publicada no ciclo anterior (com inversoes)
+    int32_t velocityCountsQ8 = 0;
+    unsigned long lastVelTime = 0;      // us
+    SeqLock<EncoderState> published;
     
-    // Variáveis protegidas
-    float currentAngle = 0.0f;
-    float velocityDegPerSec = 0.0f;
-    SemaphoreHandle_t mutex;
+    // Captura de bordas: a ISR grava instante e contagem do PCNT juntos (o par
+    // da mesma borda) e conta; a task le os tres na mesma secao critica
+    portMUX_TYPE edgeMux = portMUX_INITIALIZER_UNLOCKED;
+    volatile uint32_t isrEdgeUs = 0;
+    volatile int32_t isrEdgeCount = 0;
+    volatile uint32_t isrEdges = 0;
+    volatile uint32_t lastEdgeTotal = 0;
+    EdgeSample edgeHistory[ENCODER_EDGE_HISTORY];
+    uint8_t edgeHead = 0;               // Proxima posicao a escrever
+    uint8_t edgeFill = 0;
+    int32_t edgeMaxVelocityQ8;          // ENCODER_EDGE_MAX_DPS em contagens/s (Q8)
+    
+    static void IRAM_ATTR onEdge(void* arg);
+    bool readEdge(EdgeSample& sample, uint32_t& edges);
+    int32_t edgeVelocityQ8(uint32_t nowUs, bool& valid);   // Contagens brutas/s (Q8)
 
 public:
     Encoder(int pA, int pB, uint16_t ppr, float gearRatio);
@@ -37,8 +82,13 @@ public:
     
     void setCalibrationOffset(float offset);
     float getCalibrationOffset();
-    float getAngle(); // Thread-safe (apenas leitura)
+    float getAngle(); // Sem bloqueio (snapshot publicado)
     float getRawAngle(); // Agora retorna valor interno calculado no update()
+    EncoderState getState();
+    float countsToDegrees(int32_t counts) { return counts * degreesPerPulse; }
+    float velocityToDegPerSec(int32_t velocityQ8) {
+        return velocityQ8 * (degreesPerPulse / (1 << ENCODER_VEL_FRAC_BITS));
+    }
     
     float getVelocityDegPerSec();
     static float normalizeAngle(float angle);
@@ -47,6 +97,9 @@ public:
     
     void setRuntimeInvert(bool invert);
     bool isRuntimeInverted();
+    
+    uint32_t getSnapshotRetries();
+    uint32_t getEdgeCount();     // Bordas capturadas desde o boot (diagnostico)
 };
 
 #endif
@@ -0,0 +1,232 @@
+// Custo por ciclo do filtro do encoder antes (mediana 3 + media movel de 7
+// re-somada a cada ciclo + EMA de velocidade em float) e depois da soma corrente,
+// e do Encoder::update() completo, com a mesma sequencia de contagens do
+// plant_simulator. Falha se alguma contagem filtrada divergir do Encoder real:
+// a soma corrente tem de dar exatamente a mesma resposta.
+#include "host_runtime.h"
+#include "encoder.h"
+#include "plant_simulator.h"
+#include <chrono>
+#include <vector>
+
+#define BENCH_CYCLES 200000
+#define BENCH_DRIVE_PWM 180
+#define BENCH_DRIVE_HALF_PERIOD 3000   // Ciclos em cada sentido (inclui aceleracao e parada)
+#define BENCH_SEED 1
+
+// Filtro do Encoder::update() antes da soma corrente (mesmas inversoes de compilacao)
+struct LegacyFilter {
+    long medBuf[3];
+    int medIdx = 0;
+    long movBuf[7];
+    int movIdx = 0;
+    long lastFilteredCount = 0;
+    long lastRawCount = 0;
+    float velocityDegPerSec = 0.0f;
+    unsigned long lastVelTime = 0;
+    float degreesPerPulse = 360.0f / (ENCODER_PPR * GEAR_RATIO);
+
+    void init(long rawCount, unsigned long now) {
+        for (int i = 0; i < 3; i++) medBuf[i] = rawCount;
+        for (int i = 0; i < 7; i++) movBuf[i] = rawCount;
+        lastFilteredCount = rawCount;
+        lastRawCount = rawCount;
+        lastVelTime = now;
+    }
+
+    long update(long rawCount, unsigned long now) {
+        long rawDelta = rawCount - lastRawCount;
+        lastRawCount = rawCount;
+        if (abs(rawDelta) > 300) rawCount = lastFilteredCount;
+
+        medBuf[medIdx] = rawCount;
+        medIdx = (medIdx + 1) % 3;
+        long a = medBuf[0], b = medBuf[1], c = medBuf[2];
+        long med = (a + b + c) - min(a, min(b, c)) - max(a, max(b, c));
+
+        movBuf[movIdx] = med;
+        movIdx = (movIdx + 1) % 7;
+        long sum = 0;
+        for (int i = 0; i < 7; i++) sum += movBuf[i];
+        long filteredCount = sum / 7;
+
+        long prevFiltered = lastFilteredCount;
+        long delta = abs(filteredCount - prevFiltered);
+        if (delta < 1) filteredCount = prevFiltered;
+        else lastFilteredCount = filteredCount;
+
+        #if INVERT_ENCODER_DIRECTION
+        filteredCount = -filteredCount;
+        #endif
+
+        float dt = (now - lastVelTime) / 1000000.0f;
+        if (dt <= 0) dt = 0.001f;
+        float instVel = (filteredCount - prevFiltered) * degreesPerPulse / dt;
+        velocityDegPerSec = (0.8f * velocityDegPerSec) + (0.2f * instVel);
+        lastVelTime = now;
+        return filteredCount;
+    }
+};
+
+// Corpo do filtro do Encoder::update() atual, sem leitura de bordas e sem publicacao:
+// compara so a troca da re-soma pela soma corrente (e da EMA float pela inteira)
+struct RunningSumFilter {
+    int32_t medBuf[3];
+    uint8_t medIdx = 0;
+    int32_t movBuf[ENCODER_FILTER_WINDOW];
+    uint8_t movIdx = 0;
+    int32_t movSum = 0;
+    int32_t lastFilteredCount = 0;
+    int32_t lastRawCount = 0;
+    int32_t lastSignedCount = 0;
+    int32_t velocityCountsQ8 = 0;
+    unsigned long lastVelTime = 0;
+
+    void init(int32_t rawCount, unsigned long now) {
+        for (int i = 0; i < 3; i++) medBuf[i] = rawCount;
+        for (int i = 0; i < ENCODER_FILTER_WINDOW; i++) movBuf[i] = rawCount;
+        movSum = rawCount * ENCODER_FILTER_WINDOW;
+        lastFilteredCount = rawCount;
+        lastRawCount = rawCount;
+        lastSignedCount = rawCount;
+        lastVelTime = now;
+    }
+
+    int32_t update(int32_t rawCount, unsigned long now) {
+        int32_t rawDelta = rawCount - lastRawCount;
+        lastRawCount = rawCount;
+        if (rawDelta > 300 || rawDelta < -300) rawCount = lastFilteredCount;
+
+        medBuf[medIdx] = rawCount;
+        if (++medIdx == 3) medIdx = 0;
+        int32_t a = medBuf[0], b = medBuf[1], c = medBuf[2];
+        int32_t med = (a + b + c) - min(a, min(b, c)) - max(a, max(b, c));
+
+        movSum += med - movBuf[movIdx];
+        movBuf[movIdx] = med;
+        if (++movIdx == ENCODER_FILTER_WINDOW) movIdx = 0;
+        int32_t filteredCount = movSum / ENCODER_FILTER_WINDOW;
+        lastFilteredCount = filteredCount;
+
+        #if INVERT_ENCODER_DIRECTION
+        filteredCount = -filteredCount;
+        #endif
+
+        uint32_t dtUs = now - lastVelTime;
+        if (dtUs == 0) dtUs = 1000;
+        int32_t deltaCounts = filteredCount - lastSignedCount;
+        int32_t instVelQ8 = (int32_t)(((int64_t)deltaCounts * (1000000LL << ENCODER_VEL_FRAC_BITS)) / dtUs);
+        velocityCountsQ8 += (instVelQ8 - velocityCountsQ8) / 5;
+        lastSignedCount = filteredCount;
+        lastVelTime = now;
+        return filteredCount;
+    }
+};
+
+static const uint64_t START_US = 2000000;
+
+static void restartPlant() {
+    hostVirtualUs = START_US;
+    plantSimulator.reset();
+    srand(BENCH_SEED);            // Mesmo ruido do encoder em todas as passadas
+}
+
+static void advance(int cycle) {
+    hostVirtualUs += 1000;
+    if (cycle % BENCH_DRIVE_HALF_PERIOD == 0) {
+        plantSimulator.setDrive((cycle / BENCH_DRIVE_HALF_PERIOD) % 2 ? -BENCH_DRIVE_PWM : BENCH_DRIVE_PWM);
+    }
+}
+
+static double nsPerCycle(std::chrono::steady_clock::time_point start) {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / BENCH_CYCLES;
+}
+
+int main() {
+    std::vector<int32_t> counts(BENCH_CYCLES + 1);
+    std::vector<int32_t> legacyOut(BENCH_CYCLES);
+    std::vector<int32_t> runningOut(BENCH_CYCLES);
+    std::vector<int32_t> currentOut(BENCH_CYCLES);
+
+    // 1) So a fonte: as mesmas leituras do simulador que o Encoder::update() faz
+    long edgeCount;
+    unsigned long edgeUs;
+    uint32_t edges;
+    restartPlant();
+    counts[0] = (int32_t)plantSimulator.getCount();   // Primeira leitura: inicializa o filtro
+    plantSimulator.getEdge(edgeCount, edgeUs, edges);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        advance(i);
+        counts[i + 1] = (int32_t)plantSimulator.getCount();
+        #if ENCODER_EDGE_CAPTURE
+        plantSimulator.getEdge(edgeCount, edgeUs, edges);
+        #endif
+    }
+    double sourceNs = nsPerCycle(start);
+
+    // 2) Filtro antigo sobre as mesmas contagens
+    LegacyFilter legacy;
+    legacy.init(counts[0], START_US);
+    legacy.update(counts[0], START_US);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        legacyOut[i] = (int32_t)legacy.update(counts[i + 1], START_US + (i + 1) * 1000ULL);
+    }
+    double legacyNs = nsPerCycle(start);
+
+    // 3) Soma corrente sobre as mesmas contagens
+    RunningSumFilter running;
+    running.init(counts[0], START_US);
+    running.update(counts[0], START_US);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        runningOut[i] = running.update(counts[i + 1], START_US + (i + 1) * 1000ULL);
+    }
+    double runningNs = nsPerCycle(start);
+
+    // 4) Encoder::update() atual (soma corrente, velocidade em Q8 e por bordas)
+    Encoder timed(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_PPR, GEAR_RATIO);
+    timed.begin();
+    restartPlant();
+    timed.update();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        advance(i);
+        timed.update();
+    }
+    double currentNs = nsPerCycle(start);
+
+    // 5) Mesma passada, lendo o estado publicado a cada ciclo (fora da medicao)
+    Encoder checked(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_PPR, GEAR_RATIO);
+    checked.begin();
+    restartPlant();
+    checked.update();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        advance(i);
+        checked.update();
+        currentOut[i] = checked.getState().filteredCount;
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        if (legacyOut[i] != currentOut[i] || runningOut[i] != currentOut[i]) {
+            if (mismatches == 0) {
+                printf("FALHA: ciclo %d, filtro antigo %d, soma corrente %d, Encoder %d\n", i,
+                       (int)legacyOut[i], (int)runningOut[i], (int)currentOut[i]);
+            }
+            mismatches++;
+        }
+    }
+
+    printf("\n================ ENCODER::UPDATE() NO HOST ================\n");
+    printf("%d ciclos, janela %d, contagem final %d\n", BENCH_CYCLES, ENCODER_FILTER_WINDOW, (int)currentOut[BENCH_CYCLES - 1]);
+    printf("Fonte (plant_simulator)          %7.1f ns/ciclo\n", sourceNs);
+    printf("Filtro antigo (re-soma, float)   %7.1f ns/ciclo\n", legacyNs);
+    printf("Filtro atual (soma corrente, Q8) %7.1f ns/ciclo\n", runningNs);
+    printf("Encoder::update() - fonte        %7.1f ns/ciclo (inclui velocidade por bordas)\n", currentNs - sourceNs);
+    printf("Contagens filtradas divergentes: %d\n", mismatches);
+    printf("===========================================================\n");
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+// Fuzz e benchmark do parser GS-232/EasyComm (RotatorProtocol::feed) no PC.
+// Respostas conhecidas, bytes aleatorios em pedacos aleatorios (como chegam pelo
+// TCP), linhas no limite do buffer e sem fim de linha. Falha se a resposta passar
+// de outSize, escrever alem do buffer, vier sem terminador ou se o parser alocar.
+// Uso: fuzz_rotator_protocol [semente] [iteracoes]
+#include "host_runtime.h"
+#include "encoder.h"
+#include "storage.h"
+#include "motor_control.h"
+#include "rotator_protocol.h"
+#include <chrono>
+#include <new>
+
+#define FUZZ_DEFAULT_ITERATIONS 200000
+#define FUZZ_CHUNK_MAX 96
+#define FUZZ_CANARY 0xA5
+#define FUZZ_CANARY_BYTES 16
+
+Encoder encoder(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_PPR, GEAR_RATIO);
+StorageManager storage;
+MotorController motorController(&encoder, &storage);
+
+// O parser promete nao alocar: conta as alocacoes C++ enquanto ele roda
+static volatile bool countAllocations = false;
+static volatile uint32_t allocations = 0;
+
+void* operator new(size_t size) {
+    if (countAllocations) allocations++;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+static uint32_t rngState = 1;
+
+static uint32_t nextRandom() {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return rngState;
+}
+
+static int failures = 0;
+
+static void motorCycle() {
+    encoder.update();
+    motorController.update();
+}
+
+// Resposta dentro de outSize (com o '\0' do vsnprintf) e nada escrito alem dele
+static size_t checkedFeed(RotatorProtocol& protocol, const char* data, size_t len, size_t outSize) {
+    static char out[ROTATOR_RESPONSE_MAX + FUZZ_CANARY_BYTES];
+    memset(out, FUZZ_CANARY, sizeof(out));
+    countAllocations = true;
+    size_t written = protocol.feed(data, len, out, outSize);
+    countAllocations = false;
+    if (written >= outSize && outSize > 0) {
+        printf("FALHA: resposta de %u bytes em buffer de %u\n", (unsigned)written, (unsigned)outSize);
+        failures++;
+    } else if (written > 0 && out[written] != '\0') {
+        printf("FALHA: resposta sem terminador\n");
+        failures++;
+    }
+    for (size_t i = outSize; i < sizeof(out); i++) {
+        if ((uint8_t)out[i] != FUZZ_CANARY) {
+            printf("FALHA: escrita alem de outSize (%u)\n", (unsigned)outSize);
+            failures++;
+            break;
+        }
+    }
+    return written;
+}
+
+static void expectResponse(RotatorProtocol& protocol, const char* input, const char* expected) {
+    char out[ROTATOR_RESPONSE_MAX];
+    memset(out, 0, sizeof(out));
+    size_t written = protocol.feed(input, strlen(input), out, sizeof(out));
+    if (written != strlen(expected) || memcmp(out, expected, written) != 0) {
+        printf("FALHA: '%s' -> '%.*s', esperado '%s'\n", input, (int)written, out, expected);
+        failures++;
+    }
+}
+
+static void knownAnswers(RotatorProtocol& protocol) {
+    #if GS232_VARIANT_B
+    expectResponse(protocol, "C\r", "AZ=000\r");
+    expectResponse(protocol, "c2\r\n", "AZ=000  EL=000\r");
+    #else
+    expectResponse(protocol, "C\r", "+0000\r");
+    expectResponse(protocol, "c2\r\n", "+0000+0000\r");
+    #endif
+    expectResponse(protocol, "AZ EL\n", "AZ0.0 EL0.0\n");
+    expectResponse(protocol, "VE\r", "VE" WIFI_HOSTNAME "\n");
+    expectResponse(protocol, "\r\n\r\n", "");
+    expectResponse(protocol, "M451\r", "?>\r");
+    expectResponse(protocol, "X5\r", "?>\r");
+    expectResponse(protocol, "Q\r", "?>\r");
+    expectResponse(protocol, "SA SE\n", "");
+    expectResponse(protocol, "W090 045\r", "");
+    expectResponse(protocol, "S\r", "");
+
+    // Linha longa demais: descartada inteira, sem resposta, e o parser volta ao normal
+    char longLine[ROTATOR_LINE_MAX * 2 + 2];
+    memset(longLine, 'C', sizeof(longLine) - 2);
+    longLine[sizeof(longLine) - 2] = '\r';
+    longLine[sizeof(longLine) - 1] = '\0';
+    uint32_t errorsBefore = RotatorProtocol::errorCount;
+    expectResponse(protocol, longLine, "");
+    if (RotatorProtocol::errorCount != errorsBefore + 1) {
+        printf("FALHA: linha longa nao contada como erro\n");
+        failures++;
+    }
+    // Comando partido em varios pedacos
+    char out[ROTATOR_RESPONSE_MAX];
+    protocol.feed("A", 1, out, sizeof(out));
+    protocol.feed("Z", 1, out, sizeof(out));
+    size_t written = protocol.feed("\n", 1, out, sizeof(out));
+    if (written != 6 || memcmp(out, "AZ0.0\n", 6) != 0) {
+        printf("FALHA: comando em pedacos\n");
+        failures++;
+    }
+}
+
+// Bytes com vies para o alfabeto dos protocolos (chega nos ramos mais fundos)
+static char randomByte() {
+    static const char ALPHABET[] = "CMWSARLXUDEBZVNPcmwsarlxzv0123456789.+- \r\n";
+    uint32_t r = nextRandom();
+    if ((r & 7) == 0) return (char)(r >> 8);
+    return ALPHABET[(r >> 8) % (sizeof(ALPHABET) - 1)];
+}
+
+int main(int argc, char** argv) {
+    uint32_t seed = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 0) : 1;
+    long iterations = argc > 2 ? atol(argv[2]) : FUZZ_DEFAULT_ITERATIONS;
+    rngState = seed ? seed : 1;
+
+    storage.begin();
+    encoder.begin();
+    motorController.begin();
+    hostTickHook = motorCycle;
+
+    RotatorProtocol protocol;
+    protocol.begin(&motorController, &storage, COMMAND_SOURCE_NETWORK);
+    knownAnswers(protocol);
+
+    // Pedacos aleatorios, com buffer de resposta tambem de tamanho aleatorio
+    char chunk[FUZZ_CHUNK_MAX];
+    uint64_t bytes = 0;
+    double parseNs = 0;
+    for (long i = 0; i < iterations; i++) {
+        size_t len = 1 + nextRandom() % FUZZ_CHUNK_MAX;
+        for (size_t k = 0; k < len; k++) chunk[k] = randomByte();
+        size_t outSize = nextRandom() % (ROTATOR_RESPONSE_MAX + 1);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        checkedFeed(protocol, chunk, len, outSize);
+        parseNs += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        bytes += len;
+        // A motorTask drena as filas de comando; sem ela os comandos so enchem a fila
+        if ((i & 63) == 0) vTaskDelay(1);
+        if (failures > 20) break;
+    }
+
+    // Fluxo valido tipico de um cliente (hamlib/gpredict): consulta + ir para
+    static const char VALID[] = "AZ EL\nAZ123.4 EL10.0\nC2\rW123 010\rAZ\n";
+    uint32_t commandsBefore = RotatorProtocol::commandCount;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 20000; i++) {
+        checkedFeed(protocol, VALID, sizeof(VALID) - 1, ROTATOR_RESPONSE_MAX);
+        if ((i & 63) == 0) vTaskDelay(1);
+    }
+    double validNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    uint32_t validLines = RotatorProtocol::commandCount - commandsBefore;
+
+    if (allocations != 0) {
+        printf("FALHA: %u alocacoes dentro do parser\n", (unsigned)allocations);
+        failures++;
+    }
+
+    printf("\n================ PARSER GS-232 / EASYCOMM ================\n");
+    printf("Semente %u, %ld pedacos aleatorios, %llu bytes\n", (unsigned)seed, iterations,
+           (unsigned long long)bytes);
+    printf("Aleatorio: %.1f ns/byte, linhas %u, erros %u\n", parseNs / bytes,
+           (unsigned)RotatorProtocol::commandCount, (unsigned)RotatorProtocol::errorCount);
+    printf("Fluxo valido: %.0f ns/linha\n", validNs / validLines);
+    printf("Falhas: %d\n", failures);
+    printf("===========================================================\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#pragma once
+// ==================================================================================
+// SHIM DO CORE ARDUINO PARA O BUILD NO PC (host/)
+// ==================================================================================
+// So o que o firmware usa. O tempo e virtual (hostVirtualUs): millis()/micros()
+// andam quando vTaskDelay() avanca os ticks (host_runtime.cpp), nao com o relogio.
+// HOST_QUIET no ambiente silencia a Serial.
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <string>
+#include <algorithm>
+#include <atomic>
+using std::min; using std::max;
+using std::isnan; using std::abs; using std::isinf;
+#define PROGMEM
+#define IRAM_ATTR
+// Secao propria: o teste do journal simula a perda da RTC (__start_/__stop_host_rtc_noinit)
+#define RTC_NOINIT_ATTR __attribute__((section("host_rtc_noinit")))
+#define RTC_DATA_ATTR
+#define FPSTR(x) (x)
+typedef bool boolean;
+typedef uint8_t byte;
+extern uint64_t hostVirtualUs;
+inline unsigned long millis(){ return (unsigned long)(hostVirtualUs/1000); }
+inline unsigned long micros(){ return (unsigned long)hostVirtualUs; }
+inline int64_t esp_timer_get_time(){ return (int64_t)hostVirtualUs; }
+inline void delay(unsigned long){ }
+inline void delayMicroseconds(unsigned){ }
+template<class T, class L, class H> inline T constrain(T x, L l, H h){ return x<l?l:(x>h?h:x);} 
+inline long map(long x,long a,long b,long c,long d){ return (x-a)*(d-c)/(b-a)+c; }
+inline long random(long a,long b){ return a + (rand() % (b-a)); }
+inline long random(long b){ return rand()%b; }
+#define OUTPUT 1
+#define INPUT 0
+#define INPUT_PULLUP 2
+#define LOW 0
+#define HIGH 1
+#define RISING 1
+#define FALLING 2
+#define CHANGE 3
+inline void pinMode(int,int){}
+inline void digitalWrite(int,int){}
+inline int digitalRead(int){return 0;}
+inline void ledcSetup(int,int,int){}
+inline void ledcAttachPin(int,int){}
+inline void ledcWrite(int,int){}
+inline void attachInterrupt(int, void(*)(), int){}
+inline void attachInterruptArg(int, void(*)(void*), void*, int){}
+inline int digitalPinToInterrupt(int p){return p;}
+inline uint32_t xthal_get_ccount(){ return (uint32_t)(hostVirtualUs*240); }
+class String : public std::string { public:
+  String(){} String(const char*s):std::string(s?s:""){} String(const std::string&s):std::string(s){}
+  String(float f, int d){ char b[32]; snprintf(b,32,"%.*f",d,f); assign(b);} String(int i){assign(std::to_string(i));}
+  String(unsigned i){assign(std::to_string(i));} String(long i){assign(std::to_string(i));} String(unsigned long i){assign(std::to_string(i));}
+  float toFloat() const { return atof(c_str()); } long toInt() const { return atol(c_str()); }
+  bool startsWith(const String&s) const { return rfind(s,0)==0; }
+  bool equals(const String&s) const { return *this==s; }
+  void trim(){ size_t a=find_first_not_of(" \t\r\n"); size_t b=find_last_not_of(" \t\r\n"); if(a==npos){clear();return;} *this=String(substr(a,b-a+1)); }
+};
+class Print { public:
+  virtual size_t write(uint8_t c)=0;
+  virtual size_t write(const uint8_t*b,size_t n){ for(size_t i=0;i<n;i++) write(b[i]); return n; }
+  size_t print(const char*s){ return write((const uint8_t*)s,strlen(s)); }
+  size_t print(const String&s){ return print(s.c_str()); }
+  size_t print(float f){ char b[32]; snprintf(b,32,"%.2f",f); return print(b);} 
+  size_t print(double f){ return print((float)f);} 
+  size_t print(int v){ char b[32]; snprintf(b,32,"%d",v); return print(b);} 
+  size_t print(unsigned v){ char b[32]; snprintf(b,32,"%u",v); return print(b);} 
+  size_t print(long v){ char b[32]; snprintf(b,32,"%ld",v); return print(b);} 
+  size_t print(unsigned long v){ char b[32]; snprintf(b,32,"%lu",v); return print(b);} 
+  template<class T> size_t println(T v){ size_t n=print(v); print("\n"); return n+1;} 
+  size_t println(){ return print("\n"); }
+  size_t printf(const char*f,...) __attribute__((format(printf,2,3))) { char b[1024]; va_list a; va_start(a,f); int n=vsnprintf(b,sizeof b,f,a); va_end(a); return write((const uint8_t*)b,(size_t)std::min(n,1023)); }
+};
+class Stream : public Print { public:
+  virtual int available(){return 0;} virtual int read(){return -1;} virtual int peek(){return -1;}
+  size_t readBytes(uint8_t*,size_t){return 0;} size_t readBytes(char*,size_t){return 0;}
+};
+class HardwareSerial : public Stream { public:
+  void begin(unsigned long){} 
+  size_t write(uint8_t c) override { if(getenv("HOST_QUIET")) return 1; return fwrite(&c,1,1,stdout); }
+  size_t write(const uint8_t*b,size_t n) override { if(getenv("HOST_QUIET")) return n; return fwrite(b,1,n,stdout); }
+  int availableForWrite(){ return 128; }
+  operator bool(){return true;}
+};
+extern HardwareSerial Serial;
+struct EspClass { void restart(){ exit(1);} uint32_t getFreeHeap(){return 200000;} uint32_t getMaxAllocHeap(){return 100000;} uint32_t getCycleCount(){return xthal_get_ccount();} uint32_t getCpuFreqMHz(){return 240;} uint32_t getFreePsram(){return 0;} uint32_t getPsramSize(){return 0;} };
+extern EspClass ESP;
+inline void* ps_malloc(size_t n){ return malloc(n);} 
+inline bool psramFound(){return false;}
+#include "freertos_shim.h"
+inline void configTime(long, int, const char*, const char* = nullptr, const char* = nullptr){}
@@ -0,0 +1,31 @@
+#pragma once
+struct JsonObject; struct JsonArray;
+struct JsonVariant {
+  template<class T> JsonVariant& operator=(const T&){ return *this; }
+  JsonVariant operator[](const char*) const { return {}; }
+  JsonVariant operator[](int) const { return {}; }
+  template<class T> T as() const { return T(); }
+  template<class T> bool is() const { return false; }
+  template<class T> operator T() const { return T(); }
+  bool containsKey(const char*) const { return false; }
+  bool isNull() const { return true; }
+  size_t size() const { return 0; }
+  JsonObject createNestedObject(const char* = nullptr);
+  JsonArray createNestedArray(const char* = nullptr);
+  template<class T> bool add(const T&){ return true; }
+};
+struct JsonObject : JsonVariant {};
+struct JsonArray : JsonVariant { JsonVariant* begin(){return nullptr;} JsonVariant* end(){return nullptr;} };
+inline JsonObject JsonVariant::createNestedObject(const char*){ return {}; }
+inline JsonArray JsonVariant::createNestedArray(const char*){ return {}; }
+struct JsonDocument : JsonVariant { void clear(){} JsonObject to_obj(){return {};} template<class T> T to(){ return T(); } };
+template<size_t N> struct StaticJsonDocument : JsonDocument {};
+struct DynamicJsonDocument : JsonDocument { DynamicJsonDocument(size_t){} };
+struct DeserializationError { int c=0; explicit operator bool() const { return c!=0; } const char* c_str() const {return "";} };
+template<class S> DeserializationError deserializeJson(JsonDocument&, S){ return {}; }
+inline DeserializationError deserializeJson(JsonDocument&, const char*, size_t){ return {}; }
+inline DeserializationError deserializeJson(JsonDocument&, const uint8_t*, size_t){ return {}; }
+template<class S> size_t serializeJson(const JsonDocument&, S&){ return 0; }
+inline size_t serializeJson(const JsonDocument&, char*, size_t){ return 0; }
+inline size_t measureJson(const JsonDocument&){ return 0; }
+template<class T> const T& serialized(const T& t){ return t; }
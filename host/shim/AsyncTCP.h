@@ -0,0 +1,12 @@
+#pragma once
+#include <functional>
+class AsyncClient; 
+typedef std::function<void(void*, AsyncClient*)> AcConnectHandler;
+typedef std::function<void(void*, AsyncClient*, void*, size_t)> AcDataHandler;
+typedef std::function<void(void*, AsyncClient*, int8_t)> AcErrorHandler;
+typedef std::function<void(void*, AsyncClient*, size_t, uint32_t)> AcAckHandler;
+typedef std::function<void(void*, AsyncClient*, uint32_t)> AcTimeoutHandler;
+#define ASYNC_WRITE_FLAG_COPY 1
+class AsyncClient { public: void onData(AcDataHandler, void* = nullptr){} void onDisconnect(AcConnectHandler, void* = nullptr){} void onError(AcErrorHandler, void* = nullptr){} void onTimeout(AcTimeoutHandler, void* = nullptr){} void onAck(AcAckHandler, void* = nullptr){} void onPoll(AcConnectHandler, void* = nullptr){}
+ size_t space(){return 1000;} size_t add(const char*, size_t, uint8_t=0){return 0;} bool send(){return true;} size_t write(const char*, size_t){return 0;} size_t write(const char*){return 0;} void close(bool=false){} bool connected(){return true;} bool canSend(){return true;} void setNoDelay(bool){} void setRxTimeout(uint32_t){} };
+class AsyncServer { public: AsyncServer(uint16_t){} void onClient(AcConnectHandler, void*){} void begin(){} void setNoDelay(bool){} void end(){} };
@@ -0,0 +1,3 @@
+#pragma once
+enum puType { up, down, none };
+class ESP32Encoder { public: static puType useInternalWeakPullResistors; void attachFullQuad(int,int){} void clearCount(){} int64_t getCount(){return 0;} };
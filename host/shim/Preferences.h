@@ -0,0 +1,12 @@
+#pragma once
+#include <map>
+#include <vector>
+class Preferences { std::map<std::string,std::vector<uint8_t>> m; public:
+ bool begin(const char*, bool){return true;}
+ size_t putFloat(const char*k,float v){ put(k,&v,4); return 4;} float getFloat(const char*k,float d=0){ float v=d; get(k,&v,4); return v;}
+ size_t putInt(const char*k,int32_t v){ put(k,&v,4); return 4;} int32_t getInt(const char*k,int32_t d=0){ int32_t v=d; get(k,&v,4); return v;}
+ size_t putUInt(const char*k,uint32_t v){ put(k,&v,4); return 4;} uint32_t getUInt(const char*k,uint32_t d=0){ uint32_t v=d; get(k,&v,4); return v;}
+ size_t putBytes(const char*k,const void*b,size_t n){ put(k,b,n); return n;} size_t getBytes(const char*k,void*b,size_t n){ return get(k,b,n);} size_t getBytesLength(const char*k){ auto i=m.find(k); return i==m.end()?0:i->second.size(); }
+ size_t putString(const char*k,const char*s){ put(k,s,strlen(s)+1); return strlen(s);} size_t getString(const char*k,char*b,size_t n){ return get(k,b,n);} 
+ bool isKey(const char*k){ return m.count(k)>0; } bool clear(){ m.clear(); return true;} bool remove(const char*k){ return m.erase(k)>0;} void end(){}
+ private: void put(const char*k,const void*b,size_t n){ m[k]=std::vector<uint8_t>((const uint8_t*)b,(const uint8_t*)b+n);} size_t get(const char*k,void*b,size_t n){ auto i=m.find(k); if(i==m.end()) return 0; size_t c=std::min(n,i->second.size()); memcpy(b,i->second.data(),c); return c;} };
@@ -0,0 +1,13 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+struct TwoWire {
+    bool begin(int, int, uint32_t) { return true; }
+    void setTimeOut(uint16_t) {}
+    void beginTransmission(uint8_t) {}
+    size_t write(uint8_t) { return 1; }
+    uint8_t endTransmission(bool = true) { return 0; }
+    uint8_t requestFrom(uint8_t, uint8_t) { return 2; }
+    int read() { return 0; }
+};
+extern TwoWire Wire;
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+typedef int esp_err_t;
+#define ESP_OK 0
+#define ESP_FAIL -1
+typedef enum { ESP_PARTITION_TYPE_APP=0, ESP_PARTITION_TYPE_DATA=1 } esp_partition_type_t;
+typedef enum { ESP_PARTITION_SUBTYPE_ANY=0xff } esp_partition_subtype_t;
+typedef struct { uint32_t address; uint32_t size; char label[17]; } esp_partition_t;
+extern uint8_t hostPartitionMem[65536];
+extern esp_partition_t hostPartition;
+extern bool hostPartitionPresent;
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t, esp_partition_subtype_t, const char*){ return hostPartitionPresent ? &hostPartition : nullptr; }
+inline esp_err_t esp_partition_read(const esp_partition_t*, size_t off, void* dst, size_t n){ memcpy(dst, hostPartitionMem+off, n); return ESP_OK; }
+// Queda de energia simulada: lancada no meio de uma escrita (ou pelo teste entre ciclos)
+struct HostPowerCut {};
+// >= 0: a proxima escrita grava so estes bytes, parte dos bits do seguinte, e lanca HostPowerCut
+extern int hostPartitionCutBytes;
+inline esp_err_t esp_partition_write(const esp_partition_t*, size_t off, const void* src, size_t n){
+  const uint8_t* bytes = (const uint8_t*)src;
+  if (hostPartitionCutBytes >= 0) {
+    size_t cut = std::min((size_t)hostPartitionCutBytes, n);
+    hostPartitionCutBytes = -1;
+    for (size_t i = 0; i < cut; i++) hostPartitionMem[off+i] &= bytes[i];
+    if (cut < n) hostPartitionMem[off+cut] &= bytes[cut] | (uint8_t)rand();   // NOR: so 1 -> 0
+    throw HostPowerCut();
+  }
+  for (size_t i = 0; i < n; i++) hostPartitionMem[off+i] &= bytes[i];
+  return ESP_OK;
+}
+inline esp_err_t esp_partition_erase_range(const esp_partition_t*, size_t off, size_t n){ memset(hostPartitionMem+off, 0xFF, n); return ESP_OK; }
@@ -0,0 +1,32 @@
+#pragma once
+// FreeRTOS de uma thread so: mutexes/secoes criticas vazias, vTaskDelay() avanca o
+// tempo virtual e xTaskCreatePinnedToCore() so executa a task pedida pelo teste.
+typedef void* SemaphoreHandle_t; typedef void* TaskHandle_t; typedef void* QueueHandle_t;
+typedef int BaseType_t; typedef unsigned UBaseType_t; typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdPASS 1
+#define portMAX_DELAY 0xffffffffu
+#define pdMS_TO_TICKS(x) (x)
+#define portTICK_PERIOD_MS 1
+struct portMUX_TYPE { int x; };
+#define portMUX_INITIALIZER_UNLOCKED {0}
+inline void portENTER_CRITICAL(portMUX_TYPE*){} inline void portEXIT_CRITICAL(portMUX_TYPE*){}
+inline void portENTER_CRITICAL_ISR(portMUX_TYPE*){} inline void portEXIT_CRITICAL_ISR(portMUX_TYPE*){}
+inline SemaphoreHandle_t xSemaphoreCreateMutex(){ return (void*)1; }
+inline SemaphoreHandle_t xSemaphoreCreateBinary(){ return (void*)1; }
+inline int xSemaphoreTake(SemaphoreHandle_t, uint32_t){ return pdTRUE; }
+inline int xSemaphoreGive(SemaphoreHandle_t){ return pdTRUE; }
+void vTaskDelay(uint32_t ticks);
+BaseType_t xTaskCreatePinnedToCore(void(*fn)(void*), const char*, uint32_t, void*, UBaseType_t, TaskHandle_t*, int);
+inline BaseType_t xTaskCreate(void(*fn)(void*), const char*n, uint32_t s, void*p, UBaseType_t pr, TaskHandle_t*h){ return xTaskCreatePinnedToCore(fn,n,s,p,pr,h,0);} 
+inline void vTaskDelete(TaskHandle_t){}
+inline int xPortGetCoreID(){return 0;}
+inline TickType_t xTaskGetTickCount(){ return (TickType_t)(hostVirtualUs/1000); }
+inline uint32_t ulTaskNotifyTake(BaseType_t, TickType_t){ return 1; }
+inline void xTaskNotifyGive(TaskHandle_t){}
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t*){}
+inline TaskHandle_t xTaskGetCurrentTaskHandle(){ return (void*)2; }
+inline void portYIELD_FROM_ISR(){}
+inline void taskYIELD(){}
+void vTaskDelayUntil(TickType_t* lastWake, TickType_t period);
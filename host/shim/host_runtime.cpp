@@ -0,0 +1,50 @@
+#include "host_runtime.h"
+#include <ESP32Encoder.h>
+#include <Wire.h>
+#include <esp_partition.h>
+
+uint64_t hostVirtualUs = 1000000;
+HardwareSerial Serial;
+EspClass ESP;
+TwoWire Wire;
+puType ESP32Encoder::useInternalWeakPullResistors = up;
+
+// Particao de dados em RAM (NOR: escrita so leva bits de 1 para 0)
+uint8_t hostPartitionMem[65536];
+esp_partition_t hostPartition = {0, sizeof(hostPartitionMem), "spiffs"};
+bool hostPartitionPresent = false;
+int hostPartitionCutBytes = -1;
+
+void (*hostTickHook)() = nullptr;
+const char* hostRunTask = nullptr;
+
+static bool inTick = false;
+
+// Cada tick de 1 ms roda o hook (o ciclo da motorTask); um vTaskDelay chamado de
+// dentro do proprio hook so avanca o tempo
+void vTaskDelay(uint32_t ticks) {
+    for (uint32_t i = 0; i < ticks; i++) {
+        hostVirtualUs += 1000;
+        if (inTick || hostTickHook == nullptr) continue;
+        inTick = true;
+        try {
+            hostTickHook();
+        } catch (...) {
+            inTick = false;        // Queda de energia simulada sai pelo hook
+            throw;
+        }
+        inTick = false;
+    }
+}
+
+void vTaskDelayUntil(TickType_t* lastWake, TickType_t period) {
+    *lastWake += period;
+    int32_t remaining = (int32_t)(*lastWake - xTaskGetTickCount());
+    if (remaining > 0) vTaskDelay(remaining);
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*fn)(void*), const char* name, uint32_t, void* param,
+                                   UBaseType_t, TaskHandle_t*, int) {
+    if (hostRunTask != nullptr && strcmp(name, hostRunTask) == 0) fn(param);
+    return pdPASS;
+}
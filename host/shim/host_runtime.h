@@ -0,0 +1,19 @@
+#ifndef HOST_RUNTIME_H
+#define HOST_RUNTIME_H
+
+#include <Arduino.h>
+
+// ==================================================================================
+// AMBIENTE DOS TESTES NO PC
+// ==================================================================================
+
+extern uint64_t hostVirtualUs;
+
+// Chamado a cada tick de vTaskDelay() (ex.: encoder.update() + motorController.update())
+extern void (*hostTickHook)();
+
+// Nome da task que xTaskCreatePinnedToCore() executa na hora, ate o fim (as demais
+// nao rodam: nao ha escalonador)
+extern const char* hostRunTask;
+
+#endif
@@ -0,0 +1,155 @@
+// Journal de posicao no PC: a task real do journal grava enquanto o motor simulado
+// anda e a energia cai em instantes aleatorios, as vezes no meio de uma escrita na
+// flash (particao em RAM com semantica NOR). A cada "boot" o recover() tem de achar
+// a entrada valida de maior sequencia que uma varredura completa (RTC + anel
+// inteiro) acha, com o anel dando varias voltas. Queda total tambem perde a RTC.
+#include "host_runtime.h"
+#include "encoder.h"
+#include "storage.h"
+#include "motor_control.h"
+#include "position_journal.h"
+#include <esp_partition.h>
+#include <memory>
+
+#define JOURNAL_TEST_BOOTS 400
+#define JOURNAL_TEST_MAX_RUN_TICKS 3000   // Energia cai ate 3 s depois do boot
+#define JOURNAL_TEST_DWELL_TICKS 300      // Parado entre movimentos (apaga o setor seguinte)
+
+// Posicao recuperada x posicao real na queda: limiar de gravacao + uma amostra de
+// atraso + uma entrada perdida pela escrita rasgada, na velocidade maxima
+#define JOURNAL_SAMPLE_DEG (SIM_MAX_SPEED_DPS / JOURNAL_RATE_HZ)
+#define JOURNAL_MAX_LAG_DEG (JOURNAL_FLASH_THRESHOLD_DEG + 2 * JOURNAL_SAMPLE_DEG)
+
+// Anel da RTC (RTC_NOINIT_ATTR): secao propria no build do host
+extern uint8_t __start_host_rtc_noinit[];
+extern uint8_t __stop_host_rtc_noinit[];
+
+Encoder encoder(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_PPR, GEAR_RATIO);
+StorageManager storage;
+MotorController motorController(&encoder, &storage);
+
+static uint32_t ticksThisBoot = 0;
+static uint32_t cutAtTick = 0;
+static int tornBytes = -1;                 // -1 = queda entre escritas
+static bool cutArmed = false;
+static uint32_t idleTicks = 0;
+
+static void motorCycle() {
+    encoder.update();
+    motorController.update();
+
+    if (motorController.isInMotion()) {
+        idleTicks = 0;
+    } else if (++idleTicks == JOURNAL_TEST_DWELL_TICKS) {
+        motorController.moveToAngle((float)random(-170, 171), COMMAND_SOURCE_BENCH);
+    }
+
+    if (++ticksThisBoot < cutAtTick) return;
+    if (tornBytes < 0 || ticksThisBoot > cutAtTick + JOURNAL_TEST_MAX_RUN_TICKS) {
+        hostPartitionCutBytes = -1;
+        throw HostPowerCut();
+    }
+    if (!cutArmed) {
+        hostPartitionCutBytes = tornBytes;   // Cai na proxima escrita da flash
+        cutArmed = true;
+    }
+}
+
+// Oraculo: todas as entradas da RTC e do anel inteiro, sem a busca pelo setor mais novo
+static bool newestEverywhere(JournalEntry& newest) {
+    bool found = false;
+    uint32_t torn = 0;
+    PositionJournal::scanEntries((const JournalEntry*)__start_host_rtc_noinit,
+                                 (__stop_host_rtc_noinit - __start_host_rtc_noinit) / sizeof(JournalEntry),
+                                 newest, found, torn);
+    PositionJournal::scanEntries((const JournalEntry*)hostPartitionMem,
+                                 JOURNAL_FLASH_SECTORS * JOURNAL_ENTRIES_PER_SECTOR, newest, found, torn);
+    return found;
+}
+
+int main() {
+    int failures = 0;
+
+    StaticJsonDocument<256> doc;
+    if (!positionJournal.runSelfTest(doc.to<JsonObject>())) {
+        printf("FALHA: PositionJournal::runSelfTest\n");
+        failures++;
+    }
+
+    storage.begin();
+    encoder.begin();
+    motorController.begin();
+    hostTickHook = motorCycle;
+    hostRunTask = "Journal";
+    hostPartitionPresent = true;
+    memset(hostPartitionMem, 0xFF, sizeof(hostPartitionMem));
+
+    uint32_t lastSequence = 0;
+    uint32_t highestSequence = 0;
+    float cutPosition = 0.0f;
+    bool fullLoss = true;
+    int tornCuts = 0, fullLosses = 0;
+    for (int boot = 0; boot < JOURNAL_TEST_BOOTS && failures < 10; boot++) {
+        if (fullLoss) {
+            // Sem alimentacao a RTC volta com lixo
+            for (uint8_t* p = __start_host_rtc_noinit; p < __stop_host_rtc_noinit; p++) *p = (uint8_t)rand();
+            fullLosses++;
+        }
+
+        std::unique_ptr<PositionJournal> journal(new PositionJournal());
+        JournalEntry recovered;
+        bool found = journal->recover(recovered);
+        JournalEntry expected;
+        bool expectedFound = newestEverywhere(expected);
+
+        if (found != expectedFound || (found && recovered.sequence != expected.sequence)) {
+            printf("FALHA: boot %d recuperou seq %u, varredura completa %u\n", boot,
+                   found ? (unsigned)recovered.sequence : 0, expectedFound ? (unsigned)expected.sequence : 0);
+            failures++;
+        } else if (boot > 0 && !found) {
+            printf("FALHA: boot %d sem posicao\n", boot);
+            failures++;
+        } else if (found) {
+            // Queda total pode voltar a ultima entrada da flash (as da RTC se perderam),
+            // dentro do limiar da flash; so com a RTC intacta a sequencia nunca volta
+            if (!fullLoss && recovered.sequence < lastSequence) {
+                printf("FALHA: boot %d voltou para a seq %u (antes %u)\n", boot,
+                       (unsigned)recovered.sequence, (unsigned)lastSequence);
+                failures++;
+            }
+            if (fabs(recovered.absolutePosition - cutPosition) > JOURNAL_MAX_LAG_DEG) {
+                printf("FALHA: boot %d recuperou %.2f, posicao na queda %.2f\n", boot,
+                       recovered.absolutePosition, cutPosition);
+                failures++;
+            }
+            lastSequence = recovered.sequence;
+            highestSequence = max(highestSequence, recovered.sequence);
+        }
+
+        // Proxima queda
+        ticksThisBoot = 0;
+        cutAtTick = 100 + random(JOURNAL_TEST_MAX_RUN_TICKS);
+        tornBytes = random(3) == 0 ? -1 : (int)random(sizeof(JournalEntry));
+        cutArmed = false;
+        try {
+            journal->begin(&motorController);
+        } catch (const HostPowerCut&) {
+        }
+        if (cutArmed && hostPartitionCutBytes < 0 && ticksThisBoot <= cutAtTick + JOURNAL_TEST_MAX_RUN_TICKS) {
+            tornCuts++;
+        }
+        hostPartitionCutBytes = -1;
+        cutPosition = motorController.getState().absolutePosition;
+        fullLoss = random(2) == 0;
+    }
+
+    uint32_t ringEntries = JOURNAL_FLASH_SECTORS * JOURNAL_ENTRIES_PER_SECTOR;
+    printf("%d boots, %d com escrita rasgada, %d sem RTC, seq maxima %u (%.1f voltas do anel)\n",
+           JOURNAL_TEST_BOOTS, tornCuts, fullLosses, (unsigned)highestSequence, (float)highestSequence / ringEntries);
+    if (highestSequence < 2 * ringEntries) {
+        printf("FALHA: o anel nao deu a volta\n");
+        failures++;
+    }
+    printf("Falhas: %d\n", failures);
+    return failures == 0 ? 0 : 1;
+}
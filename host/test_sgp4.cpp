@@ -0,0 +1,91 @@
+// Vetores de referencia do SGP4 no PC (Vallado, SGP4-VER, satelite 00005: perigeu
+// baixo e excentricidade 0.186, o caso near-earth mais sensivel do arquivo).
+// Sgp4<double> tem de bater em < 1 m e < 1 mm/s; Sgp4<float> (SAT_USE_FLOAT)
+// dentro do erro documentado. Tambem roda o autoteste de /api/sat/selftest.
+#include "host_runtime.h"
+#include "sgp4.h"
+#include "sat_tracker.h"
+
+#define SGP4_DOUBLE_MAX_KM 0.001
+#define SGP4_DOUBLE_MAX_KM_S 0.000001
+#define SGP4_FLOAT_MAX_KM 0.2           // "Dezenas de metros" (config.h); ~83 m no x86
+#define SGP4_FLOAT_MAX_KM_S 0.001
+
+static const char* TLE1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+static const char* TLE2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+// Minutos desde a epoca, posicao TEME (km), velocidade (km/s)
+static const double VECTORS[][7] = {
+    {    0.0,  7022.46529266, -1400.08296755,     0.03995155,  1.893841015,  6.405893759,  4.534807250 },
+    {  360.0, -7154.03120202, -3783.17682504, -3536.19412294,  4.741887409, -4.151817765, -2.093935425 },
+    {  720.0, -7134.59340119,  6531.68641334,  3260.27186483, -4.113793027, -2.911922039, -2.557327851 },
+    { 1080.0,  5568.53901181,  4492.06992591,  3863.87641983, -4.209106476,  5.159719888,  2.744852980 },
+    { 1440.0,  -938.55923943, -6268.18748831, -4294.02924751,  7.536105209, -0.427127707,  0.989878080 },
+};
+static const int VECTOR_COUNT = sizeof(VECTORS) / sizeof(VECTORS[0]);
+
+static int failures = 0;
+
+static double distance(const double a[3], const double b[3]) {
+    double dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+    return sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+template <typename T>
+static void checkVectors(const TleElements& tle, const char* name, double maxKm, double maxKmS) {
+    Sgp4<T> sgp4;
+    int error = sgp4.init(tle);
+    if (error != SGP4_OK) {
+        printf("FALHA: Sgp4<%s>::init = %d\n", name, error);
+        failures++;
+        return;
+    }
+    double worstKm = 0, worstKmS = 0;
+    for (int i = 0; i < VECTOR_COUNT; i++) {
+        T r[3], v[3];
+        error = sgp4.propagate(VECTORS[i][0], r, v);
+        if (error != SGP4_OK) {
+            printf("FALHA: Sgp4<%s>::propagate(%.0f) = %d\n", name, VECTORS[i][0], error);
+            failures++;
+            return;
+        }
+        double rd[3] = { (double)r[0], (double)r[1], (double)r[2] };
+        double vd[3] = { (double)v[0], (double)v[1], (double)v[2] };
+        worstKm = max(worstKm, distance(rd, &VECTORS[i][1]));
+        worstKmS = max(worstKmS, distance(vd, &VECTORS[i][4]));
+    }
+    printf("Sgp4<%s>: erro maximo %.6f km, %.9f km/s\n", name, worstKm, worstKmS);
+    if (worstKm > maxKm || worstKmS > maxKmS) {
+        printf("FALHA: Sgp4<%s> fora da tolerancia (%.6f km, %.9f km/s)\n", name, maxKm, maxKmS);
+        failures++;
+    }
+}
+
+int main() {
+    TleElements tle;
+    if (!parseTle(TLE1, TLE2, tle)) {
+        printf("FALHA: TLE de referencia rejeitada\n");
+        return 1;
+    }
+    checkVectors<double>(tle, "double", SGP4_DOUBLE_MAX_KM, SGP4_DOUBLE_MAX_KM_S);
+    checkVectors<float>(tle, "float", SGP4_FLOAT_MAX_KM, SGP4_FLOAT_MAX_KM_S);
+
+    // Checksum errado (ultimo digito da linha 1) tem de ser recusado
+    char corrupted[80];
+    strcpy(corrupted, TLE1);
+    corrupted[strlen(corrupted) - 1] = '0';
+    TleElements rejected;
+    if (parseTle(corrupted, TLE2, rejected)) {
+        printf("FALHA: checksum invalido aceito\n");
+        failures++;
+    }
+
+    StaticJsonDocument<512> doc;
+    if (!satTracker.runSelfTest(doc.to<JsonObject>())) {
+        printf("FALHA: SatTracker::runSelfTest\n");
+        failures++;
+    }
+
+    printf("Falhas: %d\n", failures);
+    return failures == 0 ? 0 : 1;
+}
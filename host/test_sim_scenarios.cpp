@@ -0,0 +1,66 @@
+// Cenarios do sim_benchmark no PC: MotorController::update() real contra o
+// plant_simulator, um ciclo por tick de 1 ms de tempo virtual. Falha se algum
+// cenario estourar o tempo ou parar longe do alvo.
+#include "host_runtime.h"
+#include "encoder.h"
+#include "storage.h"
+#include "motor_control.h"
+#include "sim_benchmark.h"
+#include <chrono>
+
+// Erro medido no eixo simulado (ruido do encoder incluso), nao na estimativa do controlador
+#define HOST_MAX_FINAL_ERROR_DEG (2 * ANGLE_TOLERANCE)
+
+Encoder encoder(ENCODER_PIN_A, ENCODER_PIN_B, ENCODER_PPR, GEAR_RATIO);
+StorageManager storage;
+MotorController motorController(&encoder, &storage);
+
+// Ciclos no PC ficam abaixo de 1 us: a coluna do relatorio arredonda, aqui em ns
+static double cycleSumNs = 0, cycleMaxNs = 0;
+static uint32_t cycles = 0;
+
+// micros() e o tempo virtual (so anda no vTaskDelay): a CPU por ciclo vem do relogio real
+static void motorCycle() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    encoder.update();
+    motorController.update();
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    simBenchmark.recordUpdateTime((uint32_t)lround(elapsed.count() / 1000.0));
+    if (simBenchmark.isRunning()) {
+        cycleSumNs += elapsed.count();
+        cycleMaxNs = max(cycleMaxNs, elapsed.count());
+        cycles++;
+    }
+}
+
+int main() {
+    storage.begin();
+    encoder.begin();
+    motorController.begin();
+    hostTickHook = motorCycle;
+    vTaskDelay(pdMS_TO_TICKS(100));
+
+    hostRunTask = "SimBench";
+    simBenchmark.begin(&motorController, &encoder);
+    simBenchmark.start();
+
+    if (cycles > 0) {
+        printf("CPU por ciclo no host (encoder + motor): %.0f ns medio, %.0f ns maximo, %u ciclos\n",
+               cycleSumNs / cycles, cycleMaxNs, (unsigned)cycles);
+    }
+
+    int failures = 0;
+    for (int i = 0; i < simBenchmark.getResultCount(); i++) {
+        const SimScenarioResult& r = simBenchmark.getResult(i);
+        if (r.timedOut || r.finalErrorDeg > HOST_MAX_FINAL_ERROR_DEG) {
+            printf("FALHA: %s (%s, erro %.3f graus)\n", r.name, r.timedOut ? "timeout" : "parou",
+                   r.finalErrorDeg);
+            failures++;
+        }
+    }
+    if (simBenchmark.getResultCount() == 0) {
+        printf("FALHA: nenhum cenario executado\n");
+        failures++;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+#ifndef METRICS_WRITER_H
+#define METRICS_WRITER_H
+
+#include <Arduino.h>
+
+// ==================================================================================
+// FORMATO DE TEXTO DO PROMETHEUS (exposicao 0.0.4) EM BUFFER FIXO
+// ==================================================================================
+// Acrescenta "# HELP", "# TYPE" e amostras num buffer do chamador, sem String
+// e sem alocacao. Se nao couber, marca overflow e para de escrever.
+
+class MetricsWriter {
+private:
+    char* out;
+    size_t size;
+    size_t used = 0;
+    bool overflow = false;
+
+    void appendf(const char* format, ...) __attribute__((format(printf, 2, 3))) {
+        if (overflow) return;
+        va_list args;
+        va_start(args, format);
+        int n = vsnprintf(out + used, size - used, format, args);
+        va_end(args);
+        if (n < 0 || (size_t)n >= size - used) {
+            overflow = true;
+            out[used] = '\0';
+            return;
+        }
+        used += n;
+    }
+
+public:
+    MetricsWriter(char* buffer, size_t bufferSize) : out(buffer), size(bufferSize) {
+        if (size > 0) out[0] = '\0';
+    }
+
+    // type: "counter" ou "gauge"
+    void family(const char* name, const char* type, const char* help) {
+        appendf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+
+    // labels sem chaves, ex.: "reason=\"tolerance\"" (nullptr = sem labels)
+    void sample(const char* name, uint32_t value, const char* labels = nullptr) {
+        if (labels) appendf("%s{%s} %u\n", name, labels, (unsigned)value);
+        else appendf("%s %u\n", name, (unsigned)value);
+    }
+
+    void sample(const char* name, float value, const char* labels = nullptr) {
+        if (labels) appendf("%s{%s} %.3f\n", name, labels, value);
+        else appendf("%s %.3f\n", name, value);
+    }
+
+    size_t length() { return used; }
+    bool overflowed() { return overflow; }
+};
+
+#endif
@@ -0,0 +1,79 @@
+#include "motion_profile.h"
+
+// Formulas do perfil de 7 trechos simetrico (Biagiotti & Melchiorri,
+// "Trajectory Planning for Automatic Machines", cap. 3.4)
+
+void MotionProfile::plan(float startPos, float endPos, float maxVel, float maxAccel, float maxJerk) {
+    start = startPos;
+    distance = fabs(endPos - startPos);
+    direction = (endPos >= startPos) ? 1.0f : -1.0f;
+    jerk = maxJerk;
+
+    // Tentar com cruzeiro na velocidade maxima
+    if (maxVel * maxJerk >= maxAccel * maxAccel) {
+        tj = maxAccel / maxJerk;
+        ta = tj + maxVel / maxAccel;
+    } else {
+        tj = sqrt(maxVel / maxJerk);      // Velocidade maxima chega antes da aceleracao maxima
+        ta = 2.0f * tj;
+    }
+    tv = (maxVel > 0.0f) ? distance / maxVel - ta : 0.0f;
+
+    if (tv < 0.0f) {
+        // Curto demais para cruzar: reduzir o pico de velocidade
+        tv = 0.0f;
+        if (distance >= 2.0f * maxAccel * maxAccel * maxAccel / (maxJerk * maxJerk)) {
+            tj = maxAccel / maxJerk;
+            ta = tj / 2.0f + sqrt((tj / 2.0f) * (tj / 2.0f) + distance / maxAccel);
+        } else {
+            tj = cbrt(distance / (2.0f * maxJerk));  // Nem a aceleracao maxima e atingida
+            ta = 2.0f * tj;
+        }
+    }
+
+    peakAccel = maxJerk * tj;
+    peakVelocity = peakAccel * (ta - tj);
+}
+
+void MotionProfile::sampleAcceleration(float t, float& pos, float& vel, float& acc) const {
+    if (t < tj) {
+        pos = jerk * t * t * t / 6.0f;
+        vel = jerk * t * t / 2.0f;
+        acc = jerk * t;
+    } else if (t < ta - tj) {
+        pos = peakAccel / 6.0f * (3.0f * t * t - 3.0f * tj * t + tj * tj);
+        vel = peakAccel * (t - tj / 2.0f);
+        acc = peakAccel;
+    } else {
+        float r = ta - t;
+        pos = peakVelocity * ta / 2.0f - peakVelocity * r + jerk * r * r * r / 6.0f;
+        vel = peakVelocity - jerk * r * r / 2.0f;
+        acc = jerk * r;
+    }
+}
+
+void MotionProfile::sample(float t, float& pos, float& vel, float& acc) const {
+    float duration = getDuration();
+    float p, v, a;
+
+    if (t <= 0.0f) {
+        p = 0.0f; v = 0.0f; a = 0.0f;
+    } else if (t >= duration) {
+        p = distance; v = 0.0f; a = 0.0f;
+    } else if (t < ta) {
+        sampleAcceleration(t, p, v, a);
+    } else if (t < ta + tv) {
+        p = peakVelocity * ta / 2.0f + peakVelocity * (t - ta);
+        v = peakVelocity;
+        a = 0.0f;
+    } else {
+        // Desaceleracao = aceleracao espelhada no tempo
+        sampleAcceleration(duration - t, p, v, a);
+        p = distance - p;
+        a = -a;
+    }
+
+    pos = start + direction * p;
+    vel = direction * v;
+    acc = direction * a;
+}
@@ -0,0 +1,37 @@
+#ifndef MOTION_PROFILE_H
+#define MOTION_PROFILE_H
+
+#include <Arduino.h>
+
+// ==================================================================================
+// PERFIL DE MOVIMENTO COM JERK LIMITADO (curva S, repouso a repouso)
+// ==================================================================================
+// Planejamento de tempo minimo para velocidade, aceleracao e jerk maximos:
+// acelera (jerk+, aceleracao constante, jerk-), cruza, e desacelera de forma
+// simetrica. Sem espaco para cruzeiro, o pico de velocidade (e, se preciso, o de
+// aceleracao) e reduzido. sample() devolve posicao/velocidade/aceleracao de
+// referencia para o controle em malha fechada (MotorController).
+
+class MotionProfile {
+private:
+    float start = 0.0f;
+    float distance = 0.0f;     // Sem sinal; direction guarda o sentido
+    float direction = 1.0f;
+    float jerk = 0.0f;
+    float tj = 0.0f;           // Duracao de cada trecho de jerk
+    float ta = 0.0f;           // Duracao da aceleracao (= desaceleracao)
+    float tv = 0.0f;           // Duracao do cruzeiro
+    float peakAccel = 0.0f;
+    float peakVelocity = 0.0f;
+
+    void sampleAcceleration(float t, float& pos, float& vel, float& acc) const;
+
+public:
+    void plan(float startPos, float endPos, float maxVel, float maxAccel, float maxJerk);
+    void sample(float t, float& pos, float& vel, float& acc) const;
+    float getDuration() const { return 2.0f * ta + tv; }
+    float getPeakVelocity() const { return peakVelocity; }
+    float getEnd() const { return start + direction * distance; }
+};
+
+#endif
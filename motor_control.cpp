@@ -1,5 +1,20 @@
 #include "motor_control.h"
 #include "config.h"
+#include "deferred_log.h"
+#include "profiler.h"
+#include "trace_recorder.h"
+#if PLANT_SIMULATION
+#include "plant_simulator.h"
+#endif
+#if MT6701_ENABLED
+#include "absolute_encoder.h"
+#endif
+
+// Intervalos medidos em us; meio periodo de tolerancia porque os ticks do
+// timer de controle chegam com jitter (um tick 999us nao deve pular o passo)
+static inline bool intervalElapsed(unsigned long nowUs, unsigned long sinceUs, unsigned long intervalMs) {
+    return (nowUs - sinceUs) + (CONTROL_LOOP_PERIOD_US / 2) >= intervalMs * 1000UL;
+}
 
 MotorController::MotorController(Encoder* enc, StorageManager* store) 
     : encoder(enc), 
@@ -20,7 +35,6 @@ MotorController::MotorController(Encoder* enc, StorageManager* store)
       isManualMode(false),
       lastUpdateTime(0),
       lastAccelTime(0) {
-    mutex = xSemaphoreCreateMutex();
 }
 
 void MotorController::begin() {
@@ -49,14 +63,13 @@ void MotorController::begin() {
     digitalWrite(pinREN, HIGH);  // Ativar o driver (REN e LEN juntos)
     
     Serial.println("Motor controller OK (REN+LEN ligados juntos)");
-
-    lastAngleDeg = encoder->getRawAngle(); // Usar getRawAngle que eh thread-safe agora
     
     // Carregar parâmetros aprendidos
     loadLearnedParameters();
 }
 
 void MotorController::setPWM(int pwm, MotorDirection direction) {
+    PROFILE_STAGE(PROFILE_STAGE_PWM);
     currentDirection = direction;
     
     // Inverter direcao se configurado (compile-time)
@@ -92,21 +105,135 @@ void MotorController::setPWM(int pwm, MotorDirection direction) {
         ledcWrite(pwmChannelL, pwm);
         currentPWM = pwm;
     }
+    
+    #if PLANT_SIMULATION
+    // Entregar ao modelo o sinal do canal fisico (R = +, L = -)
+    if (direction == MOTOR_STOP || pwm == 0) {
+        plantSimulator.setDrive(0);
+    } else {
+        plantSimulator.setDrive(direction == MOTOR_CW ? pwm : -pwm);
+    }
+    #endif
 }
 
-void MotorController::stop() {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        isMoving = false;
-        isManualMode = false;
-        targetPWM = 0;
-        targetDirection = MOTOR_STOP;
-        
-        // Forcar parada imediata (Active Brake)
-        setPWM(0, MOTOR_STOP);
-        
-        xSemaphoreGive(mutex);
-        Serial.println("Motor stopping (Active Brake)...");
+// ==================================================================================
+// FILAS DE COMANDOS
+// ==================================================================================
+// Handlers (async_tcp, loop, SatTrack) so empurram um MotorCommand na fila da
+// propria task; a motorTask drena tudo no inicio de cada ciclo. Sem mutex: o
+// estado de controle so e escrito aqui dentro.
+
+bool MotorController::pushCommand(CommandSource source, MotorCommandType type, float value) {
+    MotorCommand command = {type, value};
+    return commandQueues[source].ring.push(command);
+}
+
+bool MotorController::moveToAngle(float angle, CommandSource source) {
+    // Waypoints saem ja (trajMux): a trajetoria carregada depois nao e apagada
+    // quando este comando for executado
+    clearTrajectory();
+    return pushCommand(source, MOTOR_CMD_MOVE, angle);
+}
+
+bool MotorController::manualMove(int speed, CommandSource source) {
+    clearTrajectory();
+    return pushCommand(source, MOTOR_CMD_MANUAL, (float)speed);
+}
+
+void MotorController::stop(CommandSource source) {
+    // Nao depende de vaga na fila: marca a posicao atual e incrementa o contador.
+    // A motorTask para antes de qualquer outro comando e descarta o que esta
+    // origem enfileirou antes da marca
+    clearTrajectory();
+    MotorCommandQueue& queue = commandQueues[source];
+    queue.stopMark.store(queue.ring.producerPosition(), std::memory_order_relaxed);
+    queue.stopRequests.fetch_add(1, std::memory_order_release);
+}
+
+void MotorController::drainCommands() {
+    PROFILE_STAGE(PROFILE_STAGE_COMMANDS);
+    
+    // 1) Paradas primeiro, de qualquer origem
+    bool stopNow = false;
+    for (int s = 0; s < COMMAND_SOURCE_COUNT; s++) {
+        MotorCommandQueue& queue = commandQueues[s];
+        uint32_t requests = queue.stopRequests.load(std::memory_order_acquire);
+        if (requests != queue.stopsHandled) {
+            queue.stopsHandled = requests;
+            commandsDiscarded += queue.ring.discardBefore(queue.stopMark.load(std::memory_order_relaxed));
+            stopNow = true;
+        }
     }
+    if (stopNow) applyStop();
+    
+    // 2) Comandos na ordem de cada fila; alvos consecutivos viram so o ultimo
+    for (int s = 0; s < COMMAND_SOURCE_COUNT; s++) {
+        MotorCommand command;
+        bool moveQueued = false;
+        float moveTarget = 0.0f;
+        while (commandQueues[s].ring.pop(command)) {
+            if (command.type == MOTOR_CMD_MOVE) {
+                if (moveQueued) commandsCoalesced++;
+                moveQueued = true;
+                moveTarget = command.value;
+                continue;
+            }
+            if (moveQueued) {
+                applyMove(moveTarget);
+                moveQueued = false;
+            }
+            applyCommand(command);
+        }
+        if (moveQueued) applyMove(moveTarget);
+    }
+}
+
+void MotorController::applyCommand(const MotorCommand& command) {
+    switch (command.type) {
+        case MOTOR_CMD_MOVE:       applyMove(command.value); break;
+        case MOTOR_CMD_MANUAL:     applyManual((int)command.value); break;
+        case MOTOR_CMD_TRAJECTORY: applyTrajectory(); break;
+        case MOTOR_CMD_AUTOTUNE:   applyAutotune(); break;
+        case MOTOR_CMD_TUNING_DEFAULTS: applyTuningDefaults(); break;
+        case MOTOR_CMD_RESET_LEARNING:  applyResetLearning(); break;
+    }
+}
+
+void MotorController::applyStop() {
+    abortAutotune("stop");
+    isMoving = false;
+    trajectoryActive = false;
+    isManualMode = false;
+    targetPWM = 0;
+    targetDirection = MOTOR_STOP;
+    
+    // Forcar parada imediata (Active Brake)
+    setPWM(0, MOTOR_STOP);
+    stopsApplied++;
+    LOG_INFO("Motor stopping (Active Brake)...");
+}
+
+MotorCommandStats MotorController::getCommandStats() {
+    MotorCommandStats stats;
+    stats.applied = commandsApplied;
+    stats.coalesced = commandsCoalesced;
+    stats.discardedByStop = commandsDiscarded;
+    stats.stops = stopsApplied;
+    stats.dropped = 0;
+    stats.pending = 0;
+    for (int s = 0; s < COMMAND_SOURCE_COUNT; s++) {
+        stats.dropped += commandQueues[s].ring.getDrops();
+        stats.pending += commandQueues[s].ring.size();
+    }
+    return stats;
+}
+
+uint32_t MotorController::getCommandsApplied() {
+    return commandsApplied;
+}
+
+MotorCounters MotorController::getCounters() {
+    return counters;  // Campos de 32 bits: cada um e lido inteiro
 }
 
 float MotorController::calculateShortestPath(float current, float target) {
@@ -122,31 +249,18 @@ float MotorController::calculateShortestPath(float current, float target) {
     return diff;
 }
 
-void MotorController::moveToAngle(float angle) {
-    // Atualizar posição absoluta rastreada
-    updateAbsolutePosition();
-    
+void MotorController::applyMove(float angle) {
     // ============================================================
     // PROTEÇÃO CRÍTICA CONTRA TORÇÃO DE CABO
     // Se absolutePosition JÁ ultrapassou ±180° (por vento, drift, etc),
-    // FORÇAR retorno pelo caminho seguro INDEPENDENTE do ângulo solicitado
+    // o movimento cru (sem normalizar pela posicao) permite voltar direto
     // ============================================================
     
     // Normalizar entrada para ±180°
     while (angle > 180.0) angle -= 360.0;
     while (angle < -180.0) angle += 360.0;
     
-    Serial.printf("\n=== MOVE TO ANGLE DEBUG ===\n");
-    Serial.printf("Solicitacao: %.1f\n", angle);
-    Serial.printf("Pos Absoluta atual: %.1f\n", absolutePosition);
-    
-    // PROTEÇÃO 1: Se JÁ está fora do limite, permitir movimento direto
-    if (absolutePosition > 180.0 || absolutePosition < -180.0) {
-        Serial.printf("!!! ALERTA: Posicao absoluta FORA DO LIMITE (%.1f)! Movimento direto permitido.\n", absolutePosition);
-        // Com movimento cru, permite ir diretamente para qualquer alvo válido
-    }
-    
-    // Lógica normal de movimento
+    abortAutotune("novo alvo");
     
     // Posição alvo é igual ao ângulo solicitado
     float targetAbsPos = angle;
@@ -158,64 +272,51 @@ void MotorController::moveToAngle(float angle) {
     // Evita voltas desnecessárias mesmo quando fora do limite
     if (movement > 180.0) {
         movement -= 360.0;
-        Serial.printf(">>> Normalizando movimento: %.1f° -> %.1f° (caminho mais curto)\n", targetAbsPos - absolutePosition, movement);
     } else if (movement < -180.0) {
         movement += 360.0;
-        Serial.printf(">>> Normalizando movimento: %.1f° -> %.1f° (caminho mais curto)\n", targetAbsPos - absolutePosition, movement);
     }
     
     // PROTEÇÃO CONTRA TORÇÃO: Se movimento normalizado FARIA passar pelos limites, usar caminho alternativo
     float finalPosition = absolutePosition + movement;
-    if (finalPosition > 180.0 || finalPosition < -180.0) {
+    bool longPath = finalPosition > 180.0 || finalPosition < -180.0;
+    if (longPath) {
         // Movimento normalizado levaria fora do limite - usar caminho longo seguro
         if (movement > 0) {
             movement -= 360.0;  // Usar CCW longo
         } else {
             movement += 360.0;  // Usar CW longo
         }
-        Serial.printf(">>> PROTEÇÃO ATIVADA: Movimento ajustado para %.1f° (caminho longo para evitar torção)\n", movement);
     }
     
-    Serial.printf("Movimento direto: %.1f\n", movement);
-    Serial.printf("Posicao final se direto: %.1f\n", absolutePosition + movement);
-    
-    // REMOVIDA: Proteção 2 - A nova lógica de movimento cru já garante segurança
-    Serial.printf("Movimento final: %.1f\n", movement);
-    Serial.printf("Nova pos absoluta sera: %.1f\n", absolutePosition + movement);
-    
-    // Calcular ângulo do encoder correspondente
-    float currentEncoderAngle = encoder->getAngle();
+    // Alvo do encoder: NÃO NORMALIZAR! Mantido acumulado para o controle saber
+    // qual caminho seguir (a normalização acontece apenas para display/comparação)
+    float currentEncoderAngle = Encoder::normalizeAngle(controlRawAngle + encoder->getCalibrationOffset());
     float targetEncoderAngle = currentEncoderAngle + movement;
     
-    Serial.printf("Encoder atual: %.1f\n", currentEncoderAngle);
-    Serial.printf("Target Encoder (acumulado, nao normalizado): %.1f\n", targetEncoderAngle);
-    
-    // NÃO NORMALIZAR! Manter como ângulo acumulado para o PID saber qual caminho ir
-    // A normalização acontece apenas para display/comparação
-    
-    Serial.printf("Movimento final: %.1f graus\n", movement);
-    Serial.printf("Nova pos absoluta sera: %.1f\n", absolutePosition + movement);
-    Serial.printf("========================\n\n");
-    
-    // Iniciar movimento
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        targetAbsolutePosition = absolutePosition + movement;  // NOVO: guardar alvo absoluto
-        targetAngle = targetEncoderAngle;
-        isMoving = true;
-        pidIntegral = 0.0;
-        pidLastError = 0.0;
-        pidLastTime = millis();
-        lastAngleDeg = encoder->getRawAngle();
-        velDegPerSec = 0.0;
-        xSemaphoreGive(mutex);
-    }
+    LOG_INFO("Alvo %.1f: abs %.1f -> %.1f (%+.1f graus%s)", angle, absolutePosition,
+             absolutePosition + movement, movement, longPath ? ", caminho longo" : "");
+    
+    // Iniciar movimento (ponto a ponto encerra a trajetoria)
+    targetAbsolutePosition = absolutePosition + movement;
+    targetAngle = targetEncoderAngle;
+    isMoving = true;
+    isManualMode = false;
+    trajectoryActive = false;
+    pidIntegral = 0.0;
+    pidLastError = 0.0;
+    pidLastTime = micros();
+    commandsApplied++;
+    counters.movesStarted++;
+    #if TRACE_ENABLED
+    traceRecorder.onMoveStarted();
+    #endif
 }
 
 int MotorController::calculatePID(float error, float dt) {
     // PID: output = Kp*error + Ki*integral + Kd*derivative
     
     // Termo Proporcional
-    float P = KP * error;
+    float P = tuning.kp * error;
     
     // Termo Integral (com anti-windup)
     if (abs(error) < 1.0f) {
@@ -224,13 +325,13 @@ int MotorController::calculatePID(float error, float dt) {
         pidIntegral += error * dt;
     }
     // Limitar integral para evitar windup
-    float maxIntegral = PID_OUTPUT_LIMIT / (KI + 0.001);
+    float maxIntegral = PID_OUTPUT_LIMIT / (tuning.ki + 0.001);
     pidIntegral = constrain(pidIntegral, -maxIntegral, maxIntegral);
-    float I = KI * pidIntegral;
+    float I = tuning.ki * pidIntegral;
     
     // Termo Derivativo
     float derivative = (error - pidLastError) / (dt + 0.001);
-    float D = KD * derivative;
+    float D = tuning.kd * derivative;
     
     // Saida total
     int output = (int)(P + I + D);
@@ -245,10 +346,11 @@ int MotorController::calculatePID(float error, float dt) {
 }
 
 void MotorController::smoothAcceleration() {
-    unsigned long currentTime = millis();
+    PROFILE_STAGE(PROFILE_STAGE_SMOOTH);
+    unsigned long currentTime = micros();
     
     // Controlar tempo entre passos de aceleracao
-    if (currentTime - lastAccelTime < PWM_ACCEL_DELAY) {
+    if (!intervalElapsed(currentTime, lastAccelTime, PWM_ACCEL_DELAY)) {
         return;
     }
     lastAccelTime = currentTime;
@@ -288,61 +390,131 @@ void MotorController::smoothAcceleration() {
 }
 
 void MotorController::update() {
-    unsigned long currentTime = millis();
+    controlStep();
+    observeDynamics();
+    publishState();
+    #if TRACE_ENABLED
+    recordTrace();
+    #endif
+}
+
+void MotorController::publishState() {
+    PROFILE_STAGE(PROFILE_STAGE_PUBLISH);
+    EncoderState enc = encoder->getState();
+    float offset = encoder->getCalibrationOffset();
+    
+    float rawAngle = encoder->countsToDegrees(enc.filteredCount);
+    
+    MotorState state;
+    state.angle = Encoder::normalizeAngle(rawAngle + offset);
+    state.rawAngle = rawAngle;
+    state.velocityDegPerSec = encoder->velocityToDegPerSec(enc.velocityCountsQ8);
+    state.targetAngle = targetAngle;
+    state.targetAbsolutePosition = targetAbsolutePosition;
+    state.absolutePosition = absolutePosition;
+    state.currentPWM = currentPWM;
+    state.targetPWM = targetPWM;
+    state.flags = 0;
+    if (isMoving) state.flags |= MOTOR_FLAG_MOVING;
+    if (isManualMode) state.flags |= MOTOR_FLAG_MANUAL;
+    if (isMoving || isManualMode || currentPWM > 0 || autotuner.isActive()) state.flags |= MOTOR_FLAG_IN_MOTION;
+    if (limitExceeded) state.flags |= MOTOR_FLAG_LIMIT_EXCEEDED;
+    if (runtimeInvert) state.flags |= MOTOR_FLAG_INVERTED;
+    if (trajectoryActive) state.flags |= MOTOR_FLAG_TRAJECTORY;
+    if (autotuner.isActive()) state.flags |= MOTOR_FLAG_AUTOTUNE;
+    state.cycle = ++publishCycle;
+    published.store(state);
+}
+
+#if TRACE_ENABLED
+// Uma amostra por ciclo (so com captura ativa): leituras ja calculadas + copia de 24 bytes
+void MotorController::recordTrace() {
+    PROFILE_STAGE(PROFILE_STAGE_TRACE);
+    bool controlRan = traceControlRan;
+    traceControlRan = false;
+    bool inMotion = isMoving || isManualMode || currentPWM > 0 || autotuner.isActive();
+    if (!traceRecorder.service(inMotion)) return;
+    
+    TraceSample sample;
+    sample.angle = encoder->getRawAngle() + encoder->getCalibrationOffset();
+    sample.error = trajectoryActive ? trajRefPosition - absolutePosition : targetAngle - sample.angle;
+    sample.velDegPerSec = encoder->getVelocityDegPerSec();
+    sample.targetPWM = targetPWM;
+    sample.currentPWM = currentPWM;
+    sample.absolutePositionCenti = (int16_t)constrain(absolutePosition * 100.0f, -32768.0f, 32767.0f);
+    sample.zone = traceZone;
+    sample.flags = 0;
+    if (pulsePhaseOn && traceZone == TRACE_ZONE_PULSE) sample.flags |= TRACE_FLAG_PULSE_ON;
+    if (currentDirection == MOTOR_CW) sample.flags |= TRACE_FLAG_DIR_CW;
+    if (currentDirection == MOTOR_CCW) sample.flags |= TRACE_FLAG_DIR_CCW;
+    if (limitExceeded) sample.flags |= TRACE_FLAG_LIMIT;
+    if (controlRan) sample.flags |= TRACE_FLAG_CONTROL;
+    traceRecorder.push(sample);
+}
+#endif
+
+void MotorController::controlStep() {
+    PROFILE_STAGE(PROFILE_STAGE_CONTROL);
+    unsigned long currentTime = micros();
     
     // Atualizar rastreamento de posição absoluta a cada ciclo
     updateAbsolutePosition();
     
-    // Copiar variaveis compartilhadas para locais (thread-safe)
-    bool localIsManualMode;
-    bool localIsMoving;
-    float localTargetAngle;
-    float localTargetAbsolutePosition;
-    int localSpeedPercent;
-    
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(5)) == pdTRUE) {
-        localIsManualMode = isManualMode;
-        localIsMoving = isMoving;
-        localTargetAngle = targetAngle;
-        localTargetAbsolutePosition = targetAbsolutePosition;
-        localSpeedPercent = speedPercent;
-        xSemaphoreGive(mutex);
-    } else {
-        return; // Se nao conseguir lock, tenta na proxima
+    // Comandos das filas (depois do tracking: o planejamento usa a posicao deste ciclo)
+    drainCommands();
+    
+    // Autotune em malha aberta: nada do controle normal roda
+    if (autotuner.isActive()) {
+        autotuneStep(currentTime);
+        return;
     }
     
+    bool localIsManualMode = isManualMode;
+    bool localIsMoving = isMoving;
+    float localTargetAngle = targetAngle;
+    float localTargetAbsolutePosition = targetAbsolutePosition;
+    int localSpeedPercent = speedPercent;
+    bool localTrajectoryActive = trajectoryActive;
+    if (!localIsMoving || localIsManualMode) profileActive = false;
+    
     // Modo manual - apenas suavizar aceleracao/desaceleracao
     if (localIsManualMode) {
+        traceZone = TRACE_ZONE_MANUAL;
         smoothAcceleration();
         return;
     }
     
     // Desacelerando apos parar
     if (!localIsMoving && currentPWM > 0) {
+        traceZone = TRACE_ZONE_COAST;
         smoothAcceleration();
         return;
     }
     
     // Modo automatico - ir para angulo
-    if (!localIsMoving) return;
+    if (!localIsMoving) {
+        traceZone = TRACE_ZONE_IDLE;
+        return;
+    }
     
     // Sempre aplicar suavizacao
-    if (currentTime - lastAccelTime >= PWM_ACCEL_DELAY) {
+    if (intervalElapsed(currentTime, lastAccelTime, PWM_ACCEL_DELAY)) {
         smoothAcceleration();
     }
     
     // Atualizar logica de controle PID
-    if (currentTime - lastUpdateTime < UPDATE_INTERVAL) {
+    if (!intervalElapsed(currentTime, lastUpdateTime, UPDATE_INTERVAL)) {
         return;
     }
     
-    // Calcular dt para PID
-    float dt = (currentTime - lastUpdateTime) / 1000.0; // Converter para segundos
+    // Calcular dt para PID (relogio de microssegundos, sem quantizacao de 1ms)
+    float dt = (currentTime - lastUpdateTime) / 1000000.0f;
     lastUpdateTime = currentTime;
+    // Primeiro ciclo apos ficar parado: intervalo nao representa o periodo de controle
+    if (dt > 0.1f) dt = UPDATE_INTERVAL / 1000.0f;
+    traceControlRan = true;
     
-    float currentAngle = encoder->getRawAngle(); // Usar getRawAngle que eh rapido e thread-safe
-    // Ajustar offset se necessario, mas para controle PID o raw + offset eh o que importa
-    // O encoder->getRawAngle() retorna o angulo interno filtrado.
+    float currentAngle = controlRawAngle; // Observador (sem o atraso do filtro), atualizado neste ciclo
     // Precisamos somar o offset para comparar com o targetAngle que eh absoluto.
     currentAngle += encoder->getCalibrationOffset();
     // NÃO normalizar currentAngle! Manter como acumulado para comparar com targetAngle acumulado
@@ -357,16 +529,16 @@ void MotorController::update() {
     while (error < -540.0) error += 360.0;
     
     float absError = abs(error);
-
-    // Estimar velocidade angular filtrada
-    float deltaAng = currentAngle - lastAngleDeg;
-    // Detectar cruzamento de 0°/360° para cálculo de velocidade
-    if (deltaAng > 180.0) deltaAng -= 360.0;
-    if (deltaAng < -180.0) deltaAng += 360.0;
     
-    float instVel = deltaAng / (dt + 0.001f);
-    velDegPerSec = (0.8f * velDegPerSec) + (0.2f * instVel);
-    lastAngleDeg = currentAngle;
+    // Alvo em movimento: feedforward + PI, sem zonas nem gerador de pulsos
+    if (localTrajectoryActive) {
+        profileActive = false;
+        int trajMaxPWM = (PWM_MAX * localSpeedPercent) / 100;
+        if (trajMaxPWM < PWM_MIN) trajMaxPWM = PWM_MIN;
+        traceZone = TRACE_ZONE_TRAJECTORY;
+        trajectoryStep(dt, currentAngle, trajMaxPWM);
+        return;
+    }
     
     // Verificar chegada usando POSIÇÃO ABSOLUTA (para detecção correta com movimentos > 180°)
     float absPositionError = abs(absolutePosition - localTargetAbsolutePosition);
@@ -376,15 +548,14 @@ void MotorController::update() {
         // Analisar overshoot para aprendizado
         analyzeOvershoot(currentAngle);
         
-        Serial.printf("Chegou ao alvo! AbsPos: %.1f (target: %.1f), Encoder: %.1f (target: %.1f)\n",
-                     absolutePosition, localTargetAbsolutePosition, currentAngle, localTargetAngle);
+        counters.arrivalsTolerance++;
+        traceZone = TRACE_ZONE_ARRIVED;
+        LOG_INFO("Chegou ao alvo! AbsPos: %.1f (target: %.1f), Encoder: %.1f (target: %.1f)",
+                 absolutePosition, localTargetAbsolutePosition, currentAngle, localTargetAngle);
         
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            isMoving = false;
-            targetPWM = 0;
-            targetDirection = MOTOR_STOP;
-            xSemaphoreGive(mutex);
-        }
+        isMoving = false;
+        targetPWM = 0;
+        targetDirection = MOTOR_STOP;
         pidIntegral = 0.0; // Resetar integral
         currentPWM = 0;
         setPWM(0, MOTOR_STOP);
@@ -397,24 +568,43 @@ void MotorController::update() {
     }
     
     // Calcular direcao (NUNCA MUDAR DIRECAO - ir direto)
-    MotorDirection newDirection = (error > 0) ? MOTOR_CW : MOTOR_CCW;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(5)) == pdTRUE) {
-        targetDirection = newDirection;
-        xSemaphoreGive(mutex);
-    }
+    targetDirection = (error > 0) ? MOTOR_CW : MOTOR_CCW;
     
     // Aplicar percentual de velocidade do usuario
     int maxPWM = (PWM_MAX * localSpeedPercent) / 100;
     if (maxPWM < PWM_MIN) maxPWM = PWM_MIN;
     
+    // ==================================================================================
+    // PERFIL CURVA S: movimentos longos seguem posicao/velocidade/aceleracao planejadas
+    // ==================================================================================
+    if (profileActive && localTargetAbsolutePosition != profileTarget) {
+        profileActive = false;  // Novo alvo: replanejar a partir da posicao atual
+    }
+    if (!profileActive && absError >= PROFILE_MIN_DEG) {
+        startProfile(localTargetAbsolutePosition, maxPWM, currentTime);
+    }
+    if (profileActive) {
+        float t = (currentTime - profileStartUs) / 1000000.0f;
+        if (t < profile.getDuration()) {
+            float refPosition, refVelocity, refAccel;
+            profile.sample(t, refPosition, refVelocity, refAccel);
+            traceZone = TRACE_ZONE_PROFILE;
+            followReference(refPosition, refVelocity, refAccel, dt, maxPWM);
+            return;
+        }
+        // Fim do perfil: o resto do erro fica com as zonas PID/pulsos
+        // (se ainda passar de PROFILE_MIN_DEG, replaneja no proximo ciclo)
+        profileActive = false;
+        pidIntegral = 0.0f;
+        pidLastError = 0.0f;
+    }
+    
     int newTargetPWM = 0;
     
     // ==================================================================================
-    // ESTRATEGIA HIBRIDA COM APRENDIZADO:
+    // AJUSTE FINAL (perfil concluido ou erro < PROFILE_MIN_DEG):
     // - Zona de Pulsos: < 2 graus (ajuste fino)
-    // - Zona PID: 2 a 10 graus (aproximação controlada)
-    // - Zona de Velocidade: > 10 graus (máxima velocidade)
-    // - Frenagem Preditiva: baseada no aprendizado de inércia
+    // - Zona PID: 2 graus a PROFILE_MIN_DEG (aproximação controlada)
     // ==================================================================================
     
     // Zona de Pulsos - Ajuste fino para alta precisão
@@ -426,25 +616,35 @@ void MotorController::update() {
         if (absError < 0.3) {
             // Analisar overshoot para aprendizado
             analyzeOvershoot(currentAngle);
+            counters.arrivalsDeadband++;
+            traceZone = TRACE_ZONE_ARRIVED;
             
-            // CORREÇÃO: Resetar absolutePosition para targetAbsolutePosition para evitar drift
-            if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-                absolutePosition = targetAbsolutePosition;  // Sincronizar posição absoluta
-                isMoving = false;
-                targetPWM = 0;
-                targetDirection = MOTOR_STOP;
-                xSemaphoreGive(mutex);
-            }
+            // CORREÇÃO: Resetar absolutePosition para targetAbsolutePosition para evitar drift.
+            // Com a fusao do MT6701 saudavel (leitura OK, fase valida, sentido conferido) a
+            // deriva e corrigida pelo angulo absoluto e sincronizar esconderia ate 0.3 grau
+            bool syncToTarget = true;
+            #if MT6701_ENABLED
+            syncToTarget = !absoluteEncoder.isFusionHealthy();
+            #endif
+            if (syncToTarget) absolutePosition = targetAbsolutePosition;  // Sincronizar posição absoluta
+            isMoving = false;
+            targetPWM = 0;
+            targetDirection = MOTOR_STOP;
             setPWM(0, MOTOR_STOP);
             pidIntegral = 0.0f;
             return;
         }
         
+        traceZone = TRACE_ZONE_PULSE;
+        
         // Ajustar intensidade do pulso para motor auto-travante
         // Motor helicoidal precisa pulsos fortes para vencer atrito
         int basePulsePWM = 180;  // Aumentado: engrenagem helicoidal tem muito atrito
         int adaptivePulsePWM = (int)(basePulsePWM / learnedInertiaFactor);
         adaptivePulsePWM = constrain(adaptivePulsePWM, 120, 220);  // Range maior para motor auto-travante
+        // Atrito de partida conhecido neste setor/sentido: pulso com margem acima dele
+        int sectorBreakaway = sectorDynamics.breakawayPWM(absolutePosition, error > 0 ? 0 : 1);
+        if (sectorBreakaway > 0) adaptivePulsePWM = min(sectorBreakaway + DYNAMICS_BREAKAWAY_MARGIN_PWM, PWM_MAX);
         
         // Ajustar duty cycle baseado no erro
         // Pulsos mais curtos para ajuste mais fino (reduzido 25%)
@@ -457,6 +657,10 @@ void MotorController::update() {
         if (pulseCycle < (unsigned long)pulseOnTime) {
             // Fase ON: Pulso adaptativo
             MotorDirection pulseDir = (error > 0) ? MOTOR_CW : MOTOR_CCW;
+            if (!pulsePhaseOn) {
+                pulseCycleCount++;  // Conta ciclos da zona de pulsos (diagnostico/benchmark)
+                pulsePhaseOn = true;
+            }
             
             // Aplicar DIRETAMENTE (bypassing smoothAcceleration)
             setPWM(adaptivePulsePWM, pulseDir);
@@ -468,6 +672,7 @@ void MotorController::update() {
             // Fase OFF: Freio/Parada para medir
             setPWM(0, MOTOR_STOP);
             currentPWM = 0;
+            pulsePhaseOn = false;
         }
         
         // Retornar aqui para nao executar o resto da logica PID/Smooth
@@ -475,55 +680,29 @@ void MotorController::update() {
     }
     
     // ==================================================================================
-    // ZONA PID / PROPORCIONAL (8 a 20 graus) - Motor auto-travante
+    // ZONA PID / PROPORCIONAL (2 graus a PROFILE_MIN_DEG) - Motor auto-travante
+    // Erros maiores seguem o perfil curva S acima
     // ==================================================================================
-    else if (absError < ZONE_MEDIUM) {
-        // Gravar dados para aprendizado quando começar a desacelerar significativamente
-        if (absError < 15.0 && absError > ZONE_SLOW && fabs(velDegPerSec) > 5.0) {
-            recordApproachData(currentAngle, velDegPerSec);
-        }
+    else {
+        traceZone = TRACE_ZONE_PID;
         
         int pidOutput = calculatePID(absError, dt);
 
         // Motor auto-travante precisa PWM mais alto para vencer atrito
-        int pidMaxPWM = 450;  // Aumentado: engrenagem helicoidal tem muito atrito
-        int pidMinPWM = 150;  // Aumentado: precisa vencer auto-travamento
+        // (PID_MIN_PWM/PID_MAX_PWM ou a faixa medida pelo autotune)
+        int pidMaxPWM = tuning.pidMaxPWM;
+        int pidMinPWM = tuning.pidMinPWM;
+        // Setor com atrito de partida maior (tabela por setor): o minimo acompanha,
+        // sem esperar o integral crescer com o rotor travado
+        int sectorBreakaway = sectorDynamics.breakawayPWM(absolutePosition, targetDirection == MOTOR_CCW ? 1 : 0);
+        if (sectorBreakaway > 0) {
+            pidMinPWM = constrain(sectorBreakaway + DYNAMICS_BREAKAWAY_MARGIN_PWM, pidMinPWM, pidMaxPWM);
+        }
 
         // Mapear saída PID para PWM
         newTargetPWM = map(pidOutput, 0, PID_OUTPUT_LIMIT, pidMinPWM, pidMaxPWM);
         newTargetPWM = constrain(newTargetPWM, pidMinPWM, pidMaxPWM);
     }
-    // ==================================================================================
-    // ZONA DE DESACELERAÇÃO PROGRESSIVA ( > 20 graus) - Frenagem muito gradual
-    // ==================================================================================
-    else {
-        // Resetar integral do PID quando longe
-        pidIntegral = 0.0;
-        
-        if (absError > ZONE_FAST) { // > 100 graus - máxima velocidade
-            newTargetPWM = maxPWM;
-        } 
-        else if (absError > 75) { // 75-100 graus - Primeira redução suave
-            newTargetPWM = (maxPWM * 85) / 100;  // Reduz apenas 15%
-        }
-        else if (absError > ZONE_MEDIUM) { // 50-75 graus - Segunda redução progressiva
-            newTargetPWM = (maxPWM * 70) / 100;  // Reduz 30%
-        }
-        else if (absError > 35) { // 35-50 graus - Terceira redução
-            newTargetPWM = (maxPWM * 55) / 100;  // Reduz 45%
-        }
-        else if (absError > ZONE_SLOW) { // 20-35 graus - Quarta redução (NOVO)
-            newTargetPWM = (maxPWM * 40) / 100;  // Reduz 60%
-        }
-        else if (absError > ZONE_MEDIUM_SLOW) { // 5-20 graus - Quinta redução (NOVO)
-            newTargetPWM = (maxPWM * 25) / 100;  // Reduz 75%
-        }
-        else {
-            // < 5 graus: Última redução antes da zona de pulsos
-            newTargetPWM = (maxPWM * 15) / 100;  // Reduz 85%
-        }
-    }
-    
     // Garantir limites mínimos para motor auto-travante
     if (newTargetPWM > 0 && newTargetPWM < 100) {
         newTargetPWM = 100; // Motor helicoidal precisa PWM mínimo alto
@@ -532,114 +711,308 @@ void MotorController::update() {
         newTargetPWM = maxPWM;
     }
 
-    // Frenagem antecipada se velocidade já é muito baixa próximo ao alvo
-    if (absError < 0.3 && fabs(velDegPerSec) < 0.5) {
-        if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-            targetPWM = 0;
-            targetDirection = MOTOR_STOP;
-            isMoving = false;
-            xSemaphoreGive(mutex);
-        }
+    // Frenagem antecipada: o modelo aprendido preve que, cortando agora, o rotor
+    // para dentro do erro restante (so com a previsao convergida e indo para o alvo)
+    float motorVelocity = encoder->getVelocityDegPerSec();
+    float brakingDistance;
+    bool brakingTrusted = motorVelocity * error > 0 &&
+                          predictBrakingDistance(motorVelocity, currentPWM, brakingDistance);
+    if (brakingTrusted) {
+        brakingDistance += sectorDynamics.brakeBias(absolutePosition, motorVelocity > 0 ? 0 : 1);
+    }
+    if (brakingTrusted && brakingDistance >= absError) {
+        if (currentPWM > 0) counters.earlyBrakes++;
+        targetPWM = 0;
+        currentPWM = 0;
         setPWM(0, MOTOR_STOP);
         pidIntegral = 0.0f;
         return;
     }
     
-    // Atualizar targetPWM protegido
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(5)) == pdTRUE) {
-        targetPWM = newTargetPWM;
-        xSemaphoreGive(mutex);
-    }
+    targetPWM = newTargetPWM;
 }
 
-void MotorController::manualMove(int speed) {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(100)) == pdTRUE) {
-        isMoving = false;  // Cancelar modo automatico
-        
-        if (speed == 0) {
-            // Soltar botao = desacelerar suavemente
-            isManualMode = false;
-            targetPWM = 0;
-            targetDirection = MOTOR_STOP;
-            xSemaphoreGive(mutex);
-            return;
-        }
-        
-        // Modo manual ativo
-        isManualMode = true;
-        targetDirection = (speed > 0) ? MOTOR_CW : MOTOR_CCW;
-        
-        // Usar velocidade configurada pelo usuario
-        int maxPWM = (PWM_MAX * speedPercent) / 100;
-        if (maxPWM < PWM_MIN) maxPWM = PWM_MIN;
-        targetPWM = maxPWM;
-        
-        xSemaphoreGive(mutex);
-        Serial.printf("Manual: %s @ %d%%\n", speed > 0 ? "CW" : "CCW", speedPercent);
+void MotorController::applyManual(int speed) {
+    abortAutotune("comando manual");
+    isMoving = false;  // Cancelar modo automatico
+    trajectoryActive = false;
+    commandsApplied++;
+    
+    if (speed == 0) {
+        // Soltar botao = desacelerar suavemente
+        isManualMode = false;
+        targetPWM = 0;
+        targetDirection = MOTOR_STOP;
+        return;
     }
+    
+    // Modo manual ativo
+    isManualMode = true;
+    targetDirection = (speed > 0) ? MOTOR_CW : MOTOR_CCW;
+    
+    // Usar velocidade configurada pelo usuario
+    int maxPWM = (PWM_MAX * speedPercent) / 100;
+    if (maxPWM < PWM_MIN) maxPWM = PWM_MIN;
+    targetPWM = maxPWM;
+    
+    LOG_INFO("Manual: %s @ %d%%", speed > 0 ? "CW" : "CCW", speedPercent);
 }
 
 bool MotorController::isInMotion() {
-    bool moving = false;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        moving = isMoving || isManualMode || currentPWM > 0;
-        xSemaphoreGive(mutex);
-    }
-    return moving;
+    return (published.load().flags & MOTOR_FLAG_IN_MOTION) != 0;
 }
 
 float MotorController::getTargetAngle() {
-    float angle = 0.0f;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        angle = targetAngle;
-        xSemaphoreGive(mutex);
-    }
-    return angle;
+    return published.load().targetAngle;
+}
+
+float MotorController::getTargetAbsolutePosition() {
+    return published.load().targetAbsolutePosition;
+}
+
+uint32_t MotorController::getPulseCycleCount() {
+    return pulseCycleCount;
+}
+
+MotorState MotorController::getState() {
+    return published.load();
+}
+
+uint32_t MotorController::getSnapshotRetries() {
+    return published.getReadRetries();
 }
 
 bool MotorController::hasReachedTarget() {
-    bool reached = true;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        if (isMoving) {
-            float currentAngle = encoder->getAngle(); // getAngle ja eh thread safe
-            float error = calculateShortestPath(currentAngle, targetAngle);
-            reached = (abs(error) < ANGLE_TOLERANCE);
+    MotorState state = published.load();
+    if (!(state.flags & MOTOR_FLAG_MOVING)) return true;
+    float error = calculateShortestPath(state.angle, state.targetAngle);
+    return abs(error) < ANGLE_TOLERANCE;
+}
+
+void MotorController::setRuntimeInvert(bool invert) {
+    runtimeInvert = invert;
+}
+
+bool MotorController::isRuntimeInverted() {
+    return runtimeInvert;
+}
+
+void MotorController::setSpeedPercent(int percent) {
+    speedPercent = constrain(percent, 20, 100);
+}
+
+int MotorController::getSpeedPercent() {
+    return speedPercent;
+}
+
+// ==================================================================================
+// TRAJETORIA (waypoints com feedforward de velocidade)
+// ==================================================================================
+// Ponto a ponto (moveToAngle) zera o PID e desce a escada de zonas ate o gerador
+// de pulsos a cada novo alvo: com alvo em movimento isso vira anda-para. Aqui a
+// referencia e interpolada entre waypoints a cada ciclo e o PWM sai da velocidade
+// da referencia (feedforward) mais um PI no atraso, sem reset entre pontos.
+
+void MotorController::clearTrajectory() {
+    portENTER_CRITICAL(&trajMux);
+    trajHead = 0;
+    trajCount = 0;
+    portEXIT_CRITICAL(&trajMux);
+}
+
+int MotorController::loadTrajectory(const TrajectoryWaypoint* points, int count, bool append,
+                                    CommandSource source) {
+    int accepted = 0;
+    
+    portENTER_CRITICAL(&trajMux);
+    if (!append) {
+        trajHead = 0;
+        trajCount = 0;
+    }
+    for (int i = 0; i < count && trajCount < TRAJECTORY_MAX_WAYPOINTS; i++) {
+        float azimuth = Encoder::normalizeAngle(points[i].azimuth);
+        if (trajCount > 0) {
+            const TrajectoryWaypoint& last = trajPoints[(trajHead + trajCount - 1) % TRAJECTORY_MAX_WAYPOINTS];
+            // Tempo estritamente crescente
+            if ((int32_t)(points[i].timeMs - last.timeMs) <= 0) break;
+            // Salto > 180° = passar pelo ponto de ±180° (torcao do cabo): a trajetoria termina aqui
+            if (fabs(azimuth - last.azimuth) > 180.0f) break;
         }
-        xSemaphoreGive(mutex);
+        TrajectoryWaypoint& slot = trajPoints[(trajHead + trajCount) % TRAJECTORY_MAX_WAYPOINTS];
+        slot.timeMs = points[i].timeMs;
+        slot.azimuth = azimuth;
+        trajCount++;
+        accepted++;
     }
-    return reached;
+    portEXIT_CRITICAL(&trajMux);
+    
+    if (accepted < count) {
+        LOG_WARN("Trajetoria: %d de %d waypoints aceitos (tempo nao crescente, cruzamento de ±180° ou fila cheia)",
+                 accepted, count);
+    }
+    if (accepted == 0) return 0;
+    
+    // Ativacao pela fila: fica na ordem dos outros comandos desta origem
+    if (!pushCommand(source, MOTOR_CMD_TRAJECTORY, 0.0f)) return 0;
+    return accepted;
 }
 
-void MotorController::setRuntimeInvert(bool invert) {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        runtimeInvert = invert;
-        xSemaphoreGive(mutex);
+void MotorController::applyTrajectory() {
+    // Waypoints ja apagados por um moveToAngle/stop/manual posterior: nada a ativar
+    int depth = getTrajectoryDepth();
+    if (depth == 0) return;
+    abortAutotune("trajetoria");
+    commandsApplied++;
+    if (!trajectoryActive) {
+        // Entrada no modo: so o integral recomeca; velocidade estimada e PWM continuam
+        pidIntegral = 0.0;
+        counters.trajectoriesStarted++;
+        LOG_INFO("Trajetoria iniciada: %d waypoints", depth);
     }
+    trajectoryActive = true;
+    isMoving = true;
+    isManualMode = false;
 }
 
-bool MotorController::isRuntimeInverted() {
-    bool inv = false;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        inv = runtimeInvert;
-        xSemaphoreGive(mutex);
+int MotorController::getTrajectoryDepth() {
+    portENTER_CRITICAL(&trajMux);
+    int depth = trajCount;
+    portEXIT_CRITICAL(&trajMux);
+    return depth;
+}
+
+float MotorController::getTrajectoryReference() {
+    return trajRefPosition;
+}
+
+bool MotorController::sampleTrajectory(uint32_t nowMs, float& position, float& velocity) {
+    bool running = true;
+    
+    portENTER_CRITICAL(&trajMux);
+    // Descartar segmentos ja percorridos (o ponto final do segmento atual fica)
+    while (trajCount >= 2 &&
+           (int32_t)(nowMs - trajPoints[(trajHead + 1) % TRAJECTORY_MAX_WAYPOINTS].timeMs) >= 0) {
+        trajHead = (trajHead + 1) % TRAJECTORY_MAX_WAYPOINTS;
+        trajCount--;
     }
-    return inv;
+    
+    if (trajCount == 0) {
+        velocity = 0.0f;
+        running = false;
+    } else {
+        const TrajectoryWaypoint& a = trajPoints[trajHead];
+        if (trajCount == 1 || (int32_t)(nowMs - a.timeMs) < 0) {
+            // Antes do primeiro ponto ou so resta o ultimo: referencia parada nele
+            position = a.azimuth;
+            velocity = 0.0f;
+            if (trajCount == 1 && (int32_t)(nowMs - a.timeMs) >= 0) {
+                trajCount = 0;   // Ultimo ponto vencido: fim da fila
+                running = false;
+            }
+        } else {
+            const TrajectoryWaypoint& b = trajPoints[(trajHead + 1) % TRAJECTORY_MAX_WAYPOINTS];
+            float spanMs = (float)(b.timeMs - a.timeMs);
+            float fraction = (float)(nowMs - a.timeMs) / spanMs;
+            position = a.azimuth + (b.azimuth - a.azimuth) * fraction;
+            velocity = (b.azimuth - a.azimuth) * 1000.0f / spanMs;
+        }
+    }
+    portEXIT_CRITICAL(&trajMux);
+    
+    return running;
 }
 
-void MotorController::setSpeedPercent(int percent) {
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        speedPercent = constrain(percent, 20, 100);
-        xSemaphoreGive(mutex);
+void MotorController::trajectoryStep(float dt, float currentAngle, int maxPWM) {
+    float refPosition = trajRefPosition;
+    float refVelocity = 0.0f;
+    bool running = sampleTrajectory(millis(), refPosition, refVelocity);
+    trajRefPosition = refPosition;
+    trajRefVelocity = refVelocity;
+    
+    // Erro no referencial absoluto: waypoints ja estao em ±180°, entao seguir o
+    // erro nunca passa pelo ponto de torcao do cabo
+    float error = refPosition - absolutePosition;
+    float encoderTarget = currentAngle + error;
+    
+    if (!running) {
+        // Fila consumida: o controle ponto a ponto segura o ultimo waypoint.
+        // (um append concorrente enfileira MOTOR_CMD_TRAJECTORY e reativa o modo)
+        trajectoryActive = false;
+        targetAbsolutePosition = refPosition;
+        targetAngle = encoderTarget;
+        pidIntegral = 0.0f;
+        pidLastError = 0.0f;
+        LOG_INFO("Trajetoria concluida: segurando %.1f (erro %.2f)", refPosition, error);
+        return;
     }
+    
+    targetAbsolutePosition = refPosition;
+    targetAngle = encoderTarget;
+    followReference(refPosition, refVelocity, 0.0f, dt, maxPWM);
 }
 
-int MotorController::getSpeedPercent() {
-    int spd = 100;
-    if (xSemaphoreTake(mutex, pdMS_TO_TICKS(10)) == pdTRUE) {
-        spd = speedPercent;
-        xSemaphoreGive(mutex);
+// Controle comum a trajetoria e ao perfil: feedforward da referencia + PI no atraso.
+// PWM aplicado direto (a referencia ja limita a aceleracao; smoothAcceleration
+// so encontra o PWM ja no alvo)
+void MotorController::followReference(float refPosition, float refVelocity, float refAccel,
+                                      float dt, int maxPWM) {
+    float error = refPosition - absolutePosition;
+    
+    // PI no atraso; integral congelado dentro da banda de espera
+    if (fabs(error) > TRAJ_HOLD_DEG) {
+        pidIntegral += error * dt;
+        float maxIntegral = PWM_MIN / TRAJ_KI;
+        pidIntegral = constrain(pidIntegral, -maxIntegral, maxIntegral);
+    }
+    
+    // Feedforward: atrito do sem-fim + ganho de velocidade. A aceleracao entra
+    // como velocidade antecipada de uma constante de tempo (planta de 1a ordem)
+    float feedforward = 0.0f;
+    float ffVelocity = refVelocity + refAccel * tuning.timeConstantS;
+    if (fabs(refVelocity) > TRAJ_FF_MIN_DPS) {
+        feedforward = ffVelocity * tuning.ffPwmPerDps +
+                      (ffVelocity > 0 ? tuning.ffStaticPWM : -tuning.ffStaticPWM);
+    }
+    float command = feedforward + TRAJ_KP * error + TRAJ_KI * pidIntegral;
+    
+    MotorDirection newDirection;
+    int newTargetPWM;
+    bool pushesAway = (command > 0) != (error > 0);
+    if (fabs(command) < PWM_MIN && (fabs(error) < TRAJ_HOLD_DEG || pushesAway)) {
+        // Referencia mais lenta que o minimo do motor: travar e deixar o atraso crescer
+        newDirection = MOTOR_STOP;
+        newTargetPWM = 0;
+    } else {
+        newDirection = (command > 0) ? MOTOR_CW : MOTOR_CCW;
+        // Piso: PWM_MIN ou o atrito de partida aprendido neste setor (+ margem), se maior
+        int sectorBreakaway = sectorDynamics.breakawayPWM(absolutePosition, newDirection == MOTOR_CCW ? 1 : 0);
+        int sectorFloor = sectorBreakaway > 0 ? sectorBreakaway + DYNAMICS_BREAKAWAY_MARGIN_PWM : 0;
+        int minPWM = min(max(PWM_MIN, sectorFloor), maxPWM);
+        newTargetPWM = constrain((int)fabs(command), minPWM, maxPWM);
     }
-    return spd;
+    
+    // Inversao com o motor girando: um ciclo de freio ativo antes
+    if (newDirection != MOTOR_STOP && currentPWM > 0 && currentDirection != newDirection) {
+        newDirection = MOTOR_STOP;
+        newTargetPWM = 0;
+    }
+    
+    targetDirection = newDirection;
+    targetPWM = newTargetPWM;
+    setPWM(newTargetPWM, newDirection);
+}
+
+void MotorController::startProfile(float target, int maxPWM, unsigned long nowUs) {
+    // Velocidade alcancavel com o PWM maximo atual, pelo modelo do feedforward
+    float maxVelocity = (maxPWM - tuning.ffStaticPWM) / tuning.ffPwmPerDps * PROFILE_VEL_MARGIN;
+    profile.plan(absolutePosition, target, maxVelocity, PROFILE_MAX_ACCEL_DPS2, PROFILE_MAX_JERK_DPS3);
+    profileTarget = target;
+    profileStartUs = nowUs;
+    profileActive = true;
+    pidIntegral = 0.0f;
+    pidLastError = 0.0f;
+    LOG_INFO("Perfil: %.1f -> %.1f, pico %.1f graus/s, %.2f s",
+             absolutePosition, target, profile.getPeakVelocity(), profile.getDuration());
 }
 
 // ==================================================================================
@@ -647,44 +1020,90 @@ int MotorController::getSpeedPercent() {
 // ==================================================================================
 
 void MotorController::loadLearnedParameters() {
+    BrakingModelState states[2];
+    bool hasModels = storage && storage->loadBrakingModels(states);
+    if (hasModels) {
+        for (int i = 0; i < 2; i++) {
+            if (!brakingModels[i].load(states[i])) brakingModels[i].reset(BRAKE_NOMINAL_DEG_PER_DPS);
+        }
+    }
+    
+    SectorTableRecord table;
+    if (storage && storage->loadSectorTable(table) && !sectorDynamics.load(table)) {
+        Serial.println("Tabela de setores em outro formato: recomecando");
+    }
+    
     if (storage && storage->hasLearnedParameters()) {
         learnedInertiaFactor = storage->loadInertiaFactor();
         learnedBrakingDist = storage->loadBrakingDistance();
         overshootAccumulator = storage->loadOvershootHistory();
         learningCycles = storage->loadLearningCycles();
         
+        // Registro antigo (aprendizado por media movel): vira o prior dos dois sentidos
+        if (!hasModels) {
+            float prior = constrain(learnedBrakingDist * learnedInertiaFactor, 0.01f, 1.0f);
+            brakingModels[0].reset(prior);
+            brakingModels[1].reset(prior);
+        }
+        updateLearnedFactors();
+        
         Serial.printf("=== APRENDIZADO CARREGADO ===\n");
         Serial.printf("  Fator Inércia: %.3f\n", learnedInertiaFactor);
         Serial.printf("  Dist. Frenagem: %.3f graus/(grau/s)\n", learnedBrakingDist);
         Serial.printf("  Overshoot médio: %.3f graus\n", overshootAccumulator);
-        Serial.printf("  Ciclos: %d\n", learningCycles);
+        Serial.printf("  Ciclos: %d (CW %u, CCW %u)\n", learningCycles,
+                      brakingModels[0].getSamples(), brakingModels[1].getSamples());
     } else {
         Serial.println("Sem dados de aprendizado. Usando defaults.");
         learnedInertiaFactor = 1.0;
-        learnedBrakingDist = 0.1;
+        learnedBrakingDist = BRAKE_NOMINAL_DEG_PER_DPS;
         overshootAccumulator = 0.0;
         learningCycles = 0;
     }
+    
+    if (storage && storage->loadControlTuning(tuning)) {
+        Serial.printf("=== AJUSTE DO AUTOTUNE ===\n");
+        Serial.printf("  Kp %.3f  Ki %.4f  Kd %.3f  PWM PID %d..%d\n",
+                      tuning.kp, tuning.ki, tuning.kd, tuning.pidMinPWM, tuning.pidMaxPWM);
+        Serial.printf("  Atrito %d PWM, %.2f PWM/(grau/s), tau %.0f ms, atraso %.0f ms\n",
+                      tuning.ffStaticPWM, tuning.ffPwmPerDps, tuning.timeConstantS * 1000.0f, tuning.deadTimeS * 1000.0f);
+    }
 }
 
 void MotorController::saveLearnedParameters() {
     if (storage) {
+        BrakingModelState states[2];
+        brakingModels[0].save(states[0]);
+        brakingModels[1].save(states[1]);
+        storage->saveBrakingModels(states);
         storage->saveInertiaFactor(learnedInertiaFactor);
         storage->saveBrakingDistance(learnedBrakingDist);
         storage->saveOvershootHistory(overshootAccumulator);
         storage->saveLearningCycles(learningCycles);
-        Serial.println("Parâmetros de aprendizado salvos.");
     }
 }
 
-void MotorController::resetLearning() {
+bool MotorController::resetLearning(CommandSource source) {
+    return pushCommand(source, MOTOR_CMD_RESET_LEARNING, 0.0f);
+}
+
+// Na motorTask: o RLS e a tabela de setores nao sao zerados no meio de um
+// observeBraking()/observeBreakaway()
+void MotorController::applyResetLearning() {
+    commandsApplied++;
+    brakingModels[0].reset(BRAKE_NOMINAL_DEG_PER_DPS);
+    brakingModels[1].reset(BRAKE_NOMINAL_DEG_PER_DPS);
+    brakeObserving = false;
+    sectorDynamics.reset();
+    breakawayObserving = false;
+    saveSectorTable();
     learnedInertiaFactor = 1.0;
-    learnedBrakingDist = 0.1;
+    learnedBrakingDist = BRAKE_NOMINAL_DEG_PER_DPS;
     overshootAccumulator = 0.0;
     overshootSamples = 0;
     learningCycles = 0;
     saveLearnedParameters();
-    Serial.println("Aprendizado resetado!");
+    LOG_INFO("Aprendizado resetado!");
 }
 
 float MotorController::getInertiaFactor() {
@@ -699,107 +1118,309 @@ int MotorController::getLearningCycles() {
     return learningCycles;
 }
 
-float MotorController::predictBrakingDistance(float velocity) {
-    // Previsão baseada no aprendizado:
-    // distância = velocidade * fator_frenagem * fator_inércia
-    // 
-    // O fator_frenagem (learnedBrakingDist) representa quantos graus 
-    // o motor percorre durante a frenagem para cada grau/segundo de velocidade.
-    //
-    // O fator_inércia (learnedInertiaFactor) ajusta para motores mais pesados.
-    
-    float absVel = fabs(velocity);
-    float predictedDist = absVel * learnedBrakingDist * learnedInertiaFactor;
-    
-    // Adicionar compensação baseada no overshoot histórico
-    if (overshootAccumulator > 0 && learningCycles > 5) {
-        // Se temos histórico de overshoot, compensar mais
-        predictedDist += overshootAccumulator * 0.5;
+void MotorController::writeBrakingJSON(JsonObject out) {
+    // Leitura de outra task sem lock: valores so para exibicao (podem misturar duas amostras)
+    brakingModels[0].writeJSON(out.createNestedObject("cw"));
+    brakingModels[1].writeJSON(out.createNestedObject("ccw"));
+    out["inertiaFactor"] = learnedInertiaFactor;
+    out["brakingDist"] = learnedBrakingDist;
+    out["earlyBrakes"] = counters.earlyBrakes;
+}
+
+void MotorController::writeObserverJSON(JsonObject out) {
+    out["enabled"] = (bool)OBSERVER_ENABLED;
+    observer.writeJSON(out);
+    // Diferenca para o angulo filtrado (display): o atraso que o controle deixou de ter
+    out["filteredLagDeg"] = observer.getPosition() - encoder->getRawAngle();
+}
+
+void MotorController::writeSectorJSON(JsonObject out) {
+    sectorDynamics.writeJSON(out);   // Leitura sem lock, so para exibicao
+}
+
+// ==================================================================================
+// AUTOTUNE (resposta ao degrau, ver autotune.h)
+// ==================================================================================
+
+bool MotorController::startAutotune(CommandSource source) {
+    clearTrajectory();
+    return pushCommand(source, MOTOR_CMD_AUTOTUNE, 0.0f);
+}
+
+bool MotorController::resetTuning(CommandSource source) {
+    return pushCommand(source, MOTOR_CMD_TUNING_DEFAULTS, 0.0f);
+}
+
+ControlTuning MotorController::getTuning() {
+    return tuning;  // Copia (somente a motorTask escreve; leitura para exibicao)
+}
+
+void MotorController::writeAutotuneJSON(JsonObject out) {
+    autotuner.writeJSON(out);
+    ControlTuning t = tuning;
+    JsonObject current = out.createNestedObject("tuning");
+    current["source"] = t.autotuned ? "autotune" : "config";
+    current["kp"] = t.kp;
+    current["ki"] = t.ki;
+    current["kd"] = t.kd;
+    current["pidMinPWM"] = t.pidMinPWM;
+    current["pidMaxPWM"] = t.pidMaxPWM;
+    current["frictionPWM"] = t.ffStaticPWM;
+    current["pwmPerDps"] = t.ffPwmPerDps;
+    current["timeConstantMs"] = t.timeConstantS * 1000.0f;
+    current["deadTimeMs"] = t.deadTimeS * 1000.0f;
+}
+
+void MotorController::applyAutotune() {
+    commandsApplied++;
+    isMoving = false;
+    isManualMode = false;
+    trajectoryActive = false;
+    profileActive = false;
+    targetPWM = 0;
+    targetDirection = MOTOR_STOP;
+    setPWM(0, MOTOR_STOP);
+    currentPWM = 0;
+    if (!autotuner.start(absolutePosition, micros())) {
+        LOG_WARN("Autotune: sem espaco ate o limite do cabo (abs %.1f)", absolutePosition);
+        return;
     }
-    
-    return predictedDist;
+    #if TRACE_ENABLED
+    traceRecorder.onMoveStarted();
+    #endif
+    LOG_INFO("Autotune iniciado em abs %.1f", absolutePosition);
 }
 
-void MotorController::recordApproachData(float currentAngle, float velocity) {
-    // Chamado quando começamos a desacelerar para o alvo
-    if (!isLearningApproach) {
-        approachStartAngle = currentAngle;
-        approachStartVel = velocity;
-        approachStartTime = millis();
-        isLearningApproach = true;
+void MotorController::applyTuningDefaults() {
+    commandsApplied++;
+    tuning = defaultControlTuning();
+    if (storage) storage->clearControlTuning();
+    LOG_INFO("Autotune: ganhos do config.h restaurados");
+}
+
+void MotorController::abortAutotune(const char* reason) {
+    if (!autotuner.isActive()) return;
+    autotuner.abort(reason);
+    LOG_WARN("Autotune abortado: %s", reason);
+}
+
+void MotorController::autotuneStep(unsigned long nowUs) {
+    traceZone = TRACE_ZONE_AUTOTUNE;
+    int command = autotuner.update(absolutePosition, nowUs);
+    int pwm = constrain(abs(command), 0, PWM_MAX);
+    MotorDirection direction = command > 0 ? MOTOR_CW : command < 0 ? MOTOR_CCW : MOTOR_STOP;
+    
+    // Degraus aplicados direto (sem smoothAcceleration): o degrau e a medida
+    targetPWM = pwm;
+    targetDirection = direction;
+    currentPWM = pwm;
+    setPWM(pwm, direction);
+    
+    if (autotuner.isActive()) return;
+    
+    // Fim do experimento (uma vez): aplicar e persistir
+    targetPWM = 0;
+    currentPWM = 0;
+    setPWM(0, MOTOR_STOP);
+    ControlTuning result;
+    if (autotuner.computeTuning(result)) {
+        tuning = result;
+        if (storage) storage->saveControlTuning(result);
+        LOG_INFO("Autotune: Kp %.3f Ki %.4f Kd %.3f, PWM PID %d..%d",
+                 result.kp, result.ki, result.kd, result.pidMinPWM, result.pidMaxPWM);
+        LOG_INFO("Autotune: atrito %d PWM, %.2f PWM/(grau/s), tau %.0f ms, atraso %.0f ms",
+                 result.ffStaticPWM, result.ffPwmPerDps, result.timeConstantS * 1000.0f, result.deadTimeS * 1000.0f);
+    } else {
+        LOG_WARN("Autotune falhou: ganhos mantidos");
     }
 }
 
-void MotorController::analyzeOvershoot(float finalAngle) {
-    // Chamado quando o motor parou completamente
-    if (!isLearningApproach) return;
-    
-    isLearningApproach = false;
-    
-    // Calcular erro final (overshoot ou undershoot)
-    float errorFromTarget = calculateShortestPath(finalAngle, targetAngle);
-    float absError = fabs(errorFromTarget);
-    
-    // Se parou muito longe, não é um bom dado de aprendizado
-    if (absError > 5.0) {
+// ==================================================================================
+// MODELO DE FRENAGEM (RLS por sentido, ver braking_model.h)
+// ==================================================================================
+
+bool MotorController::predictBrakingDistance(float velocity, int pwm, float& distance) {
+    BrakingModel& model = brakingModels[velocity >= 0 ? 0 : 1];
+    distance = model.predict(velocity, pwm);
+    return model.isTrusted(velocity, pwm);
+}
+
+void MotorController::observeDynamics() {
+    unsigned long now = micros();
+    int previousPWM = lastAppliedPWM;
+    lastAppliedPWM = currentPWM;
+    observeBraking(previousPWM, now);
+    observeBreakaway(previousPWM, now);
+    
+    // Uma entrega ao storage por chegada/parada, nao por amostra (cada fim de pulso
+    // e uma frenagem): o write-behind grava no maximo um registro por movimento
+    if (learningDirty && !isMoving && !isManualMode && !trajectoryActive && !autotuner.isActive() &&
+        currentPWM == 0 && !brakeObserving && !breakawayObserving) {
+        learningDirty = false;
+        saveLearnedParameters();
+        saveSectorTable();
+    }
+}
+
+// Uma amostra por corte do PWM com o rotor andando (chegada, frenagem antecipada,
+// fim de pulso, manual solto, autotune): velocidade do encoder e PWM no corte,
+// distancia ate o rotor ficar BRAKE_STILL_MS parado
+void MotorController::observeBraking(int previousPWM, unsigned long now) {
+    if (!brakeObserving) {
+        float velocity = encoder->getVelocityDegPerSec();
+        if (previousPWM > 0 && currentPWM == 0 && fabs(velocity) >= BRAKE_RLS_MIN_VELOCITY_DPS) {
+            brakeObserving = true;
+            brakeModelIndex = velocity > 0 ? 0 : 1;
+            brakeStartVelocity = velocity;
+            brakeStartPWM = previousPWM;
+            brakeStartPosition = absolutePosition;
+            brakeLastPosition = absolutePosition;
+            brakeStartUs = now;
+            brakeStillSinceUs = now;
+        }
         return;
     }
     
-    // Calcular a distância percorrida durante a frenagem
-    float brakingDistance = fabs(calculateShortestPath(approachStartAngle, finalAngle));
-    float approachVel = fabs(approachStartVel);
-    
-    // Evitar divisão por zero
-    if (approachVel < 1.0) {
+    // PWM voltou antes de parar (proximo pulso, novo alvo): amostra incompleta
+    if (currentPWM > 0 || now - brakeStartUs > BRAKE_TIMEOUT_MS * 1000UL) {
+        brakeObserving = false;
         return;
     }
-    
-    // Calcular fator de frenagem desta amostra
-    float sampleBrakingFactor = brakingDistance / approachVel;
-    
-    // Determinar se houve overshoot (passou do alvo)
-    // Se o sinal do erro mudou, houve overshoot
-    float distToTarget = calculateShortestPath(approachStartAngle, targetAngle);
-    bool wasOvershoot = (errorFromTarget * distToTarget) < 0;
-    
-    // Atualizar aprendizado com média móvel exponencial
-    float alpha = 0.2;  // Taxa de aprendizado (20% da nova amostra)
-    
-    // Atualizar fator de frenagem
-    learnedBrakingDist = (1.0 - alpha) * learnedBrakingDist + alpha * sampleBrakingFactor;
-    
-    // Atualizar fator de inércia baseado no overshoot
-    if (wasOvershoot) {
-        // Motor tem mais inércia que o esperado, aumentar fator
-        learnedInertiaFactor = (1.0 - alpha) * learnedInertiaFactor + alpha * (learnedInertiaFactor * 1.1);
-        overshootAccumulator = (1.0 - alpha) * overshootAccumulator + alpha * absError;
-    } else if (absError > ANGLE_TOLERANCE) {
-        // Motor parou antes (undershoot), diminuir fator levemente
-        learnedInertiaFactor = (1.0 - alpha) * learnedInertiaFactor + alpha * (learnedInertiaFactor * 0.95);
+    if (fabs(absolutePosition - brakeLastPosition) > BRAKE_STILL_DEG) {
+        brakeLastPosition = absolutePosition;
+        brakeStillSinceUs = now;
+        return;
     }
-    
-    // Limitar fatores para evitar valores extremos
-    learnedInertiaFactor = constrain(learnedInertiaFactor, 0.5, 3.0);
-    learnedBrakingDist = constrain(learnedBrakingDist, 0.01, 1.0);
-    
-    overshootSamples++;
+    if (now - brakeStillSinceUs < BRAKE_STILL_MS * 1000UL) return;
+    
+    brakeObserving = false;
+    float sign = brakeModelIndex == 0 ? 1.0f : -1.0f;
+    float distance = max((brakeLastPosition - brakeStartPosition) * sign, 0.0f);
+    BrakingModel& model = brakingModels[brakeModelIndex];
+    // O setor aprende o quanto esta frenagem desviou do modelo medio do sentido
+    float residual = distance - model.predict(brakeStartVelocity, brakeStartPWM);
+    sectorDynamics.learnBraking(brakeStartPosition, brakeModelIndex, residual);
+    model.update(brakeStartVelocity, brakeStartPWM, distance);
     learningCycles++;
+    updateLearnedFactors();
+    learningDirty = true;
+    LOG_DEBUG("Frenagem %s: %.1f graus/s, PWM %d -> %.3f graus (residuo %.3f)",
+              brakeModelIndex == 0 ? "CW" : "CCW", brakeStartVelocity, brakeStartPWM, distance,
+              distance - model.predict(brakeStartVelocity, brakeStartPWM));
+}
+
+// Partida com o rotor parado: PWM no instante em que saiu DYNAMICS_BREAKAWAY_DEG
+// do lugar. So e amostra quando ficou travado (DYNAMICS_STALL_MS) enquanto o PWM
+// subia (rampa/PI); partindo logo (degrau, pulso) o atraso da aceleracao domina
+// e sabe-se apenas que o atrito e menor, o que so corrige uma estimativa acima.
+// Sem sair do lugar em DYNAMICS_BREAKAWAY_TIMEOUT_MS o atrito e maior que o PWM
+// atual: amostra acima dele e nova janela, ate o piso aprendido vencer o setor
+void MotorController::observeBreakaway(int previousPWM, unsigned long now) {
+    if (!breakawayObserving) {
+        if (previousPWM == 0 && currentPWM > 0 && !brakeObserving &&
+            fabs(encoder->getVelocityDegPerSec()) < BRAKE_RLS_MIN_VELOCITY_DPS) {
+            breakawayObserving = true;
+            breakawayDirection = currentDirection == MOTOR_CCW ? 1 : 0;
+            breakawayStartPWM = currentPWM;
+            breakawayStartPosition = absolutePosition;
+            breakawayStartUs = now;
+        }
+        return;
+    }
     
-    // Salvar a cada 10 ciclos
-    if (learningCycles % 10 == 0) {
-        saveLearnedParameters();
+    if (currentPWM == 0) {
+        breakawayObserving = false;
+        return;
     }
+    float sign = breakawayDirection == 0 ? 1.0f : -1.0f;
+    if ((absolutePosition - breakawayStartPosition) * sign < DYNAMICS_BREAKAWAY_DEG) {
+        if (now - breakawayStartUs <= DYNAMICS_BREAKAWAY_TIMEOUT_MS * 1000UL) return;
+        int known = sectorDynamics.breakawayPWM(breakawayStartPosition, breakawayDirection);
+        int bound = min(max(known, currentPWM) + DYNAMICS_STALL_STEP_PWM, PWM_MAX);
+        sectorDynamics.learnBreakaway(breakawayStartPosition, breakawayDirection, bound);
+        learningDirty = true;
+        LOG_DEBUG("Travado %s em %.1f graus com PWM %d: partida >= %d", breakawayDirection == 0 ? "CW" : "CCW",
+                  breakawayStartPosition, currentPWM, bound);
+        breakawayStartPWM = currentPWM;
+        breakawayStartUs = now;
+        return;
+    }
+    
+    breakawayObserving = false;
+    bool stalled = currentPWM > breakawayStartPWM && now - breakawayStartUs >= DYNAMICS_STALL_MS * 1000UL;
+    int known = sectorDynamics.breakawayPWM(breakawayStartPosition, breakawayDirection);
+    if (!stalled && (known == 0 || currentPWM >= known)) return;
+    sectorDynamics.learnBreakaway(breakawayStartPosition, breakawayDirection, currentPWM);
+    learningDirty = true;
+    LOG_DEBUG("Partida %s em %.1f graus: PWM %d (%s)", breakawayDirection == 0 ? "CW" : "CCW",
+              breakawayStartPosition, currentPWM, stalled ? "travado" : "limite superior");
+}
+
+void MotorController::saveSectorTable() {
+    if (!storage) return;
+    SectorTableRecord table;
+    sectorDynamics.save(table);
+    storage->saveSectorTable(table);
+}
+
+// Valores de antes do modelo (telemetria, pulsos): previsao no ponto de referencia,
+// media dos sentidos convergidos; sem nenhum convergido ficam os atuais
+void MotorController::updateLearnedFactors() {
+    const float refVelocity = BRAKE_RLS_REFERENCE_DPS;
+    const float refPWM = PWM_MIN;
+    float sum = 0.0f;
+    int trusted = 0;
+    for (int i = 0; i < 2; i++) {
+        float velocity = i == 0 ? refVelocity : -refVelocity;
+        if (!brakingModels[i].isTrusted(velocity, refPWM)) continue;
+        sum += brakingModels[i].predict(velocity, refPWM) / refVelocity;
+        trusted++;
+    }
+    if (trusted == 0) return;
+    learnedBrakingDist = constrain(sum / trusted, 0.01f, 1.0f);
+    learnedInertiaFactor = constrain(learnedBrakingDist / BRAKE_NOMINAL_DEG_PER_DPS, 0.5f, 3.0f);
+}
+
+void MotorController::analyzeOvershoot(float finalAngle) {
+    // Chamado na chegada: passou do alvo no sentido em que vinha? (so diagnostico;
+    // o aprendizado e o modelo de frenagem)
+    float errorFromTarget = calculateShortestPath(finalAngle, targetAngle);
+    int motion = targetDirection == MOTOR_CW ? 1 : targetDirection == MOTOR_CCW ? -1 : 0;
+    float overshoot = (motion != 0 && errorFromTarget * motion < 0) ? fabs(errorFromTarget) : 0.0f;
+    overshootAccumulator = 0.8f * overshootAccumulator + 0.2f * overshoot;
+    overshootSamples++;
 }
 
 void MotorController::updateAbsolutePosition() {
-    // Obter ângulo bruto do encoder (0-360°)
-    float currentRaw = encoder->getRawAngle();
+    PROFILE_STAGE(PROFILE_STAGE_ABSOLUTE);
+    #if OBSERVER_ENABLED
+    // Observador: contagem bruta + PWM aplicado desde o ciclo anterior
+    unsigned long nowUs = micros();
+    float dt = (nowUs - observerLastUs) / 1000000.0f;
+    observerLastUs = nowUs;
+    if (dt <= 0.0f || dt > 0.05f) dt = CONTROL_LOOP_PERIOD_US / 1000000.0f;
+    int signedPWM = currentDirection == MOTOR_CW ? currentPWM : currentDirection == MOTOR_CCW ? -currentPWM : 0;
+    observer.update(encoder->countsToDegrees(encoder->getState().rawCount), signedPWM, dt, tuning);
+    controlRawAngle = observer.getPosition();
+    #else
+    controlRawAngle = encoder->getRawAngle();
+    #endif
+    float currentRaw = controlRawAngle;
+    
+    // Reset pedido por outra task: aplicado aqui para não competir com o acúmulo
+    if (absoluteResetPending) {
+        absolutePosition = absoluteResetValue;
+        absolutePositionInitialized = false;
+        limitExceeded = false;
+        limitExceededPositive = true;
+        absoluteResetPending = false;
+    }
     
     // Na primeira chamada, apenas inicializar
     if (!absolutePositionInitialized) {
         lastRawAngleForTracking = currentRaw;
         absolutePositionInitialized = true;
-        Serial.printf("Tracking absoluto inicializado: raw=%.1f | abs=%.1f\n", currentRaw, absolutePosition);
+        LOG_INFO("Tracking absoluto inicializado: raw=%.1f | abs=%.1f", currentRaw, absolutePosition);
         return;
     }
     
@@ -824,40 +1445,36 @@ void MotorController::updateAbsolutePosition() {
     // Verificar ultrapassagem de limite (alertar apenas uma vez)
     if (absolutePosition > 180.0) {
         if (!limitExceeded) {
-            Serial.printf("\n!!! ALERTA CRITICO !!!\n");
-            Serial.printf("Posicao absoluta %.1f ultrapassou +180 graus!\n", absolutePosition);
-            Serial.printf("Direcao: HORARIA (CW / Direita)\n");
-            Serial.printf("Cabo torcendo! Use botao 'Forcar Retorno' no site.\n\n");
+            counters.limitExcursionsCW++;
+            LOG_ERROR("!!! ALERTA CRITICO !!! Posicao absoluta %.1f ultrapassou +180 graus (HORARIA / CW)", absolutePosition);
+            LOG_ERROR("Cabo torcendo! Use botao 'Forcar Retorno' no site.");
             limitExceeded = true;
             limitExceededPositive = true;
         }
     } else if (absolutePosition < -180.0) {
         if (!limitExceeded) {
-            Serial.printf("\n!!! ALERTA CRITICO !!!\n");
-            Serial.printf("Posicao absoluta %.1f ultrapassou -180 graus!\n", absolutePosition);
-            Serial.printf("Direcao: ANTI-HORARIA (CCW / Esquerda)\n");
-            Serial.printf("Cabo torcendo! Use botao 'Forcar Retorno' no site.\n\n");
+            counters.limitExcursionsCCW++;
+            LOG_ERROR("!!! ALERTA CRITICO !!! Posicao absoluta %.1f ultrapassou -180 graus (ANTI-HORARIA / CCW)", absolutePosition);
+            LOG_ERROR("Cabo torcendo! Use botao 'Forcar Retorno' no site.");
             limitExceeded = true;
             limitExceededPositive = false;
         }
     } else {
         // Dentro do limite - resetar flag
         if (limitExceeded) {
-            Serial.println("Posicao absoluta voltou ao limite seguro.");
+            LOG_WARN("Posicao absoluta voltou ao limite seguro.");
             limitExceeded = false;
         }
     }
 }
 
 float MotorController::getAbsolutePosition() {
-    return absolutePosition;
+    return published.load().absolutePosition;
 }
 
 void MotorController::resetAbsolutePosition(float pos) {
-    absolutePosition = constrain(pos, -180.0, 180.0);
-    lastRawAngleForTracking = encoder->getRawAngle();
-    absolutePositionInitialized = false; // Forçar reinicialização no próximo update
-    limitExceeded = false;               // Resetar flag de alerta
-    limitExceededPositive = true;        // Resetar direção
-    Serial.printf("Posicao absoluta resetada para: %.1f (tracking reinicializara)\n", absolutePosition);
+    // Aplicado pela motorTask no próximo updateAbsolutePosition()
+    absoluteResetValue = constrain(pos, -180.0, 180.0);
+    absoluteResetPending = true;
+    LOG_INFO("Posicao absoluta resetada para: %.1f (tracking reinicializara)", absoluteResetValue);
 }
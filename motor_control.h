@@ -5,6 +5,13 @@
 #include "config.h"
 #include "encoder.h"
 #include "storage.h"
+#include "seqlock.h"
+#include "motion_profile.h"
+#include "spsc_queue.h"
+#include "trace_recorder.h"
+#include "braking_model.h"
+#include "sector_dynamics.h"
+#include "state_observer.h"
 
 enum MotorDirection {
     MOTOR_STOP,
@@ -12,6 +19,91 @@ enum MotorDirection {
     MOTOR_CCW
 };
 
+// Flags do estado publicado
+#define MOTOR_FLAG_MOVING          0x01  // Modo automatico ativo (indo para alvo)
+#define MOTOR_FLAG_MANUAL          0x02  // Modo manual ativo
+#define MOTOR_FLAG_IN_MOTION       0x04  // Moving || manual || PWM > 0
+#define MOTOR_FLAG_LIMIT_EXCEEDED  0x08  // Posicao absoluta fora de ±180°
+#define MOTOR_FLAG_INVERTED        0x10  // Inversao runtime do motor
+#define MOTOR_FLAG_TRAJECTORY      0x20  // Seguindo fila de waypoints
+#define MOTOR_FLAG_AUTOTUNE        0x40  // Experimento de autotune em andamento
+
+// Ponto da trajetoria: instante em millis() e azimute (±180°, referencial absoluto)
+struct TrajectoryWaypoint {
+    uint32_t timeMs;
+    float azimuth;
+};
+
+// ==================================================================================
+// COMANDOS (filas sem bloqueio drenadas pela motorTask)
+// ==================================================================================
+// Cada task produtora tem sua propria fila SPSC: o handler so copia 8 bytes e
+// volta; o planejamento (caminho curto, protecao do cabo) roda na motorTask,
+// unica dona do estado de controle.
+enum CommandSource {
+    COMMAND_SOURCE_NETWORK,        // async_tcp: HTTP, WebSocket, rotctld, GS-232 TCP
+    COMMAND_SOURCE_LOOP,           // setup()/loop(): alvo restaurado, GS-232 serial
+    COMMAND_SOURCE_TRACKER,        // Task SatTrack
+    COMMAND_SOURCE_BENCH,          // Task SimBench (PLANT_SIMULATION)
+    COMMAND_SOURCE_COUNT
+};
+
+enum MotorCommandType : uint8_t {
+    MOTOR_CMD_MOVE,                // value = azimute (±180°)
+    MOTOR_CMD_MANUAL,              // value = sentido (+1 CW, -1 CCW, 0 solta)
+    MOTOR_CMD_TRAJECTORY,          // Ativa a fila de waypoints ja carregada
+    MOTOR_CMD_AUTOTUNE,            // Inicia o experimento de autotune
+    MOTOR_CMD_TUNING_DEFAULTS,     // Volta aos ganhos do config.h
+    MOTOR_CMD_RESET_LEARNING       // Zera modelos de frenagem e aprendizado
+};
+
+struct MotorCommand {
+    MotorCommandType type;
+    float value;
+};
+
+// Parada nao passa pela fila: contador + marca da fila (ver stop())
+struct MotorCommandQueue {
+    SpscQueue<MotorCommand, MOTOR_COMMAND_QUEUE_SIZE> ring;
+    std::atomic<uint32_t> stopRequests{0};
+    std::atomic<uint32_t> stopMark{0};     // Posicao da fila no momento do stop
+    uint32_t stopsHandled = 0;             // Somente a motorTask
+};
+
+struct MotorCommandStats {
+    uint32_t applied;              // Comandos executados pela motorTask
+    uint32_t coalesced;            // Alvos substituidos por um mais novo no mesmo dreno
+    uint32_t discardedByStop;      // Comandos enfileirados antes de um stop
+    uint32_t stops;
+    uint32_t dropped;              // Fila cheia
+    uint32_t pending;
+};
+
+// Contadores de operacao (somente a motorTask escreve; exportados em /metrics)
+struct MotorCounters {
+    uint32_t movesStarted;         // Alvos ponto a ponto aplicados
+    uint32_t arrivalsTolerance;    // Chegada pela checagem de ANGLE_TOLERANCE
+    uint32_t arrivalsDeadband;     // Chegada pela banda morta de 0.3° da zona de pulsos
+    uint32_t trajectoriesStarted;
+    uint32_t limitExcursionsCW;    // Posicao absoluta passou de +180°
+    uint32_t limitExcursionsCCW;   // Posicao absoluta passou de -180°
+    uint32_t earlyBrakes;          // Cortes antecipados pelo modelo de frenagem (zona PID)
+};
+
+// Estado publicado pela motorTask a cada ciclo (leitura sem bloqueio, ver seqlock.h)
+struct MotorState {
+    float angle;                   // Angulo calibrado (±180°)
+    float rawAngle;                // Angulo acumulado do encoder (sem offset)
+    float velocityDegPerSec;
+    float targetAngle;             // Alvo no referencial acumulado do encoder
+    float targetAbsolutePosition;
+    float absolutePosition;
+    int16_t currentPWM;
+    int16_t targetPWM;
+    uint8_t flags;
+    uint32_t cycle;                // Contador de publicacoes
+};
+
 class MotorController {
 private:
     uint8_t pinRPWM;
@@ -29,70 +121,172 @@ private:
     Encoder* encoder;
     StorageManager* storage;  // Para persistir aprendizado
     
+    // Estado de controle: escrito apenas pela motorTask (comandos chegam pelas filas)
     float targetAngle;
     float targetAbsolutePosition;  // Novo: posição absoluta desejada (±180°)
     bool isMoving;           // Modo automatico (ir para angulo)
     bool isManualMode;       // Modo manual (esquerda/direita)
-    unsigned long lastUpdateTime;
-    unsigned long lastAccelTime;  // Tempo para suavizacao
+    unsigned long lastUpdateTime; // us (micros)
+    unsigned long lastAccelTime;  // Tempo para suavizacao (us)
     
-    bool runtimeInvert = false;  // Inversao runtime
-    int speedPercent = 100;      // Velocidade 20-100%
+    volatile bool runtimeInvert = false;  // Inversao runtime
+    volatile int speedPercent = 100;      // Velocidade 20-100%
     
     // Variaveis PID para controle preciso
     float pidIntegral = 0.0;     // Acumulador integral
     float pidLastError = 0.0;    // Erro anterior para derivada
-    unsigned long pidLastTime = 0;
+    unsigned long pidLastTime = 0; // us
 
-    // Estimativa de velocidade
-    float lastAngleDeg = 0.0;
-    float velDegPerSec = 0.0;
-    
     // ==================================================================================
     // PROTEÇÃO CONTRA TORÇÃO DO CABO (±180° absoluto)
     // ==================================================================================
     float absolutePosition = 0.0;        // Posição absoluta acumulada (±180° limite)
     float lastRawAngleForTracking = 0.0; // Último ângulo raw para detectar voltas
+    
+    // Angulo de controle (referencial da contagem, sem offset): saida do observador,
+    // ou o filtrado do encoder com OBSERVER_ENABLED false
+    StateObserver observer;
+    float controlRawAngle = 0.0;
+    unsigned long observerLastUs = 0;
     bool absolutePositionInitialized = false; // Flag: tracking inicializado?
     bool limitExceeded = false;          // Flag: limite ultrapassado? (evita spam de alertas)
     bool limitExceededPositive = true;   // true = ultrapassou +180°, false = -180°
+    volatile bool absoluteResetPending = false; // resetAbsolutePosition() aguardando a motorTask
+    volatile float absoluteResetValue = 0.0;
     
     // ==================================================================================
-    // SISTEMA DE APRENDIZADO ADAPTATIVO
+    // SISTEMA DE APRENDIZADO ADAPTATIVO (modelo de frenagem RLS, ver braking_model.h)
     // ==================================================================================
-    float learnedInertiaFactor = 1.0;    // Fator de inércia (1.0 = neutro)
-    float learnedBrakingDist = 0.1;      // Graus de frenagem por grau/s de velocidade
-    float overshootAccumulator = 0.0;    // Acumulador de overshoots
+    BrakingModel brakingModels[2];       // [0] = CW, [1] = CCW
+    float learnedInertiaFactor = 1.0;    // Derivado do modelo (1.0 = nominal; pulsos)
+    float learnedBrakingDist = BRAKE_NOMINAL_DEG_PER_DPS;  // Graus por grau/s no ponto de referencia
+    float overshootAccumulator = 0.0;    // Media de overshoots na chegada (diagnostico)
     int overshootSamples = 0;            // Número de amostras
-    int learningCycles = 0;              // Total de ciclos aprendidos
+    int learningCycles = 0;              // Total de frenagens aprendidas
+    
+    // Frenagem em observacao: do corte do PWM ate o rotor parar
+    bool brakeObserving = false;
+    int brakeModelIndex = 0;
+    float brakeStartVelocity = 0.0;      // Velocidade do encoder no corte
+    int brakeStartPWM = 0;               // PWM aplicado antes do corte
+    float brakeStartPosition = 0.0;      // absolutePosition no corte
+    float brakeLastPosition = 0.0;
+    unsigned long brakeStartUs = 0;
+    unsigned long brakeStillSinceUs = 0;
+    int lastAppliedPWM = 0;              // currentPWM do ciclo anterior
+    bool learningDirty = false;          // Amostras novas ainda nao entregues ao storage
     
-    // Estado de aprendizado (para medir overshoot)
-    float approachStartAngle = 0.0;      // Posição quando começou a desacelerar
-    float approachStartVel = 0.0;        // Velocidade quando começou a desacelerar
-    unsigned long approachStartTime = 0;
-    bool isLearningApproach = false;     // Flag: está medindo overshoot?
-    float lastStableAngle = 0.0;         // Última posição estável após parar
+    // Dinamica por setor de azimute e sentido (desvio da frenagem, atrito de partida)
+    SectorDynamics sectorDynamics;
+    bool breakawayObserving = false;     // Partida do rotor parado em observacao
+    int breakawayDirection = 0;          // 0 = CW, 1 = CCW
+    int breakawayStartPWM = 0;
+    float breakawayStartPosition = 0.0;
+    unsigned long breakawayStartUs = 0;
     
-    SemaphoreHandle_t mutex;
+    // Ganhos do PID e modelo do feedforward (config.h ou autotune; somente a motorTask)
+    ControlTuning tuning = defaultControlTuning();
+    Autotuner autotuner;
+    
+    // Diagnostico da zona de pulsos
+    uint32_t pulseCycleCount = 0;        // Total de pulsos ON emitidos
+    bool pulsePhaseOn = false;           // Fase atual do gerador de pulsos
+    
+    // Gravador de trace: ramo do controle no ultimo ciclo
+    TraceZone traceZone = TRACE_ZONE_IDLE;
+    bool traceControlRan = false;        // Lei de controle rodou neste ciclo
+    
+    // ==================================================================================
+    // TRAJETORIA (waypoints + feedforward de velocidade)
+    // ==================================================================================
+    // Fila escrita por qualquer task (trajMux) e consumida pela motorTask
+    portMUX_TYPE trajMux = portMUX_INITIALIZER_UNLOCKED;
+    TrajectoryWaypoint trajPoints[TRAJECTORY_MAX_WAYPOINTS];
+    uint8_t trajHead = 0;
+    uint8_t trajCount = 0;
+    bool trajectoryActive = false;
+    float trajRefPosition = 0.0;         // Ultima referencia interpolada (diagnostico)
+    float trajRefVelocity = 0.0;
+    
+    // Perfil curva S dos movimentos ponto a ponto longos (somente a motorTask)
+    MotionProfile profile;
+    bool profileActive = false;
+    float profileTarget = 0.0;           // Alvo absoluto para o qual o perfil foi planejado
+    unsigned long profileStartUs = 0;
+    
+    // Filas de comandos (uma por task produtora)
+    MotorCommandQueue commandQueues[COMMAND_SOURCE_COUNT];
+    uint32_t commandsApplied = 0;
+    uint32_t commandsCoalesced = 0;
+    uint32_t commandsDiscarded = 0;
+    uint32_t stopsApplied = 0;
+    MotorCounters counters = {};
+    
+    // Estado publicado (leitura sem bloqueio pelas outras tasks)
+    SeqLock<MotorState> published;
+    uint32_t publishCycle = 0;
 
+    void controlStep();
+    void drainCommands();
+    void applyCommand(const MotorCommand& command);
+    void applyMove(float angle);
+    void applyManual(int speed);
+    void applyStop();
+    void applyTrajectory();
+    void applyAutotune();
+    void applyTuningDefaults();
+    void applyResetLearning();
+    void abortAutotune(const char* reason);
+    void autotuneStep(unsigned long nowUs);
+    bool pushCommand(CommandSource source, MotorCommandType type, float value);
+    void publishState();
+    void recordTrace();
     void setPWM(int pwm, MotorDirection direction);
     void smoothAcceleration();
     float calculateShortestPath(float current, float target);
     int calculatePID(float error, float dt);
-    float predictBrakingDistance(float velocity);  // Previsão de frenagem baseada em aprendizado
-    void recordApproachData(float currentAngle, float velocity);  // Gravar dados de aproximação
-    void analyzeOvershoot(float finalAngle);  // Analisar overshoot e atualizar aprendizado
+    // Distancia de frenagem prevista se o PWM for cortado agora; false = modelo nao confiavel
+    bool predictBrakingDistance(float velocity, int pwm, float& distance);
+    void observeDynamics();                   // Frenagens e partidas observadas (todo ciclo)
+    void observeBraking(int previousPWM, unsigned long nowUs);
+    void observeBreakaway(int previousPWM, unsigned long nowUs);
+    void saveSectorTable();
+    void updateLearnedFactors();              // Inercia/frenagem exibidas a partir do modelo
+    void analyzeOvershoot(float finalAngle);  // Overshoot na chegada (diagnostico)
+    bool sampleTrajectory(uint32_t nowMs, float& position, float& velocity);
+    void trajectoryStep(float dt, float currentAngle, int maxPWM);
+    void followReference(float refPosition, float refVelocity, float refAccel, float dt, int maxPWM);
+    void startProfile(float target, int maxPWM, unsigned long nowUs);
+    void clearTrajectory();
     
 public:
     MotorController(Encoder* enc, StorageManager* store);
     void begin();
-    void moveToAngle(float angle);
-    void stop();
+    // Comandos: O(1), sem lock; executados no proximo ciclo da motorTask.
+    // Alvos consecutivos da mesma fila viram so o ultimo; stop tem prioridade e
+    // descarta o que a mesma origem enfileirou antes dele. false = fila cheia
+    bool moveToAngle(float angle, CommandSource source);
+    void stop(CommandSource source);
+    bool manualMove(int speed, CommandSource source);
     void update();
-    void manualMove(int speed);
     bool isInMotion();
     float getTargetAngle();
+    float getTargetAbsolutePosition();
     bool hasReachedTarget();
+    uint32_t getPulseCycleCount();          // Ciclos ON da zona de pulsos (benchmark)
+    MotorState getState();                  // Snapshot completo sem bloqueio
+    
+    // Trajetoria: waypoints com tempo crescente; append=false substitui a fila.
+    // Retorna quantos pontos entraram (para no primeiro que cruzaria o ponto de ±180°)
+    int loadTrajectory(const TrajectoryWaypoint* points, int count, bool append, CommandSource source);
+    int getTrajectoryDepth();
+    float getTrajectoryReference();
+    
+    // Diagnostico de contencao
+    MotorCommandStats getCommandStats();
+    uint32_t getCommandsApplied();
+    MotorCounters getCounters();
+    uint32_t getSnapshotRetries();
     
     // Proteção contra torção do cabo
     void updateAbsolutePosition();          // Atualizar posição absoluta rastreada
@@ -110,10 +304,20 @@ public:
     // Sistema de Aprendizado
     void loadLearnedParameters();           // Carregar parâmetros do storage
     void saveLearnedParameters();           // Salvar parâmetros no storage
-    void resetLearning();                   // Resetar aprendizado
+    bool resetLearning(CommandSource source); // Resetar aprendizado (na motorTask)
     float getInertiaFactor();               // Obter fator de inércia atual
     float getBrakingDistance();             // Obter distância de frenagem aprendida
     int getLearningCycles();                // Quantos ciclos já aprendeu
+    void writeBrakingJSON(JsonObject out);  // Modelo por sentido com incerteza
+    void writeSectorJSON(JsonObject out);   // Tabela de dinamica por setor
+    void writeObserverJSON(JsonObject out); // Observador: estimativa x angulo filtrado
+    
+    // Autotune: experimento de resposta ao degrau nos dois sentidos (~10 s, ate
+    // AUTOTUNE_MAX_TRAVEL_DEG por sentido). Qualquer outro comando aborta
+    bool startAutotune(CommandSource source);
+    bool resetTuning(CommandSource source);
+    ControlTuning getTuning();
+    void writeAutotuneJSON(JsonObject out);
 };
 
 #endif
@@ -0,0 +1,125 @@
+#include "plant_simulator.h"
+#include "config.h"
+
+PlantSimulator plantSimulator;
+
+PlantSimulator::PlantSimulator() {
+    pulsesPerDegree = (ENCODER_PPR * GEAR_RATIO) / 360.0;
+}
+
+void PlantSimulator::reset() {
+    portENTER_CRITICAL(&mux);
+    positionPulses = 0.0;
+    velocityPulsesPerSec = 0.0f;
+    drivePWM = 0;
+    windPWM = 0.0f;
+    lastStepMicros = micros();
+    edgeCount = 0;
+    edgeMicros = lastStepMicros;
+    portEXIT_CRITICAL(&mux);
+}
+
+// Integrar o modelo ate o instante atual (chamar com mux tomado)
+void PlantSimulator::step() {
+    unsigned long now = micros();
+    if (lastStepMicros == 0) {
+        lastStepMicros = now;
+        return;
+    }
+    float dt = (now - lastStepMicros) / 1000000.0f;
+    lastStepMicros = now;
+    if (dt <= 0.0f) return;
+    if (dt > 0.05f) dt = 0.05f; // Evitar saltos se a task ficou parada
+
+    // Engrenagem helicoidal auto-travante: vento so atua enquanto o motor gira,
+    // parado o sem-fim segura a antena
+    float effective = 0.0f;
+    if (drivePWM != 0) {
+        effective = drivePWM + windPWM;
+    }
+
+    // Trecho "pegajoso" (mancal, cabo): mais atrito so nessa faixa de azimute
+    float breakaway = SIM_BREAKAWAY_PWM;
+    if (SIM_STICKY_WIDTH_DEG > 0.0f) {
+        float heading = fmodf(positionPulses / pulsesPerDegree - SIM_STICKY_CENTER_DEG, 360.0f);
+        if (heading > 180.0f) heading -= 360.0f;
+        if (heading < -180.0f) heading += 360.0f;
+        if (fabs(heading) < SIM_STICKY_WIDTH_DEG / 2) breakaway += SIM_STICKY_EXTRA_PWM;
+    }
+
+    float targetVel = 0.0f;
+    float magnitude = fabs(effective) - breakaway;
+    if (magnitude > 0.0f) {
+        float maxVel = SIM_MAX_SPEED_DPS * pulsesPerDegree;
+        targetVel = (magnitude / (PWM_MAX - SIM_BREAKAWAY_PWM)) * maxVel;
+        if (effective < 0.0f) targetVel = -targetVel;
+    }
+
+    // Resposta de 1a ordem; frenagem ativa (EN alto, PWM baixo) e mais rapida
+    bool braking = (targetVel == 0.0f) || (fabs(targetVel) < fabs(velocityPulsesPerSec));
+    float tau = (braking ? SIM_BRAKE_TIME_CONSTANT_MS : SIM_TIME_CONSTANT_MS) / 1000.0f;
+    velocityPulsesPerSec += (targetVel - velocityPulsesPerSec) * (dt / (tau + dt));
+
+    positionPulses += velocityPulsesPerSec * dt;
+
+    // Cruzou uma borda neste passo: instante em que cruzou a ultima
+    long count = (long)positionPulses;
+    if (count != edgeCount) {
+        double edge = velocityPulsesPerSec > 0.0f ? floor(positionPulses) : ceil(positionPulses);
+        float lateS = velocityPulsesPerSec != 0.0f ? (positionPulses - edge) / velocityPulsesPerSec : 0.0f;
+        edgeMicros = now - (unsigned long)(constrain(lateS, 0.0f, dt) * 1000000.0f);
+        edgeTotal += labs(count - edgeCount);
+        edgeCount = count;
+    }
+}
+
+void PlantSimulator::setDrive(int signedPWM) {
+    portENTER_CRITICAL(&mux);
+    step();
+    drivePWM = signedPWM;
+    portEXIT_CRITICAL(&mux);
+}
+
+void PlantSimulator::setWind(float pwmEquivalent) {
+    portENTER_CRITICAL(&mux);
+    step();
+    windPWM = pwmEquivalent;
+    portEXIT_CRITICAL(&mux);
+}
+
+long PlantSimulator::getCount() {
+    portENTER_CRITICAL(&mux);
+    step();
+    long count = (long)positionPulses;
+    portEXIT_CRITICAL(&mux);
+
+    // Ruido de quantizacao/vibracao do encoder
+    #if SIM_ENCODER_NOISE_PULSES > 0
+    count += random(-SIM_ENCODER_NOISE_PULSES, SIM_ENCODER_NOISE_PULSES + 1);
+    #endif
+    return count;
+}
+
+void PlantSimulator::getEdge(long& count, unsigned long& timeUs, uint32_t& edges) {
+    portENTER_CRITICAL(&mux);
+    step();
+    count = edgeCount;
+    timeUs = edgeMicros;
+    edges = edgeTotal;
+    portEXIT_CRITICAL(&mux);
+}
+
+float PlantSimulator::getPositionDeg() {
+    portENTER_CRITICAL(&mux);
+    step();
+    float degrees = positionPulses / pulsesPerDegree;
+    portEXIT_CRITICAL(&mux);
+    return degrees;
+}
+
+float PlantSimulator::getVelocityDegPerSec() {
+    portENTER_CRITICAL(&mux);
+    float vel = velocityPulsesPerSec / pulsesPerDegree;
+    portEXIT_CRITICAL(&mux);
+    return vel;
+}
@@ -0,0 +1,47 @@
+#ifndef PLANT_SIMULATOR_H
+#define PLANT_SIMULATOR_H
+
+#include <Arduino.h>
+#include "config.h"
+
+// ==================================================================================
+// MODELO FISICO DA PLANTA (Motor Bosch + BTS7960 + Encoder em quadratura)
+// ==================================================================================
+// Substitui o hardware quando PLANT_SIMULATION = true:
+// - MotorController::setPWM() entrega o PWM com sinal do canal fisico (R = +, L = -)
+// - Encoder::update() le a contagem simulada no lugar do PCNT
+// Permite avaliar mudancas de sintonia (zonas, KP/KI/KD) em bancada, sem torre.
+class PlantSimulator {
+private:
+    portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    double positionPulses = 0.0;     // Posicao do eixo do encoder (pulsos, lado fisico)
+    float velocityPulsesPerSec = 0.0f;
+    int drivePWM = 0;                // PWM com sinal (+ = canal R, - = canal L)
+    float windPWM = 0.0f;            // Perturbacao externa equivalente em PWM
+    unsigned long lastStepMicros = 0;
+    float pulsesPerDegree;
+    
+    // Ultima borda do encoder (sem ruido), para a captura de bordas
+    long edgeCount = 0;
+    unsigned long edgeMicros = 0;
+    uint32_t edgeTotal = 0;
+
+    void step();
+
+public:
+    PlantSimulator();
+
+    void reset();
+    void setDrive(int signedPWM);
+    void setWind(float pwmEquivalent);
+    long getCount();
+    // Contagem e instante (interpolado no passo) da ultima borda, e total de bordas
+    void getEdge(long& count, unsigned long& timeUs, uint32_t& edges);
+    float getPositionDeg();          // Eixo do encoder sem ruido (lado fisico)
+    float getVelocityDegPerSec();
+};
+
+extern PlantSimulator plantSimulator;
+
+#endif
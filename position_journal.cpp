@@ -0,0 +1,296 @@
+#include "position_journal.h"
+#include "crc32.h"
+#include "deferred_log.h"
+#include <stddef.h>
+
+PositionJournal positionJournal;
+
+// Anel na RTC slow memory: nao e zerado no reset (lixo no power-on, filtrado pelo CRC)
+RTC_NOINIT_ATTR static JournalEntry rtcRing[JOURNAL_RTC_ENTRIES];
+
+#define SELFTEST_TRIALS 500
+#define SELFTEST_SLOTS 64
+
+uint32_t PositionJournal::entryCrc(const JournalEntry& entry) {
+    return crc32Ieee((const uint8_t*)&entry, offsetof(JournalEntry, crc));
+}
+
+bool PositionJournal::entryValid(const JournalEntry& entry) {
+    return entry.sequence != JOURNAL_ERASED_SEQUENCE && entry.crc == entryCrc(entry);
+}
+
+static bool entryErased(const JournalEntry& entry) {
+    const uint8_t* bytes = (const uint8_t*)&entry;
+    for (size_t i = 0; i < sizeof(JournalEntry); i++) {
+        if (bytes[i] != 0xFF) return false;
+    }
+    return true;
+}
+
+int PositionJournal::scanEntries(const JournalEntry* entries, int count,
+                                 JournalEntry& newest, bool& found, uint32_t& torn) {
+    int lastUsed = -1;
+    for (int i = 0; i < count; i++) {
+        if (entryErased(entries[i])) continue;
+        lastUsed = i;
+        if (!entryValid(entries[i])) {
+            torn++;
+            continue;
+        }
+        if (!found || entries[i].sequence > newest.sequence) {
+            newest = entries[i];
+            found = true;
+        }
+    }
+    return lastUsed;
+}
+
+// ==================================================================================
+// RECUPERACAO NO BOOT
+// ==================================================================================
+
+void PositionJournal::scanFlash(JournalEntry& newest, bool& found) {
+    // 1) Primeira entrada de cada setor: o setor mais novo e o de maior sequencia
+    int newestSector = -1;
+    uint32_t newestFirst = 0;
+    for (int s = 0; s < JOURNAL_FLASH_SECTORS; s++) {
+        JournalEntry first;
+        esp_partition_read(partition, s * JOURNAL_SECTOR_SIZE, &first, sizeof(first));
+        if (entryValid(first) && (newestSector < 0 || first.sequence > newestFirst)) {
+            newestSector = s;
+            newestFirst = first.sequence;
+        }
+    }
+
+    if (newestSector < 0) {
+        // Anel vazio (ou particao com outro conteudo): a primeira escrita apaga o setor 0
+        writeSector = JOURNAL_FLASH_SECTORS - 1;
+        writeSlot = JOURNAL_ENTRIES_PER_SECTOR;
+        return;
+    }
+
+    // 2) Varredura completa so desse setor, em blocos pequenos (pilha do setup)
+    JournalEntry chunk[16];
+    int lastUsed = -1;
+    for (int base = 0; base < (int)JOURNAL_ENTRIES_PER_SECTOR; base += 16) {
+        esp_partition_read(partition, newestSector * JOURNAL_SECTOR_SIZE + base * sizeof(JournalEntry),
+                           chunk, sizeof(chunk));
+        int used = scanEntries(chunk, 16, newest, found, tornEntries);
+        if (used >= 0) lastUsed = base + used;
+    }
+
+    writeSector = newestSector;
+    writeSlot = lastUsed + 1;      // Depois de uma entrada rasgada tambem (slot nao esta apagado)
+}
+
+bool PositionJournal::recover(JournalEntry& out) {
+    uint32_t start = micros();
+
+    JournalEntry newest;
+    bool found = false;
+    uint32_t rtcInvalid = 0;       // Lixo de power-on na RTC nao conta como escrita rasgada
+    scanEntries(rtcRing, JOURNAL_RTC_ENTRIES, newest, found, rtcInvalid);
+    if (found) recoveredFrom = "rtc";
+
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                         JOURNAL_PARTITION_LABEL);
+    if (partition && partition->size < JOURNAL_FLASH_SECTORS * JOURNAL_SECTOR_SIZE) {
+        partition = nullptr;
+    }
+    if (partition) {
+        JournalEntry flashNewest;
+        bool flashFound = false;
+        scanFlash(flashNewest, flashFound);
+        if (flashFound && (!found || flashNewest.sequence > newest.sequence)) {
+            newest = flashNewest;
+            found = true;
+            recoveredFrom = "flash";
+        }
+    } else {
+        Serial.printf("Journal: particao '%s' ausente, apenas RTC\n", JOURNAL_PARTITION_LABEL);
+    }
+
+    recoverScanUs = micros() - start;
+    recovered = found;
+    if (found) {
+        recoveredEntry = newest;
+        nextSequence = newest.sequence + 1;
+        lastRtcPosition = newest.absolutePosition;
+        lastFlashPosition = newest.absolutePosition;
+        out = newest;
+        Serial.printf("Journal: posicao %.2f (abs %.2f) recuperada da %s, seq %u, %u us\n",
+                      newest.angle, newest.absolutePosition, recoveredFrom,
+                      (unsigned)newest.sequence, (unsigned)recoverScanUs);
+    }
+    return found;
+}
+
+// ==================================================================================
+// ESCRITA
+// ==================================================================================
+
+bool PositionJournal::eraseSector(int sector) {
+    if (esp_partition_erase_range(partition, sector * JOURNAL_SECTOR_SIZE, JOURNAL_SECTOR_SIZE) != ESP_OK) {
+        LOG_ERROR("Journal: falha ao apagar setor %d", sector);
+        return false;
+    }
+    sectorErases++;
+    return true;
+}
+
+bool PositionJournal::writeFlash(const JournalEntry& entry) {
+    if (writeSlot >= (int)JOURNAL_ENTRIES_PER_SECTOR) {
+        int next = (writeSector + 1) % JOURNAL_FLASH_SECTORS;
+        if (!spareErased) {
+            // Setor seguinte ainda nao foi apagado com o motor parado
+            forcedErases++;
+            if (!eraseSector(next)) return false;
+        }
+        writeSector = next;
+        writeSlot = 0;
+        spareErased = false;
+    }
+
+    size_t offset = writeSector * JOURNAL_SECTOR_SIZE + writeSlot * sizeof(JournalEntry);
+    writeSlot++;  // Mesmo com falha: o slot pode ter ficado parcialmente gravado
+    if (esp_partition_write(partition, offset, &entry, sizeof(entry)) != ESP_OK) return false;
+    flashWrites++;
+    return true;
+}
+
+void PositionJournal::append(const MotorState& state, bool toFlash) {
+    JournalEntry entry;
+    entry.sequence = nextSequence++;
+    entry.absolutePosition = state.absolutePosition;
+    entry.angle = state.angle;
+    entry.crc = entryCrc(entry);
+
+    uint32_t start = micros();
+    rtcRing[entry.sequence % JOURNAL_RTC_ENTRIES] = entry;
+    rtcWrites++;
+    lastRtcPosition = entry.absolutePosition;
+
+    if (toFlash && writeFlash(entry)) {
+        lastFlashPosition = entry.absolutePosition;
+    }
+    uint32_t elapsed = micros() - start;
+    if (elapsed > maxWriteUs) maxWriteUs = elapsed;
+}
+
+void PositionJournal::begin(MotorController* motor) {
+    motorController = motor;
+    xTaskCreatePinnedToCore(taskEntry, "Journal", 3072, this, 2, &taskHandle, 1);
+    Serial.printf("Journal: %d Hz, RTC a cada %.2f°, flash a cada %.2f°%s\n",
+                  JOURNAL_RATE_HZ, JOURNAL_RTC_THRESHOLD_DEG, JOURNAL_FLASH_THRESHOLD_DEG,
+                  partition ? "" : " (flash desativada)");
+}
+
+void PositionJournal::taskEntry(void* param) {
+    static_cast<PositionJournal*>(param)->run();
+}
+
+void PositionJournal::run() {
+    // Deixar a motorTask aplicar a posicao restaurada antes da primeira amostra
+    vTaskDelay(pdMS_TO_TICKS(100));
+    if (!recovered) {
+        MotorState initial = motorController->getState();
+        lastRtcPosition = lastFlashPosition = initial.absolutePosition;
+        append(initial, partition != nullptr);
+    }
+
+    TickType_t lastWake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(1000 / JOURNAL_RATE_HZ));
+
+        MotorState state = motorController->getState();
+        bool moving = (state.flags & MOTOR_FLAG_IN_MOTION) != 0;
+        bool stopped = wasMoving && !moving;
+        wasMoving = moving;
+
+        // Na parada grava a posicao final mesmo abaixo do limiar
+        float rtcDelta = fabs(state.absolutePosition - lastRtcPosition);
+        float flashDelta = fabs(state.absolutePosition - lastFlashPosition);
+        bool rtcDue = rtcDelta >= JOURNAL_RTC_THRESHOLD_DEG || (stopped && rtcDelta > 0.0f);
+        bool flashDue = partition &&
+                        (flashDelta >= JOURNAL_FLASH_THRESHOLD_DEG || (stopped && flashDelta > 0.0f));
+        if (rtcDue || flashDue) append(state, flashDue);
+
+        // Apagar o proximo setor so com o motor parado (apagar trava a flash por dezenas de ms)
+        if (!moving && partition && !spareErased) {
+            spareErased = eraseSector((writeSector + 1) % JOURNAL_FLASH_SECTORS);
+        }
+    }
+}
+
+// ==================================================================================
+// DIAGNOSTICO
+// ==================================================================================
+
+void PositionJournal::writeStatsJSON(JsonObject out) {
+    out["recoveredFrom"] = recoveredFrom;
+    if (recovered) {
+        out["recoveredSequence"] = recoveredEntry.sequence;
+        out["recoveredAbsolutePosition"] = recoveredEntry.absolutePosition;
+    }
+    out["recoverScanUs"] = recoverScanUs;
+    out["tornEntries"] = tornEntries;
+    out["sequence"] = nextSequence - 1;
+    out["rtcWrites"] = rtcWrites;
+    out["flashEnabled"] = partition != nullptr;
+    out["flashWrites"] = flashWrites;
+    out["sectorErases"] = sectorErases;
+    out["forcedErases"] = forcedErases;
+    out["writeSector"] = writeSector;
+    out["writeSlot"] = writeSlot;
+    out["maxWriteUs"] = maxWriteUs;
+}
+
+bool PositionJournal::runSelfTest(JsonObject out) {
+    // Setor em RAM: N entradas boas e a N+1 cortada num byte aleatorio. Os bytes
+    // depois do corte ficam apagados (0xFF) e o byte do corte parcialmente
+    // programado (NOR so leva bits de 1 para 0; parte deles ainda nao foi).
+    static JournalEntry scratch[SELFTEST_SLOTS];
+    int passed = 0;
+    uint32_t tornDetected = 0;
+    uint32_t scanUs = 0;
+
+    for (int trial = 0; trial < SELFTEST_TRIALS; trial++) {
+        memset(scratch, 0xFF, sizeof(scratch));
+        int good = random(SELFTEST_SLOTS - 1);
+        uint32_t base = 1000 + trial * SELFTEST_SLOTS;
+        for (int i = 0; i <= good; i++) {
+            scratch[i].sequence = base + i;
+            scratch[i].absolutePosition = i * 1.5f;
+            scratch[i].angle = i * 1.5f;
+            scratch[i].crc = entryCrc(scratch[i]);
+        }
+
+        // Rasgar a ultima entrada
+        JournalEntry target = scratch[good];
+        memset(&scratch[good], 0xFF, sizeof(JournalEntry));
+        int cut = random(sizeof(JournalEntry) + 1);
+        uint8_t* dst = (uint8_t*)&scratch[good];
+        const uint8_t* src = (const uint8_t*)&target;
+        memcpy(dst, src, cut);
+        if (cut < (int)sizeof(JournalEntry)) {
+            dst[cut] = src[cut] | (uint8_t)random(256);
+        }
+        bool complete = memcmp(dst, src, sizeof(JournalEntry)) == 0;
+
+        JournalEntry newest = {};
+        bool found = false;
+        uint32_t start = micros();
+        scanEntries(scratch, SELFTEST_SLOTS, newest, found, tornDetected);
+        scanUs += micros() - start;
+
+        int expected = complete ? good : good - 1;
+        bool ok = (expected < 0) ? !found : (found && newest.sequence == base + expected);
+        if (ok) passed++;
+    }
+
+    out["trials"] = SELFTEST_TRIALS;
+    out["passed"] = passed;
+    out["tornDetected"] = tornDetected;
+    out["scanUsPerSector"] = (float)scanUs / SELFTEST_TRIALS * JOURNAL_ENTRIES_PER_SECTOR / SELFTEST_SLOTS;
+    return passed == SELFTEST_TRIALS;
+}
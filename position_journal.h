@@ -0,0 +1,87 @@
+#ifndef POSITION_JOURNAL_H
+#define POSITION_JOURNAL_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <esp_partition.h>
+#include "config.h"
+#include "motor_control.h"
+
+// ==================================================================================
+// JOURNAL DE POSICAO (resistente a queda de energia)
+// ==================================================================================
+// A NVS so recebe a posicao a cada 5 s e na parada; um brownout no meio do
+// movimento restaurava uma posicao absoluta velha e quebrava a protecao do cabo.
+// Aqui cada mudanca de posicao vira uma entrada de 16 bytes com numero de
+// sequencia e CRC, gravada so por append:
+//   - RTC slow memory (sobrevive a brownout/reset; some sem alimentacao)
+//   - anel de setores na flash (sobrevive a tudo; escrita sequencial, sem
+//     reescrever nada: setor so e apagado inteiro, de preferencia parado)
+// No boot vence a entrada valida de maior sequencia. Escrita rasgada pela queda
+// deixa CRC invalido (ou a palavra de sequencia ainda apagada) e e ignorada.
+
+#define JOURNAL_SECTOR_SIZE 4096
+#define JOURNAL_ENTRIES_PER_SECTOR (JOURNAL_SECTOR_SIZE / sizeof(JournalEntry))
+#define JOURNAL_ERASED_SEQUENCE 0xFFFFFFFF
+
+struct __attribute__((packed)) JournalEntry {
+    uint32_t sequence;             // 0xFFFFFFFF = slot apagado
+    float absolutePosition;        // Posicao absoluta (protecao do cabo)
+    float angle;                   // Angulo calibrado (restaura o offset do encoder)
+    uint32_t crc;                  // CRC32 dos 12 bytes anteriores
+};
+
+static_assert(sizeof(JournalEntry) == 16, "JournalEntry: layout gravado na flash");
+
+class PositionJournal {
+private:
+    MotorController* motorController = nullptr;
+    TaskHandle_t taskHandle = NULL;
+    const esp_partition_t* partition = nullptr;
+
+    uint32_t nextSequence = 1;
+    int writeSector = 0;               // Setor do anel onde vai a proxima entrada
+    int writeSlot = 0;
+    bool spareErased = false;          // Proximo setor do anel ja apagado
+    float lastRtcPosition = 0, lastFlashPosition = 0;
+    bool wasMoving = false;
+
+    // Recuperacao (boot)
+    bool recovered = false;
+    JournalEntry recoveredEntry;
+    const char* recoveredFrom = "none";
+    uint32_t recoverScanUs = 0;
+    uint32_t tornEntries = 0;
+
+    // Metricas
+    uint32_t rtcWrites = 0;
+    uint32_t flashWrites = 0;
+    uint32_t sectorErases = 0;
+    uint32_t forcedErases = 0;         // Setor apagado com o motor em movimento
+    uint32_t maxWriteUs = 0;
+
+    static void taskEntry(void* param);
+    void run();
+    void append(const MotorState& state, bool toFlash);
+    bool writeFlash(const JournalEntry& entry);
+    bool eraseSector(int sector);
+    void scanFlash(JournalEntry& newest, bool& found);
+
+public:
+    static uint32_t entryCrc(const JournalEntry& entry);
+    static bool entryValid(const JournalEntry& entry);
+    // Varre um trecho de entradas; atualiza a mais nova valida e conta rasgadas.
+    // Retorna o indice do ultimo slot nao apagado (-1 se todos apagados)
+    static int scanEntries(const JournalEntry* entries, int count,
+                           JournalEntry& newest, bool& found, uint32_t& torn);
+
+    bool recover(JournalEntry& out);   // Chamar no setup antes de restaurar a posicao
+    void begin(MotorController* motor);
+
+    void writeStatsJSON(JsonObject out);
+    bool runSelfTest(JsonObject out);  // Escritas rasgadas simuladas em RAM (true = todas detectadas)
+};
+
+extern PositionJournal positionJournal;
+
+#endif
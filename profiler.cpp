@@ -0,0 +1,94 @@
+#include "profiler.h"
+
+#if PROFILER_ENABLED
+
+CycleProfiler cycleProfiler;
+
+static const char* const STAGE_NAMES[PROFILE_STAGE_COUNT] = {
+    "cycle", "encoder", "absolutePosition", "commands", "control", "smoothAcceleration", "setPWM", "publishState", "trace"
+};
+
+CycleProfiler::CycleProfiler() {
+    memset(stats, 0, sizeof(stats));
+    memset(snapshot, 0, sizeof(snapshot));
+}
+
+// Log-linear: valores 0..3 diretos; acima, 4 faixas por potencia de 2
+uint8_t CycleProfiler::bucketIndex(uint32_t cycles) {
+    if (cycles < 4) return cycles;
+    int octave = 31 - __builtin_clz(cycles);
+    int sub = (cycles >> (octave - 2)) & 3;
+    int index = (octave - 1) * 4 + sub;
+    return index < PROFILE_BUCKETS ? index : PROFILE_BUCKETS - 1;
+}
+
+uint32_t CycleProfiler::bucketUpperBound(uint8_t index) {
+    if (index < 4) return index;
+    int octave = index / 4 + 1;
+    int sub = index % 4;
+    return ((5u + sub) << (octave - 2)) - 1;
+}
+
+uint32_t CycleProfiler::percentile(const ProfileStats& s, float fraction) {
+    if (s.count == 0) return 0;
+    uint32_t rank = (uint32_t)ceilf(s.count * fraction);
+    uint32_t seen = 0;
+    for (int i = 0; i < PROFILE_BUCKETS; i++) {
+        seen += s.buckets[i];
+        if (seen >= rank) return min(bucketUpperBound(i), s.maxCycles);
+    }
+    return s.maxCycles;
+}
+
+void CycleProfiler::record(ProfileStage stage, uint32_t cycles) {
+    ProfileStats& s = stats[stage];
+    if (s.count == 0 || cycles < s.minCycles) s.minCycles = cycles;
+    if (cycles > s.maxCycles) s.maxCycles = cycles;
+    s.sumCycles += cycles;
+    s.count++;
+    s.buckets[bucketIndex(cycles)]++;
+}
+
+void CycleProfiler::endCycle() {
+    if (resetPending) {
+        memset(stats, 0, sizeof(stats));
+        resetPending = false;
+    }
+    if (snapshotPending) {
+        memcpy(snapshot, stats, sizeof(snapshot));
+        snapshotPending = false;
+    }
+}
+
+void CycleProfiler::writeJSON(JsonObject out) {
+    // Pedir a copia e esperar a motorTask terminar o ciclo atual
+    snapshotPending = true;
+    for (int i = 0; i < 50 && snapshotPending; i++) vTaskDelay(pdMS_TO_TICKS(1));
+    bool fresh = !snapshotPending;
+
+    uint32_t mhz = ESP.getCpuFreqMHz();
+    uint32_t budgetCycles = CONTROL_LOOP_PERIOD_US * mhz;
+    out["cpuMHz"] = mhz;
+    out["periodUs"] = CONTROL_LOOP_PERIOD_US;
+    out["fresh"] = fresh;          // false = motorTask nao respondeu (dados do ultimo pedido)
+
+    JsonArray stages = out.createNestedArray("stages");
+    for (int i = 0; i < PROFILE_STAGE_COUNT; i++) {
+        const ProfileStats& s = snapshot[i];
+        JsonObject stage = stages.createNestedObject();
+        stage["name"] = STAGE_NAMES[i];
+        stage["count"] = s.count;
+        uint32_t avg = s.count > 0 ? (uint32_t)(s.sumCycles / s.count) : 0;
+        uint32_t p99 = percentile(s, 0.99f);
+        stage["minCycles"] = s.minCycles;
+        stage["avgCycles"] = avg;
+        stage["p99Cycles"] = p99;
+        stage["maxCycles"] = s.maxCycles;
+        stage["avgUs"] = (float)avg / mhz;
+        stage["p99Us"] = (float)p99 / mhz;
+        // Fracao do periodo de controle consumida em media
+        stage["budgetPct"] = budgetCycles > 0 ? 100.0f * avg / budgetCycles : 0.0f;
+    }
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// ==================================================================================
+// PROFILER DE CICLOS DO LOOP DE CONTROLE
+// ==================================================================================
+// Cada etapa da motorTask e cronometrada com o contador de ciclos da CPU
+// (CCOUNT). O tempo e exclusivo: o que uma etapa gasta chamando outra
+// (controlStep -> smoothAcceleration -> setPWM) conta so para a de dentro.
+// A excecao e PROFILE_STAGE_CYCLE, o ciclo inteiro.
+//
+// Cada etapa tem min/max/soma e um histograma log-linear de tamanho fixo
+// (4 faixas por oitava, erro <= 25% no p99), sem alocacao.
+// Com PROFILER_ENABLED false, PROFILE_STAGE() nao gera codigo.
+
+enum ProfileStage {
+    PROFILE_STAGE_CYCLE,           // Ciclo completo (encoder + motor)
+    PROFILE_STAGE_ENCODER,         // Encoder::update
+    PROFILE_STAGE_ABSOLUTE,        // updateAbsolutePosition
+    PROFILE_STAGE_COMMANDS,        // drainCommands (filas de comandos)
+    PROFILE_STAGE_CONTROL,         // controlStep: PID, zonas, perfil, trajetoria
+    PROFILE_STAGE_SMOOTH,          // smoothAcceleration
+    PROFILE_STAGE_PWM,             // setPWM (ledcWrite)
+    PROFILE_STAGE_PUBLISH,         // publishState (seqlock)
+    PROFILE_STAGE_TRACE,           // Amostra do gravador de trace
+    PROFILE_STAGE_COUNT
+};
+
+#define PROFILE_BUCKETS 100        // Ate ~2^26 ciclos (~280 ms a 240 MHz)
+
+#if PROFILER_ENABLED
+
+struct ProfileStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t sumCycles;
+    uint32_t buckets[PROFILE_BUCKETS];
+};
+
+class CycleProfiler {
+private:
+    // Escritos apenas pela motorTask
+    ProfileStats stats[PROFILE_STAGE_COUNT];
+    uint32_t childCycles = 0;      // Ciclos das etapas internas do escopo atual
+
+    // Copia pedida pelo servidor web e feita pela motorTask entre dois ciclos,
+    // para nao ler a soma de 64 bits no meio de uma escrita
+    ProfileStats snapshot[PROFILE_STAGE_COUNT];
+    volatile bool snapshotPending = false;
+    volatile bool resetPending = false;
+
+    static uint8_t bucketIndex(uint32_t cycles);
+    static uint32_t bucketUpperBound(uint8_t index);
+    static uint32_t percentile(const ProfileStats& s, float fraction);
+
+    friend class ProfileScope;
+    void record(ProfileStage stage, uint32_t cycles);
+
+public:
+    CycleProfiler();
+    void endCycle();               // Fim do ciclo da motorTask: atende snapshot/reset
+    void requestReset() { resetPending = true; }
+    void writeJSON(JsonObject out);
+};
+
+extern CycleProfiler cycleProfiler;
+
+class ProfileScope {
+private:
+    ProfileStage stage;
+    uint32_t start;
+    uint32_t outerChildCycles;
+
+public:
+    explicit ProfileScope(ProfileStage s) : stage(s) {
+        outerChildCycles = cycleProfiler.childCycles;
+        cycleProfiler.childCycles = 0;
+        start = ESP.getCycleCount();
+    }
+    ~ProfileScope() {
+        uint32_t total = ESP.getCycleCount() - start;
+        uint32_t self = total - cycleProfiler.childCycles;
+        cycleProfiler.record(stage, stage == PROFILE_STAGE_CYCLE ? total : self);
+        cycleProfiler.childCycles = outerChildCycles + total;
+    }
+};
+
+#define PROFILE_STAGE(stage) ProfileScope profileScope(stage)
+#define PROFILE_END_CYCLE() cycleProfiler.endCycle()
+
+#else
+
+#define PROFILE_STAGE(stage) do {} while (0)
+#define PROFILE_END_CYCLE() do {} while (0)
+
+#endif
+
+#endif
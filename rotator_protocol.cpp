@@ -0,0 +1,284 @@
+#include "rotator_protocol.h"
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdarg.h>
+
+volatile uint32_t RotatorProtocol::commandCount = 0;
+volatile uint32_t RotatorProtocol::errorCount = 0;
+
+// Palavras de duas letras do EasyComm II que decidem o protocolo da linha
+static const char* const EASYCOMM_WORDS[] = {
+    "AZ", "EL", "SA", "SE", "ML", "MR", "MU", "MD", "VE", "UP", "DN"
+};
+
+// snprintf limitado ao espaco restante (retorna o que de fato coube)
+static size_t appendf(char* out, size_t outSize, const char* fmt, ...) {
+    if (outSize == 0) return 0;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(out, outSize, fmt, args);
+    va_end(args);
+    if (n < 0) return 0;
+    return ((size_t)n < outSize) ? (size_t)n : outSize - 1;
+}
+
+static bool parseNumber(const char* text, float& value) {
+    while (*text == ' ') text++;
+    char* end;
+    value = strtof(text, &end);
+    if (end == text) return false;
+    while (*end == ' ') end++;
+    return *end == '\0';
+}
+
+void RotatorProtocol::begin(MotorController* motor, StorageManager* store, CommandSource source) {
+    motorController = motor;
+    storage = store;
+    commandSource = source;
+    reset();
+}
+
+void RotatorProtocol::reset() {
+    len = 0;
+    overflow = false;
+}
+
+size_t RotatorProtocol::feed(const char* data, size_t dataLen, char* out, size_t outSize) {
+    size_t written = 0;
+    for (size_t i = 0; i < dataLen; i++) {
+        char c = data[i];
+        if (c != '\r' && c != '\n') {
+            if (len < ROTATOR_LINE_MAX - 1) {
+                line[len++] = (char)toupper((unsigned char)c);
+            } else {
+                overflow = true;
+            }
+            continue;
+        }
+        // CR, LF ou CRLF: linhas vazias sao ignoradas
+        if (len == 0) continue;
+        line[len] = '\0';
+        if (overflow) {
+            errorCount++;
+        } else if (written < outSize) {
+            written += executeLine(out + written, outSize - written);
+        } else {
+            errorCount++;  // Sem espaco para a resposta
+        }
+        reset();
+    }
+    return written;
+}
+
+size_t RotatorProtocol::executeLine(char* out, size_t outSize) {
+    commandCount++;
+    if (isalpha((unsigned char)line[0]) && isalpha((unsigned char)line[1])) {
+        for (size_t i = 0; i < sizeof(EASYCOMM_WORDS) / sizeof(EASYCOMM_WORDS[0]); i++) {
+            if (line[0] == EASYCOMM_WORDS[i][0] && line[1] == EASYCOMM_WORDS[i][1]) {
+                return executeEasyComm(out, outSize);
+            }
+        }
+    }
+    return executeGS232(out, outSize);
+}
+
+float RotatorProtocol::currentAzimuth() {
+    float az = motorController->getState().angle;
+    if (az < 0) az += 360.0f;
+    return az;
+}
+
+void RotatorProtocol::moveTo(float azimuth) {
+    motorController->moveToAngle(azimuth, commandSource);  // Normaliza e aplica a protecao de cabo
+    storage->saveLastTarget(azimuth);
+}
+
+size_t RotatorProtocol::executeGS232(char* out, size_t outSize) {
+    const char* arg = line + 1;
+    float value;
+
+    switch (line[0]) {
+        case 'C': {
+            int az = (int)lroundf(currentAzimuth()) % 360;
+            bool withElevation = (arg[0] == '2');
+            #if GS232_VARIANT_B
+            return withElevation ? appendf(out, outSize, "AZ=%03d  EL=000\r", az)
+                                 : appendf(out, outSize, "AZ=%03d\r", az);
+            #else
+            return withElevation ? appendf(out, outSize, "+0%03d+0000\r", az)
+                                 : appendf(out, outSize, "+0%03d\r", az);
+            #endif
+        }
+        case 'B':
+            #if GS232_VARIANT_B
+            return appendf(out, outSize, "EL=000\r");
+            #else
+            return appendf(out, outSize, "+0000\r");
+            #endif
+        case 'M':
+            // Faixa do GS-232 inclui a sobreposicao (0-450°)
+            if (!parseNumber(arg, value) || value < 0 || value > 450) break;
+            moveTo(value);
+            return 0;
+        case 'W': {
+            // "Waaa eee": elevacao ignorada
+            char azText[8];
+            size_t n = 0;
+            while (arg[n] && arg[n] != ' ' && n < sizeof(azText) - 1) {
+                azText[n] = arg[n];
+                n++;
+            }
+            azText[n] = '\0';
+            if (!parseNumber(azText, value) || value < 0 || value > 450) break;
+            moveTo(value);
+            return 0;
+        }
+        case 'S':
+        case 'A':
+            motorController->stop(commandSource);
+            return 0;
+        case 'R':
+            motorController->manualMove(1, commandSource);
+            return 0;
+        case 'L':
+            motorController->manualMove(-1, commandSource);
+            return 0;
+        case 'X':
+            // X1..X4 = velocidade 1 (mais lenta) a 4 (maxima)
+            if (arg[0] < '1' || arg[0] > '4' || arg[1] != '\0') break;
+            motorController->setSpeedPercent((arg[0] - '0') * 25);
+            return 0;
+        case 'U':
+        case 'D':
+        case 'E':
+            return 0;  // Elevacao: sem eixo
+        default:
+            break;
+    }
+    errorCount++;
+    return appendf(out, outSize, "?>\r");
+}
+
+size_t RotatorProtocol::executeEasyComm(char* out, size_t outSize) {
+    size_t written = 0;
+    char* save;
+    float value;
+
+    for (char* word = strtok_r(line, " ", &save); word; word = strtok_r(nullptr, " ", &save)) {
+        const char* arg = word + 2;
+        // Consultas geram resposta; separadas por espaco na mesma linha
+        const char* sep = (written > 0) ? " " : "";
+
+        if (!strncmp(word, "AZ", 2)) {
+            if (*arg == '\0') {
+                written += appendf(out + written, outSize - written, "%sAZ%.1f", sep, currentAzimuth());
+            } else if (parseNumber(arg, value) && value >= 0 && value <= 360) {
+                moveTo(value);
+            } else {
+                errorCount++;
+            }
+        } else if (!strncmp(word, "EL", 2)) {
+            if (*arg == '\0') {
+                written += appendf(out + written, outSize - written, "%sEL0.0", sep);
+            }
+        } else if (!strcmp(word, "SA")) {
+            motorController->stop(commandSource);
+        } else if (!strcmp(word, "MR")) {
+            motorController->manualMove(1, commandSource);
+        } else if (!strcmp(word, "ML")) {
+            motorController->manualMove(-1, commandSource);
+        } else if (!strcmp(word, "VE")) {
+            written += appendf(out + written, outSize - written, "%sVE%s", sep, WIFI_HOSTNAME);
+        } else if (!strcmp(word, "SE") || !strcmp(word, "MU") || !strcmp(word, "MD") ||
+                   !strncmp(word, "UP", 2) || !strncmp(word, "DN", 2)) {
+            // Elevacao e comandos de radio: aceitos e ignorados
+        } else {
+            errorCount++;
+        }
+        if (written >= outSize - 1) break;
+    }
+
+    if (written > 0) written += appendf(out + written, outSize - written, "\n");
+    return written;
+}
+
+// ==================================================================================
+// TRANSPORTES
+// ==================================================================================
+
+RotatorProtocolServer::RotatorProtocolServer(MotorController* motor, StorageManager* store) {
+    motorController = motor;
+    storage = store;
+}
+
+void RotatorProtocolServer::begin() {
+    #if ROTATOR_SERIAL_ENABLED
+    serialProtocol.begin(motorController, storage, COMMAND_SOURCE_LOOP);  // pollSerial() roda no loop()
+    Serial.println("[GS-232] Protocolo GS-232/EasyComm ativo na porta serial");
+    #endif
+
+    #if ROTATOR_TCP_ENABLED
+    server = new AsyncServer(ROTATOR_TCP_PORT);
+    server->onClient([](void* arg, AsyncClient* client) {
+        static_cast<RotatorProtocolServer*>(arg)->onConnect(client);
+    }, this);
+    server->setNoDelay(true);
+    server->begin();
+    Serial.printf("[GS-232] Servidor GS-232/EasyComm na porta %d\n", ROTATOR_TCP_PORT);
+    #endif
+}
+
+void RotatorProtocolServer::onConnect(AsyncClient* client) {
+    RotatorTcpClient* slot = nullptr;
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < ROTATOR_TCP_MAX_CLIENTS; i++) {
+        if (clients[i].client == nullptr) {
+            slot = &clients[i];
+            slot->client = client;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&clientsMux);
+
+    client->onDisconnect([](void* arg, AsyncClient* c) {
+        static_cast<RotatorProtocolServer*>(arg)->onDisconnect(c);
+        delete c;
+    }, this);
+
+    if (!slot) {
+        Serial.println("[GS-232] Conexao recusada: limite de clientes");
+        client->close(true);
+        return;
+    }
+
+    slot->protocol.begin(motorController, storage, COMMAND_SOURCE_NETWORK);
+    client->setNoDelay(true);
+    client->onData([](void* arg, AsyncClient* c, void* data, size_t len) {
+        RotatorTcpClient* s = static_cast<RotatorTcpClient*>(arg);
+        char out[ROTATOR_RESPONSE_MAX * 4];
+        size_t n = s->protocol.feed(static_cast<const char*>(data), len, out, sizeof(out));
+        if (n > 0) c->write(out, n);
+    }, slot);
+}
+
+void RotatorProtocolServer::onDisconnect(AsyncClient* client) {
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < ROTATOR_TCP_MAX_CLIENTS; i++) {
+        if (clients[i].client == client) clients[i].client = nullptr;
+    }
+    portEXIT_CRITICAL(&clientsMux);
+}
+
+void RotatorProtocolServer::pollSerial() {
+    #if ROTATOR_SERIAL_ENABLED
+    char in[64];
+    char out[ROTATOR_RESPONSE_MAX * 4];
+    int available;
+    while ((available = ROTATOR_SERIAL.available()) > 0) {
+        size_t n = ROTATOR_SERIAL.readBytes(in, min((size_t)available, sizeof(in)));
+        size_t r = serialProtocol.feed(in, n, out, sizeof(out));
+        if (r > 0) ROTATOR_SERIAL.write((const uint8_t*)out, r);
+    }
+    #endif
+}
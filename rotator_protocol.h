@@ -0,0 +1,75 @@
+#ifndef ROTATOR_PROTOCOL_H
+#define ROTATOR_PROTOCOL_H
+
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include "config.h"
+#include "motor_control.h"
+#include "storage.h"
+
+// ==================================================================================
+// PROTOCOLOS GS-232A/B (Yaesu) E EASYCOMM II
+// ==================================================================================
+// Parser em fluxo: recebe bytes soltos (serial ou TCP), monta a linha num buffer
+// fixo e responde num buffer do chamador. Nao aloca e nao usa String.
+// O protocolo e detectado por linha (as palavras do EasyComm tem duas letras).
+//
+// GS-232:   C / C2 (posicao), Mxxx / Wxxx yyy (ir para), S / A (parar),
+//           R / L (girar CW/CCW), X1-X4 (velocidade 25-100%)
+// EasyComm: AZ / EL (consulta), AZxxx.x (ir para), SA / SE (parar),
+//           MR / ML (girar), VE (versao); varias palavras por linha
+// Rotor so de azimute: comandos de elevacao sao aceitos e ignorados.
+
+#define ROTATOR_LINE_MAX 64
+#define ROTATOR_RESPONSE_MAX 64
+
+class RotatorProtocol {
+private:
+    MotorController* motorController = nullptr;
+    StorageManager* storage = nullptr;
+    CommandSource commandSource = COMMAND_SOURCE_NETWORK;  // Fila da task que chama feed()
+    char line[ROTATOR_LINE_MAX];
+    uint8_t len = 0;
+    bool overflow = false;
+
+    size_t executeLine(char* out, size_t outSize);
+    size_t executeGS232(char* out, size_t outSize);
+    size_t executeEasyComm(char* out, size_t outSize);
+    void moveTo(float azimuth);
+    float currentAzimuth();
+
+public:
+    static volatile uint32_t commandCount;
+    static volatile uint32_t errorCount;
+
+    void begin(MotorController* motor, StorageManager* store, CommandSource source);
+    void reset();
+    // Consome 'data'; respostas de todas as linhas completas vao para 'out'
+    size_t feed(const char* data, size_t dataLen, char* out, size_t outSize);
+};
+
+// Transportes: porta serial (USB-CDC) e servidor TCP opcional
+struct RotatorTcpClient {
+    AsyncClient* client;                    // nullptr = slot livre
+    RotatorProtocol protocol;
+};
+
+class RotatorProtocolServer {
+private:
+    MotorController* motorController;
+    StorageManager* storage;
+    AsyncServer* server = nullptr;
+    RotatorTcpClient clients[ROTATOR_TCP_MAX_CLIENTS] = {};
+    portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+    RotatorProtocol serialProtocol;
+
+    void onConnect(AsyncClient* client);
+    void onDisconnect(AsyncClient* client);
+
+public:
+    RotatorProtocolServer(MotorController* motor, StorageManager* store);
+    void begin();
+    void pollSerial();                      // Chamado do loop()
+};
+
+#endif
@@ -0,0 +1,219 @@
+#include "rotctld_server.h"
+#include <string.h>
+#include <stdlib.h>
+
+RotctldServer::RotctldServer(MotorController* motor, StorageManager* store) {
+    motorController = motor;
+    storage = store;
+}
+
+void RotctldServer::begin() {
+    server = new AsyncServer(ROTCTLD_PORT);
+    server->onClient([](void* arg, AsyncClient* client) {
+        static_cast<RotctldServer*>(arg)->onConnect(client);
+    }, this);
+    server->setNoDelay(true);
+    server->begin();
+    Serial.printf("[rotctld] Servidor Hamlib na porta %d\n", ROTCTLD_PORT);
+}
+
+void RotctldServer::onConnect(AsyncClient* client) {
+    RotctldClient* slot = nullptr;
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < ROTCTLD_MAX_CLIENTS; i++) {
+        if (clients[i].client == nullptr) {
+            slot = &clients[i];
+            slot->client = client;
+            slot->owner = this;
+            slot->len = 0;
+            slot->overflow = false;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&clientsMux);
+
+    // O AsyncServer entrega o cliente alocado; quem libera e o onDisconnect
+    client->onDisconnect([](void* arg, AsyncClient* c) {
+        static_cast<RotctldServer*>(arg)->onDisconnect(c);
+        delete c;
+    }, this);
+
+    if (!slot) {
+        Serial.println("[rotctld] Conexao recusada: limite de clientes");
+        client->close(true);
+        return;
+    }
+
+    client->setNoDelay(true);
+    client->onData([](void* arg, AsyncClient* c, void* data, size_t len) {
+        RotctldClient* s = static_cast<RotctldClient*>(arg);
+        s->owner->onData(s, static_cast<const char*>(data), len);
+    }, slot);
+    Serial.printf("[rotctld] Cliente conectado (slot %d)\n", (int)(slot - clients));
+}
+
+void RotctldServer::onDisconnect(AsyncClient* client) {
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < ROTCTLD_MAX_CLIENTS; i++) {
+        if (clients[i].client == client) clients[i].client = nullptr;
+    }
+    portEXIT_CRITICAL(&clientsMux);
+}
+
+int RotctldServer::getClientCount() {
+    int count = 0;
+    for (int i = 0; i < ROTCTLD_MAX_CLIENTS; i++) {
+        if (clients[i].client != nullptr) count++;
+    }
+    return count;
+}
+
+void RotctldServer::onData(RotctldClient* slot, const char* data, size_t len) {
+    AsyncClient* client = slot->client;
+    if (!client) return;
+
+    char out[ROTCTLD_RESPONSE_MAX];
+    bool pending = false;
+
+    for (size_t i = 0; i < len; i++) {
+        char c = data[i];
+        if (c != '\n') {
+            if (slot->len < ROTCTLD_LINE_MAX - 1) {
+                slot->line[slot->len++] = c;
+            } else {
+                slot->overflow = true;
+            }
+            continue;
+        }
+
+        // Linha completa (aceita "\r\n")
+        if (slot->len > 0 && slot->line[slot->len - 1] == '\r') slot->len--;
+        slot->line[slot->len] = '\0';
+
+        bool quit = false;
+        int n;
+        if (slot->overflow) {
+            n = reply(out, sizeof(out), ROTCTLD_EINVAL);
+        } else {
+            n = execute(slot->line, out, sizeof(out), quit);
+        }
+        slot->len = 0;
+        slot->overflow = false;
+
+        if (quit) {
+            if (pending) client->send();
+            client->close();
+            return;
+        }
+        // Respostas de comandos em pipeline vao no mesmo segmento TCP
+        if (n > 0) {
+            if (client->add(out, n, ASYNC_WRITE_FLAG_COPY) < (size_t)n) errorCount++;
+            pending = true;
+        }
+    }
+    if (pending) client->send();
+}
+
+int RotctldServer::reply(char* out, size_t outSize, int code) {
+    if (code != ROTCTLD_OK) errorCount++;
+    return snprintf(out, outSize, "RPRT %d\n", code);
+}
+
+// Converte o argumento de azimute; aceita -180..360 (rotctld usa 0-360)
+static bool parseAzimuth(const char* token, float& az) {
+    if (!token) return false;
+    char* end;
+    az = strtof(token, &end);
+    if (end == token || *end != '\0') return false;
+    return az >= -180.0f && az <= 360.0f;
+}
+
+int RotctldServer::execute(char* line, char* out, size_t outSize, bool& quit) {
+    char* save;
+    char* cmd = strtok_r(line, " \t", &save);
+    if (!cmd) return 0;
+    commandCount++;
+
+    if (!strcmp(cmd, "p") || !strcmp(cmd, "\\get_pos")) {
+        float az = motorController->getState().angle;
+        if (az < 0) az += 360.0f;
+        return snprintf(out, outSize, "%f\n%f\n", az, 0.0f);
+    }
+
+    if (!strcmp(cmd, "P") || !strcmp(cmd, "\\set_pos")) {
+        float az;
+        if (!parseAzimuth(strtok_r(nullptr, " \t", &save), az)) {
+            return reply(out, outSize, ROTCTLD_EINVAL);
+        }
+        // Elevacao e ignorada (rotor so de azimute); a protecao de cabo decide a rota
+        motorController->moveToAngle(az, COMMAND_SOURCE_NETWORK);
+        storage->saveLastTarget(az);
+        return reply(out, outSize, ROTCTLD_OK);
+    }
+
+    if (!strcmp(cmd, "S") || !strcmp(cmd, "\\stop")) {
+        motorController->stop(COMMAND_SOURCE_NETWORK);
+        return reply(out, outSize, ROTCTLD_OK);
+    }
+
+    if (!strcmp(cmd, "K") || !strcmp(cmd, "\\park")) {
+        motorController->moveToAngle(0.0f, COMMAND_SOURCE_NETWORK);
+        storage->saveLastTarget(0.0f);
+        return reply(out, outSize, ROTCTLD_OK);
+    }
+
+    if (!strcmp(cmd, "M") || !strcmp(cmd, "\\move")) {
+        const char* dirToken = strtok_r(nullptr, " \t", &save);
+        int direction = dirToken ? atoi(dirToken) : 0;
+        // Velocidade do Hamlib ignorada: vale a velocidade configurada no painel
+        if (direction == ROTCTLD_MOVE_CW) {
+            motorController->manualMove(1, COMMAND_SOURCE_NETWORK);
+        } else if (direction == ROTCTLD_MOVE_CCW) {
+            motorController->manualMove(-1, COMMAND_SOURCE_NETWORK);
+        } else {
+            return reply(out, outSize, ROTCTLD_EINVAL);
+        }
+        return reply(out, outSize, ROTCTLD_OK);
+    }
+
+    if (!strcmp(cmd, "R") || !strcmp(cmd, "\\reset")) {
+        motorController->stop(COMMAND_SOURCE_NETWORK);
+        return reply(out, outSize, ROTCTLD_OK);
+    }
+
+    if (!strcmp(cmd, "_") || !strcmp(cmd, "\\get_info")) {
+        return snprintf(out, outSize, "%s ESP32-S3\n", WIFI_HOSTNAME);
+    }
+
+    if (!strcmp(cmd, "\\dump_caps")) {
+        return snprintf(out, outSize,
+            "Caps dump for model: 2\n"
+            "Model name:\t%s\n"
+            "Mfg name:\tRotorAntena\n"
+            "Backend version:\t1.0\n"
+            "Rot type:\tAzimuth\n"
+            "Min Azimuth:\t0.00\n"
+            "Max Azimuth:\t360.00\n"
+            "Min Elevation:\t0.00\n"
+            "Max Elevation:\t0.00\n"
+            "Has get_position:\tY\n"
+            "Has set_position:\tY\n"
+            "Has stop:\tY\n"
+            "Has park:\tY\n"
+            "Has move:\tY\n"
+            "Has reset:\tY\n",
+            WIFI_HOSTNAME);
+    }
+
+    if (!strcmp(cmd, "\\dump_state")) {
+        // Formato lido pelo backend NET rotctl (model 2): versao, modelo, limites
+        return snprintf(out, outSize, "1\n2\n%f\n%f\n%f\n%f\n", 0.0f, 360.0f, 0.0f, 0.0f);
+    }
+
+    if (!strcmp(cmd, "q") || !strcmp(cmd, "Q") || !strcmp(cmd, "\\quit")) {
+        quit = true;
+        return 0;
+    }
+
+    return reply(out, outSize, ROTCTLD_ENIMPL);
+}
@@ -0,0 +1,71 @@
+#ifndef ROTCTLD_SERVER_H
+#define ROTCTLD_SERVER_H
+
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include "config.h"
+#include "motor_control.h"
+#include "storage.h"
+
+// ==================================================================================
+// SERVIDOR TCP COMPATIVEL COM HAMLIB rotctld
+// ==================================================================================
+// Protocolo de linha do rotctld (porta 4533): conexoes persistentes, comandos
+// em pipeline, sem parse HTTP. Usado por gpredict, loggers de contest e
+// "rotctl -m 2". Comandos suportados (forma curta e longa):
+//   p  \get_pos       -> "az\nel\n" (azimute 0-360, elevacao sempre 0)
+//   P  \set_pos az el -> RPRT 0
+//   S  \stop          -> RPRT 0
+//   K  \park          -> vai para 0° (norte), RPRT 0
+//   M  \move dir vel  -> 8 = CCW/esquerda, 16 = CW/direita (ate S)
+//   R  \reset         -> para o motor, RPRT 0
+//   _  \get_info, \dump_caps, \dump_state, q/Q \quit
+// Codigos de erro seguem o Hamlib: -1 = argumento invalido, -4 = nao implementado.
+
+#define ROTCTLD_LINE_MAX 64
+#define ROTCTLD_RESPONSE_MAX 512
+
+#define ROTCTLD_OK 0
+#define ROTCTLD_EINVAL -1
+#define ROTCTLD_ENIMPL -4
+
+#define ROTCTLD_MOVE_CCW 8                  // ROT_MOVE_LEFT / ROT_MOVE_CCW
+#define ROTCTLD_MOVE_CW 16                  // ROT_MOVE_RIGHT / ROT_MOVE_CW
+
+class RotctldServer;
+
+struct RotctldClient {
+    AsyncClient* client;                    // nullptr = slot livre
+    RotctldServer* owner;
+    char line[ROTCTLD_LINE_MAX];            // Linha parcial (comando pode chegar fragmentado)
+    uint8_t len;
+    bool overflow;                          // Linha maior que o buffer: descartar ate '\n'
+};
+
+class RotctldServer {
+private:
+    MotorController* motorController;
+    StorageManager* storage;
+    AsyncServer* server = nullptr;
+    RotctldClient clients[ROTCTLD_MAX_CLIENTS] = {};
+    portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+
+    volatile uint32_t commandCount = 0;
+    volatile uint32_t errorCount = 0;
+
+    void onConnect(AsyncClient* client);
+    void onDisconnect(AsyncClient* client);
+    void onData(RotctldClient* slot, const char* data, size_t len);
+    int execute(char* line, char* out, size_t outSize, bool& quit);
+    int reply(char* out, size_t outSize, int code);
+
+public:
+    RotctldServer(MotorController* motor, StorageManager* store);
+    void begin();
+
+    uint32_t getCommandCount() { return commandCount; }
+    uint32_t getErrorCount() { return errorCount; }
+    int getClientCount();
+};
+
+#endif
@@ -0,0 +1,427 @@
+#include "sat_tracker.h"
+#include <sys/time.h>
+#include <time.h>
+#include <esp_timer.h>
+
+SatTracker satTracker;
+
+// Vetor de referencia do SGP4 (Vallado, SGP4-VER: satelite 00005, TEME em km)
+static const char* SELFTEST_TLE1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+static const char* SELFTEST_TLE2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+static const double SELFTEST_VECTORS[][4] = {
+    {   0.0,  7022.46529266, -1400.08296755,     0.03995155 },
+    { 360.0, -7154.03120202, -3783.17682504, -3536.19412294 },
+    { 720.0, -7134.59340119,  6531.68641334,  3260.27186483 }
+};
+#define SELFTEST_BENCH_STEPS 200
+
+static float azimuthDelta(float a, float b) {
+    float d = fabsf(a - b);
+    return (d > 180.0f) ? 360.0f - d : d;
+}
+
+void SatTracker::begin(MotorController* motor, StorageManager* store) {
+    motorController = motor;
+    storage = store;
+
+    float lat, lon, alt;
+    if (storage->loadQth(lat, lon, alt)) {
+        qthLat = lat;
+        qthLon = lon;
+        qthAlt = alt;
+    }
+    observerInit(observer, qthLat, qthLon, qthAlt);
+
+    char satName[SAT_NAME_MAX];
+    char line1[SAT_TLE_LINE_MAX];
+    char line2[SAT_TLE_LINE_MAX];
+    if (storage->loadSatelliteTle(satName, sizeof(satName), line1, line2, sizeof(line1))) {
+        if (!setTle(satName, line1, line2)) {
+            Serial.println("[Sat] TLE salva invalida, ignorada");
+        }
+    }
+
+    xTaskCreatePinnedToCore(taskEntry, "SatTrack", 6144, this, 1, &taskHandle, 1);
+    Serial.printf("[Sat] Rastreador SGP4 (%s), QTH %.4f %.4f\n",
+                  SAT_USE_FLOAT ? "float" : "double", qthLat, qthLon);
+}
+
+bool SatTracker::isTimeValid() {
+    return time(nullptr) > 1700000000;  // NTP sincronizado (apos nov/2023)
+}
+
+double SatTracker::nowUnix() {
+    struct timeval tv;
+    gettimeofday(&tv, nullptr);
+    return tv.tv_sec + tv.tv_usec * 1e-6;
+}
+
+bool SatTracker::setTle(const char* satName, const char* line1, const char* line2) {
+    TleElements tle;
+    if (!parseTle(line1, line2, tle)) return false;
+    Sgp4<SatReal> probe;
+    if (probe.init(tle) != SGP4_OK) return false;  // Espaco profundo nao suportado
+
+    portENTER_CRITICAL(&pendingMux);
+    pendingTle = tle;
+    tlePending = true;
+    portEXIT_CRITICAL(&pendingMux);
+
+    portENTER_CRITICAL(&stateMux);
+    strncpy(name, satName, SAT_NAME_MAX - 1);
+    name[SAT_NAME_MAX - 1] = '\0';
+    satnum = tle.satnum;
+    epochJd = tle.epochJd;
+    passCount = 0;
+    portEXIT_CRITICAL(&stateMux);
+    return true;
+}
+
+void SatTracker::setQth(float latDeg, float lonDeg, float altMeters) {
+    portENTER_CRITICAL(&pendingMux);
+    pendingLat = latDeg;
+    pendingLon = lonDeg;
+    pendingAlt = altMeters;
+    qthPending = true;
+    portEXIT_CRITICAL(&pendingMux);
+}
+
+void SatTracker::setTracking(bool enabled) {
+    portENTER_CRITICAL(&pendingMux);
+    pendingTracking = enabled;
+    trackingPending = true;
+    portEXIT_CRITICAL(&pendingMux);
+    Serial.printf("[Sat] Rastreio %s\n", enabled ? "ATIVADO" : "desativado");
+}
+
+void SatTracker::taskEntry(void* param) {
+    static_cast<SatTracker*>(param)->run();
+}
+
+void SatTracker::applyPending() {
+    bool newTle = false, newQth = false, newTracking = false;
+    TleElements tle;
+    portENTER_CRITICAL(&pendingMux);
+    if (tlePending) {
+        tle = pendingTle;
+        tlePending = false;
+        newTle = true;
+    }
+    if (qthPending) {
+        qthLat = pendingLat;
+        qthLon = pendingLon;
+        qthAlt = pendingAlt;
+        qthPending = false;
+        newQth = true;
+    }
+    if (trackingPending) {
+        trackingEnabled = pendingTracking;
+        trackingPending = false;
+        newTracking = true;
+    }
+    portEXIT_CRITICAL(&pendingMux);
+
+    if (newTle) {
+        modelValid = (model.init(tle) == SGP4_OK);
+    }
+    if (newTle || newTracking) {
+        commandActive = false;
+        prepositionedAos = 0;
+    }
+    if (newQth) {
+        observerInit(observer, qthLat, qthLon, qthAlt);
+    }
+    if ((newTle || newQth) && modelValid && isTimeValid()) {
+        computePasses(nowUnix());
+    }
+}
+
+void SatTracker::run() {
+    TickType_t lastWake = xTaskGetTickCount();
+    const TickType_t period = pdMS_TO_TICKS(1000 / SAT_TRACK_RATE_HZ);
+
+    for (;;) {
+        vTaskDelayUntil(&lastWake, period);
+        applyPending();
+        if (!modelValid || !isTimeValid()) continue;
+
+        double now = nowUnix();
+        // Tabela vencida (ultima passagem ja terminou): recalcular fora de passagem
+        bool inPass = lookValid && lookEl >= SAT_MIN_ELEVATION_DEG;
+        if (!inPass && (passCount == 0 || now > passes[0].losUnix)) {
+            computePasses(now);
+            lastWake = xTaskGetTickCount();
+        }
+        trackStep(nowUnix());
+    }
+}
+
+bool SatTracker::look(double unixTime, double& az, double& el, double& range) {
+    double jd = unixToJulian(unixTime);
+    SatReal r[3], v[3];
+    if (model.propagate(model.minutesSinceEpoch(jd), r, v) != SGP4_OK) return false;
+    double rTeme[3] = { (double)r[0], (double)r[1], (double)r[2] };
+    lookAngles(observer, rTeme, gmstFromJulian(jd), az, el, range);
+    return true;
+}
+
+void SatTracker::computePasses(double fromUnix) {
+    int64_t start = esp_timer_get_time();
+    SatPass found[SAT_MAX_PASSES];
+    int count = 0;
+    const double minEl = SAT_MIN_ELEVATION_DEG;
+    const double end = fromUnix + SAT_PASS_HORIZON_H * 3600.0;
+
+    double az, el, range;
+    double t = fromUnix;
+    if (!look(t, az, el, range)) return;
+    bool inPass = el >= minEl;
+    SatPass current = {};
+    double maxEl = el;
+    if (inPass) {
+        // Ja em passagem: AOS = agora
+        current.aosUnix = (uint32_t)t;
+        current.aosAzCdeg = (uint16_t)(az * 100.0);
+        current.maxElAzCdeg = current.aosAzCdeg;
+    }
+
+    while (t < end && count < SAT_MAX_PASSES) {
+        // Passo fino durante a passagem (elevacao maxima), grosso fora dela
+        double tn = t + (inPass ? 10.0 : SAT_PASS_SCAN_STEP_S);
+        if (!look(tn, az, el, range)) break;
+
+        if (!inPass && el >= minEl) {
+            // Refinar AOS por bissecao (resolucao < 1 s)
+            double lo = t, hi = tn, a2, e2, r2;
+            while (hi - lo > 0.5) {
+                double mid = 0.5 * (lo + hi);
+                if (!look(mid, a2, e2, r2)) break;
+                if (e2 >= minEl) hi = mid; else lo = mid;
+            }
+            look(hi, a2, e2, r2);
+            current = {};
+            current.aosUnix = (uint32_t)hi;
+            current.aosAzCdeg = (uint16_t)(a2 * 100.0);
+            maxEl = el;
+            current.maxElAzCdeg = (uint16_t)(az * 100.0);
+            inPass = true;
+        } else if (inPass && el >= minEl) {
+            if (el > maxEl) {
+                maxEl = el;
+                current.maxElAzCdeg = (uint16_t)(az * 100.0);
+            }
+        } else if (inPass) {
+            // Refinar LOS
+            double lo = t, hi = tn, a2, e2, r2;
+            while (hi - lo > 0.5) {
+                double mid = 0.5 * (lo + hi);
+                if (!look(mid, a2, e2, r2)) break;
+                if (e2 >= minEl) lo = mid; else hi = mid;
+            }
+            look(lo, a2, e2, r2);
+            current.losUnix = (uint32_t)lo;
+            current.losAzCdeg = (uint16_t)(a2 * 100.0);
+            current.maxElCdeg = (uint16_t)(maxEl * 100.0);
+            found[count++] = current;
+            inPass = false;
+        }
+        t = tn;
+    }
+
+    // Passagem ainda aberta no fim da janela (ex.: geoestacionario): fechar no limite
+    if (inPass && count < SAT_MAX_PASSES) {
+        current.losUnix = (uint32_t)t;
+        current.losAzCdeg = (uint16_t)(az * 100.0);
+        current.maxElCdeg = (uint16_t)(maxEl * 100.0);
+        found[count++] = current;
+    }
+
+    uint32_t elapsedMs = (uint32_t)((esp_timer_get_time() - start) / 1000);
+    portENTER_CRITICAL(&stateMux);
+    memcpy(passes, found, sizeof(SatPass) * count);
+    passCount = count;
+    passesComputedAt = (uint32_t)fromUnix;
+    passComputeMs = elapsedMs;
+    portEXIT_CRITICAL(&stateMux);
+    Serial.printf("[Sat] %d passagens nas proximas %dh (%u ms)\n", count, SAT_PASS_HORIZON_H, (unsigned)elapsedMs);
+}
+
+void SatTracker::commandAzimuth(float az) {
+    motorController->moveToAngle(az, COMMAND_SOURCE_TRACKER);  // Normaliza para ±180 e aplica a protecao de cabo
+    lastCommandAz = az;
+    commandActive = true;
+}
+
+// Mantem a fila de waypoints do motor SAT_TRAJ_LEAD_MS a frente do satelite.
+// false = nao da para seguir por trajetoria (passagem cruza o ponto de ±180°)
+bool SatTracker::feedTrajectory(double nowUnix, float az) {
+    bool following = (motorController->getState().flags & MOTOR_FLAG_TRAJECTORY) != 0;
+    if (following && nowUnix - lastWaypointUnix < 1.0) return true;
+
+    double aheadAz, aheadEl, aheadRange;
+    if (!look(nowUnix + SAT_TRAJ_LEAD_MS / 1000.0, aheadAz, aheadEl, aheadRange)) return false;
+
+    uint32_t now = millis();
+    TrajectoryWaypoint points[2];
+    int count = 0;
+    if (!following) {
+        points[count].timeMs = now;
+        points[count].azimuth = az;
+        count++;
+    }
+    points[count].timeMs = now + SAT_TRAJ_LEAD_MS;
+    points[count].azimuth = aheadAz;
+    count++;
+
+    if (motorController->loadTrajectory(points, count, following, COMMAND_SOURCE_TRACKER) < count) return false;
+    lastWaypointUnix = nowUnix;
+    lastCommandAz = az;
+    commandActive = true;
+    return true;
+}
+
+void SatTracker::trackStep(double nowUnix) {
+    int64_t start = esp_timer_get_time();
+    double az, el, range;
+    bool ok = look(nowUnix, az, el, range);
+    uint32_t elapsed = (uint32_t)(esp_timer_get_time() - start);
+
+    portENTER_CRITICAL(&stateMux);
+    lookValid = ok;
+    if (ok) {
+        lookAz = az;
+        lookEl = el;
+        lookRange = range;
+    }
+    stepUs = elapsed;
+    if (elapsed > maxStepUs) maxStepUs = elapsed;
+    portEXIT_CRITICAL(&stateMux);
+
+    if (!ok || !trackingEnabled) return;
+
+    if (el >= SAT_MIN_ELEVATION_DEG) {
+        #if SAT_TRACK_TRAJECTORY
+        if (feedTrajectory(nowUnix, az)) return;
+        #endif
+        if (!commandActive || azimuthDelta(az, lastCommandAz) >= SAT_TRACK_STEP_DEG) {
+            commandAzimuth(az);
+        }
+        return;
+    }
+
+    // Abaixo do horizonte: pre-posicionar no azimute de AOS da proxima passagem
+    commandActive = false;
+    for (int i = 0; i < passCount; i++) {
+        const SatPass& p = passes[i];
+        if (p.aosUnix <= nowUnix) continue;
+        if (p.aosUnix - nowUnix <= SAT_PREPOSITION_S && prepositionedAos != p.aosUnix) {
+            Serial.printf("[Sat] Pre-posicionando para AOS em %.0fs (az %.1f)\n",
+                          p.aosUnix - nowUnix, p.aosAzCdeg / 100.0f);
+            commandAzimuth(p.aosAzCdeg / 100.0f);
+            commandActive = false;  // Na AOS o primeiro passo comanda de novo
+            prepositionedAos = p.aosUnix;
+        }
+        break;
+    }
+}
+
+void SatTracker::writeStatusJSON(JsonObject out) {
+    // Copia curta sob o lock; o JSON e montado fora da secao critica
+    SatPass snapshot[SAT_MAX_PASSES];
+    char satName[SAT_NAME_MAX];
+    portENTER_CRITICAL(&stateMux);
+    int count = passCount;
+    memcpy(snapshot, passes, sizeof(SatPass) * count);
+    memcpy(satName, name, sizeof(satName));
+    uint32_t num = satnum;
+    double epoch = epochJd;
+    float az = lookAz, el = lookEl, range = lookRange;
+    bool valid = lookValid;
+    uint32_t step = stepUs, maxStep = maxStepUs, computeMs = passComputeMs, computedAt = passesComputedAt;
+    portEXIT_CRITICAL(&stateMux);
+
+    out["name"] = satName;
+    out["satnum"] = num;
+    out["epochJd"] = epoch;
+    out["tleLoaded"] = num != 0;
+    out["tracking"] = (bool)trackingEnabled;
+    out["timeValid"] = isTimeValid();
+    out["now"] = (uint32_t)time(nullptr);
+    out["az"] = az;
+    out["el"] = el;
+    out["rangeKm"] = range;
+    out["lookValid"] = valid;
+    out["stepUs"] = step;
+    out["maxStepUs"] = maxStep;
+    out["passComputeMs"] = computeMs;
+    out["passesComputedAt"] = computedAt;
+    out["float"] = (bool)SAT_USE_FLOAT;
+    JsonObject qth = out.createNestedObject("qth");
+    qth["lat"] = qthLat;
+    qth["lon"] = qthLon;
+    qth["alt"] = qthAlt;
+
+    JsonArray table = out.createNestedArray("passes");
+    for (int i = 0; i < count; i++) {
+        JsonObject p = table.createNestedObject();
+        p["aos"] = snapshot[i].aosUnix;
+        p["los"] = snapshot[i].losUnix;
+        p["aosAz"] = snapshot[i].aosAzCdeg / 100.0f;
+        p["losAz"] = snapshot[i].losAzCdeg / 100.0f;
+        p["maxEl"] = snapshot[i].maxElCdeg / 100.0f;
+        p["maxElAz"] = snapshot[i].maxElAzCdeg / 100.0f;
+    }
+}
+
+// Propaga o vetor de referencia nas duas precisoes e mede o custo por passo
+template <typename T>
+static double selfTestPrecision(const TleElements& tle, JsonObject out) {
+    Sgp4<T> sgp4;
+    if (sgp4.init(tle) != SGP4_OK) {
+        out["error"] = "init";
+        return 1e9;
+    }
+    T r[3], v[3];
+    double maxErrKm = 0;
+    for (size_t i = 0; i < sizeof(SELFTEST_VECTORS) / sizeof(SELFTEST_VECTORS[0]); i++) {
+        sgp4.propagate(SELFTEST_VECTORS[i][0], r, v);
+        double dx = r[0] - SELFTEST_VECTORS[i][1];
+        double dy = r[1] - SELFTEST_VECTORS[i][2];
+        double dz = r[2] - SELFTEST_VECTORS[i][3];
+        double err = sqrt(dx * dx + dy * dy + dz * dz);
+        if (err > maxErrKm) maxErrKm = err;
+    }
+    out["maxErrorKm"] = maxErrKm;
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < SELFTEST_BENCH_STEPS; i++) {
+        sgp4.propagate(i * 7.2, r, v);
+    }
+    out["propagateUs"] = (float)(esp_timer_get_time() - start) / SELFTEST_BENCH_STEPS;
+    return maxErrKm;
+}
+
+bool SatTracker::runSelfTest(JsonObject out) {
+    TleElements tle;
+    if (!parseTle(SELFTEST_TLE1, SELFTEST_TLE2, tle)) {
+        out["error"] = "tle";
+        return false;
+    }
+    double maxErr = selfTestPrecision<double>(tle, out.createNestedObject("double"));
+    selfTestPrecision<float>(tle, out.createNestedObject("float"));
+
+    // Conversao para az/el (GMST + topocentrico, sempre em double)
+    Observer obs;
+    observerInit(obs, qthLat, qthLon, qthAlt);
+    double r[3] = { SELFTEST_VECTORS[1][1], SELFTEST_VECTORS[1][2], SELFTEST_VECTORS[1][3] };
+    double az, el, range;
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < SELFTEST_BENCH_STEPS; i++) {
+        lookAngles(obs, r, gmstFromJulian(tle.epochJd + i * 0.001), az, el, range);
+    }
+    out["lookAnglesUs"] = (float)(esp_timer_get_time() - start) / SELFTEST_BENCH_STEPS;
+
+    bool pass = maxErr < 0.001;  // Referencia em double: < 1 m
+    out["pass"] = pass;
+    return pass;
+}
@@ -0,0 +1,110 @@
+#ifndef SAT_TRACKER_H
+#define SAT_TRACKER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "sgp4.h"
+#include "motor_control.h"
+#include "storage.h"
+
+// ==================================================================================
+// RASTREIO DE SATELITES NO DISPOSITIVO
+// ==================================================================================
+// TLE enviada pela API -> SGP4 propagado a SAT_TRACK_RATE_HZ para o QTH
+// configurado -> moveToAngle() sempre que o azimute andar SAT_TRACK_STEP_DEG.
+// As proximas passagens ficam numa tabela compacta, entao o pre-posicionamento
+// no azimute de AOS e imediato. Relogio UTC via NTP.
+//
+// A task "SatTrack" e a unica que mexe no modelo e no estado do rastreio; TLE,
+// QTH e liga/desliga chegam por flags pendentes (mesmo padrao do resetPosition
+// do encoder).
+
+#define SAT_NAME_MAX 25
+#define SAT_TLE_LINE_MAX 70                 // 69 colunas + terminador
+
+#if SAT_USE_FLOAT
+typedef float SatReal;
+#else
+typedef double SatReal;
+#endif
+
+// Passagem pre-calculada (16 bytes; angulos em centesimos de grau)
+struct SatPass {
+    uint32_t aosUnix;
+    uint32_t losUnix;
+    uint16_t aosAzCdeg;
+    uint16_t losAzCdeg;
+    uint16_t maxElCdeg;
+    uint16_t maxElAzCdeg;
+};
+
+class SatTracker {
+private:
+    MotorController* motorController = nullptr;
+    StorageManager* storage = nullptr;
+    TaskHandle_t taskHandle = NULL;
+
+    // Modelo (somente a task)
+    Sgp4<SatReal> model;
+    Observer observer;
+    bool modelValid = false;
+
+    // Entradas pendentes (web -> task)
+    portMUX_TYPE pendingMux = portMUX_INITIALIZER_UNLOCKED;
+    volatile bool tlePending = false;
+    volatile bool qthPending = false;
+    volatile bool trackingPending = false;
+    TleElements pendingTle;
+    float pendingLat = 0, pendingLon = 0, pendingAlt = 0;
+    bool pendingTracking = false;
+
+    // Estado publicado (task -> web)
+    portMUX_TYPE stateMux = portMUX_INITIALIZER_UNLOCKED;
+    char name[SAT_NAME_MAX] = "";
+    uint32_t satnum = 0;
+    double epochJd = 0;
+    float qthLat = QTH_DEFAULT_LAT, qthLon = QTH_DEFAULT_LON, qthAlt = QTH_DEFAULT_ALT;
+    float lookAz = 0, lookEl = -90, lookRange = 0;
+    bool lookValid = false;
+    SatPass passes[SAT_MAX_PASSES];
+    int passCount = 0;
+    uint32_t passesComputedAt = 0;
+    uint32_t passComputeMs = 0;
+    uint32_t stepUs = 0;
+    uint32_t maxStepUs = 0;
+
+    // Controle do rotor
+    volatile bool trackingEnabled = false;   // Escrito so pela task (setTracking() fica pendente)
+    bool commandActive = false;
+    float lastCommandAz = 0;
+    uint32_t prepositionedAos = 0;
+    double lastWaypointUnix = 0;
+
+
+    static void taskEntry(void* param);
+    void run();
+    void applyPending();
+    bool look(double unixTime, double& az, double& el, double& range);
+    void computePasses(double fromUnix);
+    void trackStep(double nowUnix);
+    void commandAzimuth(float az);
+    bool feedTrajectory(double nowUnix, float az);
+
+public:
+    void begin(MotorController* motor, StorageManager* store);
+    bool setTle(const char* satName, const char* line1, const char* line2);
+    void setQth(float latDeg, float lonDeg, float altMeters);
+    void setTracking(bool enabled);
+    bool isTracking() { return trackingEnabled; }
+
+    static bool isTimeValid();
+    static double nowUnix();
+
+    void writeStatusJSON(JsonObject out);
+    bool runSelfTest(JsonObject out);     // Vetores de referencia + custo por passo (true = passou)
+};
+
+extern SatTracker satTracker;
+
+#endif
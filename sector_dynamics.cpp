@@ -0,0 +1,124 @@
+#include "sector_dynamics.h"
+
+#define SECTOR_WIDTH_DEG (360.0f / DYNAMICS_SECTOR_COUNT)
+
+SectorDynamics::SectorDynamics() {
+    reset();
+}
+
+void SectorDynamics::reset() {
+    memset(cells, 0, sizeof(cells));
+}
+
+void SectorDynamics::neighbours(float position, int& first, int& second, float& weight) {
+    float heading = fmodf(position, 360.0f);
+    if (heading < 0.0f) heading += 360.0f;
+    float x = heading / SECTOR_WIDTH_DEG - 0.5f;   // Em unidades de celula, a partir do centro da 0
+    float base = floorf(x);
+    weight = x - base;
+    first = ((int)base + DYNAMICS_SECTOR_COUNT) % DYNAMICS_SECTOR_COUNT;
+    second = (first + 1) % DYNAMICS_SECTOR_COUNT;
+}
+
+// Media movel com peso da interpolacao; as primeiras amostras entram como media simples
+void SectorDynamics::learnCell(SectorCell& cell, float weight, float bias, float breakaway) {
+    if (weight < 0.05f) return;
+    if (bias == bias) {   // NaN = sem amostra de frenagem
+        float rate = weight * max((float)DYNAMICS_LEARNING_RATE, 1.0f / (cell.brakeSamples + 1));
+        float value = cell.brakeBiasCenti + rate * (bias * 100.0f - cell.brakeBiasCenti);
+        cell.brakeBiasCenti = (int8_t)constrain(lroundf(value), -127L, 127L);
+        if (weight >= 0.25f && cell.brakeSamples < 255) cell.brakeSamples++;
+    }
+    if (breakaway > 0.0f) {
+        float current = cell.breakawayQuarter * 4.0f;
+        float rate = weight * max((float)DYNAMICS_LEARNING_RATE, 1.0f / (cell.breakawaySamples + 1));
+        float value = cell.breakawaySamples == 0 ? breakaway : current + rate * (breakaway - current);
+        cell.breakawayQuarter = (uint8_t)constrain(lroundf(value / 4.0f), 1L, 255L);
+        if (weight >= 0.25f && cell.breakawaySamples < 255) cell.breakawaySamples++;
+    }
+}
+
+void SectorDynamics::learnBraking(float position, int direction, float residualDeg) {
+    int first, second;
+    float weight;
+    neighbours(position, first, second, weight);
+    learnCell(cells[direction][first], 1.0f - weight, residualDeg, 0.0f);
+    learnCell(cells[direction][second], weight, residualDeg, 0.0f);
+}
+
+void SectorDynamics::learnBreakaway(float position, int direction, int pwm) {
+    int first, second;
+    float weight;
+    neighbours(position, first, second, weight);
+    learnCell(cells[direction][first], 1.0f - weight, NAN, pwm);
+    learnCell(cells[direction][second], weight, NAN, pwm);
+}
+
+float SectorDynamics::brakeBias(float position, int direction) {
+    int first, second;
+    float weight;
+    neighbours(position, first, second, weight);
+    const SectorCell& a = cells[direction][first];
+    const SectorCell& b = cells[direction][second];
+    float biasA = a.brakeSamples >= DYNAMICS_MIN_SAMPLES ? a.brakeBiasCenti / 100.0f : 0.0f;
+    float biasB = b.brakeSamples >= DYNAMICS_MIN_SAMPLES ? b.brakeBiasCenti / 100.0f : 0.0f;
+    return biasA + weight * (biasB - biasA);
+}
+
+int SectorDynamics::breakawayPWM(float position, int direction) {
+    int first, second;
+    float weight;
+    neighbours(position, first, second, weight);
+    const SectorCell& a = cells[direction][first];
+    const SectorCell& b = cells[direction][second];
+    bool knownA = a.breakawaySamples >= DYNAMICS_MIN_SAMPLES;
+    bool knownB = b.breakawaySamples >= DYNAMICS_MIN_SAMPLES;
+    if (knownA && knownB) {
+        float pwmA = a.breakawayQuarter * 4.0f;
+        return (int)lroundf(pwmA + weight * (b.breakawayQuarter * 4.0f - pwmA));
+    }
+    if (knownA) return a.breakawayQuarter * 4;
+    if (knownB) return b.breakawayQuarter * 4;
+    return 0;
+}
+
+// ==================================================================================
+// PERSISTENCIA E DIAGNOSTICO
+// ==================================================================================
+
+void SectorDynamics::save(SectorTableRecord& out) {
+    out.magic = SECTOR_TABLE_MAGIC;
+    out.version = SECTOR_TABLE_VERSION;
+    out.sectors = DYNAMICS_SECTOR_COUNT;
+    memcpy(out.cells, cells, sizeof(cells));
+}
+
+bool SectorDynamics::load(const SectorTableRecord& in) {
+    if (in.magic != SECTOR_TABLE_MAGIC || in.version != SECTOR_TABLE_VERSION ||
+        in.sectors != DYNAMICS_SECTOR_COUNT) {
+        return false;
+    }
+    memcpy(cells, in.cells, sizeof(cells));
+    return true;
+}
+
+// Um array por grandeza e sentido (indice = setor, centro em (i + 0.5) * largura)
+void SectorDynamics::writeJSON(JsonObject out) {
+    out["sectors"] = DYNAMICS_SECTOR_COUNT;
+    out["sectorWidthDeg"] = SECTOR_WIDTH_DEG;
+    static const char* const NAMES[] = {"cw", "ccw"};
+    for (int d = 0; d < 2; d++) {
+        JsonObject dir = out.createNestedObject(NAMES[d]);
+        JsonArray bias = dir.createNestedArray("brakeBiasDeg");
+        JsonArray breakaway = dir.createNestedArray("breakawayPWM");
+        JsonArray brakeSamples = dir.createNestedArray("brakeSamples");
+        JsonArray breakawaySamples = dir.createNestedArray("breakawaySamples");
+        for (int i = 0; i < DYNAMICS_SECTOR_COUNT; i++) {
+            const SectorCell& c = cells[d][i];
+            bias.add(c.brakeBiasCenti / 100.0f);
+            breakaway.add(c.breakawayQuarter * 4);
+            brakeSamples.add(c.brakeSamples);
+            breakawaySamples.add(c.breakawaySamples);
+        }
+    }
+}
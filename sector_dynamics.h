@@ -0,0 +1,64 @@
+#ifndef SECTOR_DYNAMICS_H
+#define SECTOR_DYNAMICS_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+
+// ==================================================================================
+// DINAMICA POR SETOR DE AZIMUTE (atrito e frenagem dependem da direcao)
+// ==================================================================================
+// Atrito do mancal, cabo e vento na antena mudam com o azimute e o sentido;
+// o modelo de frenagem (braking_model.h) e o atrito do autotune sao medias.
+// A tabela guarda, por setor de DYNAMICS_SECTOR_COUNT e por sentido:
+//
+//   - desvio da frenagem: residuo medio do modelo RLS neste setor (graus)
+//   - atrito de partida: PWM em que o rotor saiu do lugar partindo parado
+//
+// As celulas ficam no centro de cada setor: a leitura interpola as duas
+// vizinhas e cada amostra atualiza as duas com o mesmo peso da interpolacao.
+// Celulas sem amostras suficientes nao entram (desvio 0, partida desconhecida).
+
+#define SECTOR_TABLE_MAGIC 0x5344      // 'SD'
+#define SECTOR_TABLE_VERSION 1
+
+struct __attribute__((packed)) SectorCell {
+    int8_t brakeBiasCenti;         // Centesimos de grau (±1.27°)
+    uint8_t breakawayQuarter;      // PWM / 4 (0 = sem dados)
+    uint8_t brakeSamples;          // Saturam em 255
+    uint8_t breakawaySamples;
+};
+
+// Blob gravado na NVS (chave DYNAMICS_NVS_KEY)
+struct __attribute__((packed)) SectorTableRecord {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t sectors;               // DYNAMICS_SECTOR_COUNT na gravacao (mudou = descarta)
+    SectorCell cells[2][DYNAMICS_SECTOR_COUNT];   // [0] = CW, [1] = CCW
+    uint32_t crc;
+};
+
+class SectorDynamics {
+private:
+    SectorCell cells[2][DYNAMICS_SECTOR_COUNT];
+
+    // Celulas vizinhas e peso da segunda para a posicao (referencial absoluto)
+    static void neighbours(float position, int& first, int& second, float& weight);
+    static void learnCell(SectorCell& cell, float weight, float bias, float breakaway);
+
+public:
+    SectorDynamics();
+    void reset();
+
+    // direction: 0 = CW, 1 = CCW
+    void learnBraking(float position, int direction, float residualDeg);
+    void learnBreakaway(float position, int direction, int pwm);
+    float brakeBias(float position, int direction);          // Graus (0 sem dados)
+    int breakawayPWM(float position, int direction);         // 0 = desconhecido
+
+    void save(SectorTableRecord& out);
+    bool load(const SectorTableRecord& in);    // false = blob de outro formato
+    void writeJSON(JsonObject out);
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ==================================================================================
+// PUBLICACAO DE ESTADO SEM BLOQUEIO (seqlock)
+// ==================================================================================
+// A motorTask publica um snapshot por ciclo; leitores (web, WebSocket) copiam
+// sem mutex e repetem a copia apenas se pegaram uma escrita no meio.
+// O escritor nunca espera por leitores, entao o loop de controle nao trava.
+//
+// A escrita fica numa secao critica curta (apenas a copia da struct): impede
+// que o escritor seja preemptado no meio e permite mais de um escritor.
+template <typename T>
+class SeqLock {
+private:
+    std::atomic<uint32_t> sequence{0};
+    T data;
+    portMUX_TYPE writeMux = portMUX_INITIALIZER_UNLOCKED;
+
+    std::atomic<uint32_t> readRetries{0};  // Leituras repetidas por colisao com escrita
+    uint32_t writes = 0;
+
+public:
+    SeqLock() : data() {}
+
+    void store(const T& value) {
+        portENTER_CRITICAL(&writeMux);
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);   // Impar = escrita em andamento
+        std::atomic_thread_fence(std::memory_order_release);
+        data = value;
+        std::atomic_thread_fence(std::memory_order_release);
+        sequence.store(seq + 2, std::memory_order_release);
+        writes++;
+        portEXIT_CRITICAL(&writeMux);
+    }
+
+    T load() {
+        for (;;) {
+            uint32_t before = sequence.load(std::memory_order_acquire);
+            if ((before & 1) == 0) {
+                T copy = data;
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) {
+                    return copy;
+                }
+            }
+            readRetries.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t getReadRetries() { return readRetries.load(std::memory_order_relaxed); }
+    uint32_t getWrites() { return writes; }
+};
+
+#endif
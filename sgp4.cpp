@@ -0,0 +1,137 @@
+#include "sgp4.h"
+#include <string.h>
+#include <stdlib.h>
+
+static const double DEG2RAD = M_PI / 180.0;
+static const double TWO_PI = 2.0 * M_PI;
+
+// ==================================================================================
+// LEITURA DA TLE
+// ==================================================================================
+
+// Soma de verificacao da coluna 69: digitos + 1 por '-' (modulo 10)
+static bool tleChecksumOk(const char* line) {
+    int sum = 0;
+    for (int i = 0; i < 68; i++) {
+        char c = line[i];
+        if (c >= '0' && c <= '9') sum += c - '0';
+        else if (c == '-') sum += 1;
+    }
+    return (sum % 10) == (line[68] - '0');
+}
+
+// Campo de largura fixa (colunas 1-based, inclusivas) convertido para double
+static double tleField(const char* line, int firstCol, int lastCol) {
+    char buf[16];
+    int n = lastCol - firstCol + 1;
+    memcpy(buf, line + firstCol - 1, n);
+    buf[n] = '\0';
+    return atof(buf);
+}
+
+// Formato "exponencial implicito" da TLE: " 28098-4" = 0.28098e-4
+static double tleExpField(const char* line, int firstCol) {
+    const char* f = line + firstCol - 1;
+    char mantissa[10];
+    mantissa[0] = (f[0] == '-') ? '-' : '+';
+    mantissa[1] = '.';
+    memcpy(mantissa + 2, f + 1, 5);
+    mantissa[7] = '\0';
+    char expo[3] = { f[6], f[7], '\0' };
+    return atof(mantissa) * pow(10.0, atoi(expo));
+}
+
+static bool tleLineValid(const char* line, char number) {
+    if (!line || strlen(line) < 69) return false;
+    if (line[0] != number || line[1] != ' ') return false;
+    return tleChecksumOk(line);
+}
+
+// Dia juliano de 1 de janeiro 00:00 UTC do ano (calendario gregoriano)
+static double julianJan1(int year) {
+    int y = year - 1;
+    return 1721425.5 + 365.0 * y + (y / 4) - (y / 100) + (y / 400);
+}
+
+bool parseTle(const char* line1, const char* line2, TleElements& out) {
+    if (!tleLineValid(line1, '1') || !tleLineValid(line2, '2')) return false;
+
+    out.satnum = (uint32_t)tleField(line1, 3, 7);
+    if ((uint32_t)tleField(line2, 3, 7) != out.satnum) return false;
+
+    int year = (int)tleField(line1, 19, 20);
+    year += (year < 57) ? 2000 : 1900;
+    double dayOfYear = tleField(line1, 21, 32);
+    out.epochJd = julianJan1(year) + dayOfYear - 1.0;
+    out.bstar = tleExpField(line1, 54);
+
+    out.inclo = tleField(line2, 9, 16) * DEG2RAD;
+    out.nodeo = tleField(line2, 18, 25) * DEG2RAD;
+    char ecc[10] = "0.";
+    memcpy(ecc + 2, line2 + 26, 7);
+    ecc[9] = '\0';
+    out.ecco = atof(ecc);
+    out.argpo = tleField(line2, 35, 42) * DEG2RAD;
+    out.mo = tleField(line2, 44, 51) * DEG2RAD;
+    double revPerDay = tleField(line2, 53, 63);
+    if (revPerDay <= 0) return false;
+    out.noKozai = revPerDay * TWO_PI / 1440.0;
+    return true;
+}
+
+// ==================================================================================
+// TEMPO E GEOMETRIA DO OBSERVADOR
+// ==================================================================================
+
+double unixToJulian(double unixSeconds) {
+    return unixSeconds / 86400.0 + 2440587.5;
+}
+
+double gmstFromJulian(double jdUt1) {
+    // IAU-82 (mesma formula usada pelo SGP4 de referencia)
+    double tut1 = (jdUt1 - 2451545.0) / 36525.0;
+    double seconds = -6.2e-6 * tut1 * tut1 * tut1 + 0.093104 * tut1 * tut1 +
+                     (876600.0 * 3600.0 + 8640184.812866) * tut1 + 67310.54841;
+    double gmst = fmod(seconds * DEG2RAD / 240.0, TWO_PI);
+    if (gmst < 0) gmst += TWO_PI;
+    return gmst;
+}
+
+void observerInit(Observer& obs, double latDeg, double lonDeg, double altMeters) {
+    const double a = 6378.137;                  // WGS-84 (km)
+    const double e2 = 0.00669437999014;
+    obs.latRad = latDeg * DEG2RAD;
+    obs.lonRad = lonDeg * DEG2RAD;
+    obs.sinLat = sin(obs.latRad);
+    obs.cosLat = cos(obs.latRad);
+    obs.sinLon = sin(obs.lonRad);
+    obs.cosLon = cos(obs.lonRad);
+    double n = a / sqrt(1.0 - e2 * obs.sinLat * obs.sinLat);
+    double h = altMeters / 1000.0;
+    obs.ecef[0] = (n + h) * obs.cosLat * obs.cosLon;
+    obs.ecef[1] = (n + h) * obs.cosLat * obs.sinLon;
+    obs.ecef[2] = (n * (1.0 - e2) + h) * obs.sinLat;
+}
+
+void lookAngles(const Observer& obs, const double rTeme[3], double gmst,
+                double& azDeg, double& elDeg, double& rangeKm) {
+    // TEME -> ECEF (rotacao pelo GMST; movimento polar desprezado)
+    double cg = cos(gmst), sg = sin(gmst);
+    double x = cg * rTeme[0] + sg * rTeme[1];
+    double y = -sg * rTeme[0] + cg * rTeme[1];
+    double z = rTeme[2];
+
+    double dx = x - obs.ecef[0];
+    double dy = y - obs.ecef[1];
+    double dz = z - obs.ecef[2];
+
+    // Topocentrico SEZ (sul, leste, zenite)
+    double s = obs.sinLat * obs.cosLon * dx + obs.sinLat * obs.sinLon * dy - obs.cosLat * dz;
+    double e = -obs.sinLon * dx + obs.cosLon * dy;
+    double zz = obs.cosLat * obs.cosLon * dx + obs.cosLat * obs.sinLon * dy + obs.sinLat * dz;
+
+    rangeKm = sqrt(s * s + e * e + zz * zz);
+    elDeg = asin(zz / rangeKm) / DEG2RAD;
+    azDeg = atan2(e, -s) / DEG2RAD;
+    if (azDeg < 0) azDeg += 360.0;
+}
@@ -0,0 +1,330 @@
+#ifndef SGP4_H
+#define SGP4_H
+
+#include <Arduino.h>
+#include <math.h>
+
+// ==================================================================================
+// PROPAGADOR SGP4 (orbitas proximas, periodo < 225 min)
+// ==================================================================================
+// Implementacao do SGP4 "near-earth" (Spacetrack Report #3, revisao de Vallado
+// 2006, constantes WGS-72) suficiente para satelites LEO de radioamador.
+// Orbitas de espaco profundo (SDP4) sao recusadas no init().
+//
+// Template no tipo numerico: Sgp4<double> e a referencia; Sgp4<float> roda na
+// FPU de precisao simples do ESP32-S3 (double e emulado em software). O tempo
+// desde a epoca e sempre calculado em double antes de entrar no propagador.
+
+#define SGP4_OK 0
+#define SGP4_ERR_ECCENTRICITY 1
+#define SGP4_ERR_MEAN_MOTION 2
+#define SGP4_ERR_SEMILATUS 4
+#define SGP4_ERR_DECAYED 6
+#define SGP4_ERR_DEEP_SPACE 10
+#define SGP4_ERR_TLE 11
+
+// Elementos medios lidos da TLE (unidades do SGP4: rad, rad/min, dias julianos)
+struct TleElements {
+    uint32_t satnum;
+    double epochJd;                 // Epoca em dia juliano (UTC)
+    double bstar;
+    double inclo;
+    double nodeo;
+    double ecco;
+    double argpo;
+    double mo;
+    double noKozai;                 // Movimento medio (rad/min)
+};
+
+// Valida checksums/colunas e converte as duas linhas da TLE
+bool parseTle(const char* line1, const char* line2, TleElements& out);
+
+// Conversoes de tempo
+double unixToJulian(double unixSeconds);
+double gmstFromJulian(double jdUt1);   // Tempo sideral medio de Greenwich (rad)
+
+// Observador (QTH) em ECEF, WGS-84
+struct Observer {
+    double latRad;
+    double lonRad;
+    double sinLat, cosLat, sinLon, cosLon;
+    double ecef[3];                 // km
+};
+
+void observerInit(Observer& obs, double latDeg, double lonDeg, double altMeters);
+
+// Azimute/elevacao/distancia a partir da posicao TEME (km) e do GMST
+void lookAngles(const Observer& obs, const double rTeme[3], double gmst,
+                double& azDeg, double& elDeg, double& rangeKm);
+
+template <typename T>
+class Sgp4 {
+private:
+    // Constantes WGS-72 (as mesmas usadas na geracao das TLEs)
+    static constexpr double MU = 398600.8;
+    static constexpr double RADIUS_KM = 6378.135;
+    static constexpr double J2 = 0.001082616;
+    static constexpr double J3 = -0.00000253881;
+    static constexpr double J4 = -0.00000165597;
+    static constexpr double TWO_PI = 6.283185307179586;
+
+    double epochJd = 0;
+    T xke, j2, j3oj2, j4;
+    T ecco, argpo, inclo, mo, nodeo, bstar, noUnkozai;
+    T isimp;
+    T aycof, con41, cc1, cc4, cc5, d2, d3, d4, delmo, eta, argpdot, omgcof;
+    T sinmao, t2cof, t3cof, t4cof, t5cof, x1mth2, x7thm1, mdot, nodedot;
+    T xlcof, xmcof, nodecf;
+    bool initialized = false;
+
+public:
+    int init(const TleElements& tle) {
+        initialized = false;
+        epochJd = tle.epochJd;
+        xke = T(60.0 / sqrt(RADIUS_KM * RADIUS_KM * RADIUS_KM / MU));
+        j2 = T(J2);
+        j4 = T(J4);
+        j3oj2 = T(J3 / J2);
+        ecco = T(tle.ecco);
+        argpo = T(tle.argpo);
+        inclo = T(tle.inclo);
+        mo = T(tle.mo);
+        nodeo = T(tle.nodeo);
+        bstar = T(tle.bstar);
+        T noKozai = T(tle.noKozai);
+
+        const T x2o3 = T(2.0) / T(3.0);
+        const T temp4 = T(1.5e-12);
+
+        // --- initl: recupera o movimento medio original (Brouwer) ---
+        T eccsq = ecco * ecco;
+        T omeosq = T(1) - eccsq;
+        T rteosq = sqrt(omeosq);
+        T cosio = cos(inclo);
+        T cosio2 = cosio * cosio;
+        T ak = pow(xke / noKozai, x2o3);
+        T d1 = T(0.75) * j2 * (T(3) * cosio2 - T(1)) / (rteosq * omeosq);
+        T del = d1 / (ak * ak);
+        T adel = ak * (T(1) - del * del - del * (T(1) / T(3) + T(134) * del * del / T(81)));
+        del = d1 / (adel * adel);
+        noUnkozai = noKozai / (T(1) + del);
+
+        if (TWO_PI / double(noUnkozai) >= 225.0) return SGP4_ERR_DEEP_SPACE;
+
+        T ao = pow(xke / noUnkozai, x2o3);
+        T sinio = sin(inclo);
+        T po = ao * omeosq;
+        T con42 = T(1) - T(5) * cosio2;
+        con41 = -con42 - cosio2 - cosio2;
+        T posq = po * po;
+        T rp = ao * (T(1) - ecco);
+
+        // --- sgp4init (parte near-earth) ---
+        T ss = T(78.0 / RADIUS_KM + 1.0);
+        T qzms2t = T(pow((120.0 - 78.0) / RADIUS_KM, 4));
+
+        isimp = (rp < T(220.0 / RADIUS_KM + 1.0)) ? T(1) : T(0);
+        T sfour = ss;
+        T qzms24 = qzms2t;
+        T perige = (rp - T(1)) * T(RADIUS_KM);
+        if (perige < T(156)) {
+            sfour = perige - T(78);
+            if (perige < T(98)) sfour = T(20);
+            qzms24 = pow((T(120) - sfour) / T(RADIUS_KM), T(4));
+            sfour = sfour / T(RADIUS_KM) + T(1);
+        }
+        T pinvsq = T(1) / posq;
+        T tsi = T(1) / (ao - sfour);
+        eta = ao * ecco * tsi;
+        T etasq = eta * eta;
+        T eeta = ecco * eta;
+        T psisq = fabs(T(1) - etasq);
+        T coef = qzms24 * pow(tsi, T(4));
+        T coef1 = coef / pow(psisq, T(3.5));
+        T cc2 = coef1 * noUnkozai * (ao * (T(1) + T(1.5) * etasq + eeta * (T(4) + etasq)) +
+                T(0.375) * j2 * tsi / psisq * con41 * (T(8) + T(3) * etasq * (T(8) + etasq)));
+        cc1 = bstar * cc2;
+        T cc3 = T(0);
+        if (ecco > T(1.0e-4)) cc3 = T(-2) * coef * tsi * j3oj2 * noUnkozai * sinio / ecco;
+        x1mth2 = T(1) - cosio2;
+        cc4 = T(2) * noUnkozai * coef1 * ao * omeosq *
+              (eta * (T(2) + T(0.5) * etasq) + ecco * (T(0.5) + T(2) * etasq) -
+               j2 * tsi / (ao * psisq) *
+               (T(-3) * con41 * (T(1) - T(2) * eeta + etasq * (T(1.5) - T(0.5) * eeta)) +
+                T(0.75) * x1mth2 * (T(2) * etasq - eeta * (T(1) + etasq)) * cos(T(2) * argpo)));
+        cc5 = T(2) * coef1 * ao * omeosq * (T(1) + T(2.75) * (etasq + eeta) + eeta * etasq);
+        T cosio4 = cosio2 * cosio2;
+        T temp1 = T(1.5) * j2 * pinvsq * noUnkozai;
+        T temp2 = T(0.5) * temp1 * j2 * pinvsq;
+        T temp3 = T(-0.46875) * j4 * pinvsq * pinvsq * noUnkozai;
+        mdot = noUnkozai + T(0.5) * temp1 * rteosq * con41 +
+               T(0.0625) * temp2 * rteosq * (T(13) - T(78) * cosio2 + T(137) * cosio4);
+        argpdot = T(-0.5) * temp1 * con42 + T(0.0625) * temp2 * (T(7) - T(114) * cosio2 + T(395) * cosio4) +
+                  temp3 * (T(3) - T(36) * cosio2 + T(49) * cosio4);
+        T xhdot1 = -temp1 * cosio;
+        nodedot = xhdot1 + (T(0.5) * temp2 * (T(4) - T(19) * cosio2) + T(2) * temp3 * (T(3) - T(7) * cosio2)) * cosio;
+        omgcof = bstar * cc3 * cos(argpo);
+        xmcof = T(0);
+        if (ecco > T(1.0e-4)) xmcof = -x2o3 * coef * bstar / eeta;
+        nodecf = T(3.5) * omeosq * xhdot1 * cc1;
+        t2cof = T(1.5) * cc1;
+        if (fabs(cosio + T(1)) > T(1.5e-12)) {
+            xlcof = T(-0.25) * j3oj2 * sinio * (T(3) + T(5) * cosio) / (T(1) + cosio);
+        } else {
+            xlcof = T(-0.25) * j3oj2 * sinio * (T(3) + T(5) * cosio) / temp4;
+        }
+        aycof = T(-0.5) * j3oj2 * sinio;
+        T delmotemp = T(1) + eta * cos(mo);
+        delmo = delmotemp * delmotemp * delmotemp;
+        sinmao = sin(mo);
+        x7thm1 = T(7) * cosio2 - T(1);
+
+        if (isimp == T(0)) {
+            T cc1sq = cc1 * cc1;
+            d2 = T(4) * ao * tsi * cc1sq;
+            T temp = d2 * tsi * cc1 / T(3);
+            d3 = (T(17) * ao + sfour) * temp;
+            d4 = T(0.5) * temp * ao * tsi * (T(221) * ao + T(31) * sfour) * cc1;
+            t3cof = d2 + T(2) * cc1sq;
+            t4cof = T(0.25) * (T(3) * d3 + cc1 * (T(12) * d2 + T(10) * cc1sq));
+            t5cof = T(0.2) * (T(3) * d4 + T(12) * cc1 * d3 + T(6) * d2 * d2 + T(15) * cc1sq * (T(2) * d2 + cc1sq));
+        } else {
+            d2 = d3 = d4 = t3cof = t4cof = t5cof = T(0);
+        }
+        initialized = true;
+        return SGP4_OK;
+    }
+
+    bool isInitialized() const { return initialized; }
+    double getEpochJd() const { return epochJd; }
+
+    // Minutos desde a epoca para um instante (dia juliano)
+    double minutesSinceEpoch(double jd) const { return (jd - epochJd) * 1440.0; }
+
+    // Posicao (km) e velocidade (km/s) no referencial TEME
+    int propagate(double tsinceMin, T r[3], T v[3]) const {
+        const T twoPi = T(TWO_PI);
+        const T x2o3 = T(2.0) / T(3.0);
+        const T t = T(tsinceMin);
+
+        // Termos seculares (gravidade e arrasto)
+        T xmdf = mo + mdot * t;
+        T argpdf = argpo + argpdot * t;
+        T nodedf = nodeo + nodedot * t;
+        T argpm = argpdf;
+        T mm = xmdf;
+        T t2 = t * t;
+        T nodem = nodedf + nodecf * t2;
+        T tempa = T(1) - cc1 * t;
+        T tempe = bstar * cc4 * t;
+        T templ = t2cof * t2;
+
+        if (isimp == T(0)) {
+            T delomg = omgcof * t;
+            T delmtemp = T(1) + eta * cos(xmdf);
+            T delm = xmcof * (delmtemp * delmtemp * delmtemp - delmo);
+            T temp = delomg + delm;
+            mm = xmdf + temp;
+            argpm = argpdf - temp;
+            T t3 = t2 * t;
+            T t4 = t3 * t;
+            tempa = tempa - d2 * t2 - d3 * t3 - d4 * t4;
+            tempe = tempe + bstar * cc5 * (sin(mm) - sinmao);
+            templ = templ + t3cof * t3 + t4 * (t4cof + t * t5cof);
+        }
+
+        T nm = noUnkozai;
+        T em = ecco;
+        if (nm <= T(0)) return SGP4_ERR_MEAN_MOTION;
+        T am = pow(xke / nm, x2o3) * tempa * tempa;
+        nm = xke / pow(am, T(1.5));
+        em = em - tempe;
+        if (em >= T(1) || em < T(-0.001)) return SGP4_ERR_ECCENTRICITY;
+        if (em < T(1.0e-6)) em = T(1.0e-6);
+        mm = mm + noUnkozai * templ;
+        T xlm = mm + argpm + nodem;
+
+        nodem = fmod(nodem, twoPi);
+        argpm = fmod(argpm, twoPi);
+        xlm = fmod(xlm, twoPi);
+        mm = fmod(xlm - argpm - nodem, twoPi);
+
+        T sinim = sin(inclo);
+        T cosim = cos(inclo);
+
+        // Termos periodicos longos
+        T axnl = em * cos(argpm);
+        T temp = T(1) / (am * (T(1) - em * em));
+        T aynl = em * sin(argpm) + temp * aycof;
+        T xl = mm + argpm + nodem + temp * xlcof * axnl;
+
+        // Equacao de Kepler (Newton-Raphson limitado)
+        T u = fmod(xl - nodem, twoPi);
+        T eo1 = u;
+        T tem5 = T(9999.9);
+        T sineo1 = T(0), coseo1 = T(1);
+        for (int ktr = 1; fabs(tem5) >= T(1.0e-12) && ktr <= 10; ktr++) {
+            sineo1 = sin(eo1);
+            coseo1 = cos(eo1);
+            tem5 = T(1) - coseo1 * axnl - sineo1 * aynl;
+            tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+            if (fabs(tem5) >= T(0.95)) tem5 = tem5 > T(0) ? T(0.95) : T(-0.95);
+            eo1 = eo1 + tem5;
+        }
+
+        // Termos periodicos curtos
+        T ecose = axnl * coseo1 + aynl * sineo1;
+        T esine = axnl * sineo1 - aynl * coseo1;
+        T el2 = axnl * axnl + aynl * aynl;
+        T pl = am * (T(1) - el2);
+        if (pl < T(0)) return SGP4_ERR_SEMILATUS;
+
+        T rl = am * (T(1) - ecose);
+        T rdotl = sqrt(am) * esine / rl;
+        T rvdotl = sqrt(pl) / rl;
+        T betal = sqrt(T(1) - el2);
+        temp = esine / (T(1) + betal);
+        T sinu = am / rl * (sineo1 - aynl - axnl * temp);
+        T cosu = am / rl * (coseo1 - axnl + aynl * temp);
+        T su = atan2(sinu, cosu);
+        T sin2u = (cosu + cosu) * sinu;
+        T cos2u = T(1) - T(2) * sinu * sinu;
+        temp = T(1) / pl;
+        T temp1 = T(0.5) * j2 * temp;
+        T temp2 = temp1 * temp;
+
+        T mrt = rl * (T(1) - T(1.5) * temp2 * betal * con41) + T(0.5) * temp1 * x1mth2 * cos2u;
+        su = su - T(0.25) * temp2 * x7thm1 * sin2u;
+        T xnode = nodem + T(1.5) * temp2 * cosim * sin2u;
+        T xinc = inclo + T(1.5) * temp2 * cosim * sinim * cos2u;
+        T mvt = rdotl - nm * temp1 * x1mth2 * sin2u / xke;
+        T rvdot = rvdotl + nm * temp1 * (x1mth2 * cos2u + T(1.5) * con41) / xke;
+
+        // Vetores unitarios de orientacao
+        T sinsu = sin(su), cossu = cos(su);
+        T snod = sin(xnode), cnod = cos(xnode);
+        T sini = sin(xinc), cosi = cos(xinc);
+        T xmx = -snod * cosi;
+        T xmy = cnod * cosi;
+        T ux = xmx * sinsu + cnod * cossu;
+        T uy = xmy * sinsu + snod * cossu;
+        T uz = sini * sinsu;
+        T vx = xmx * cossu - cnod * sinsu;
+        T vy = xmy * cossu - snod * sinsu;
+        T vz = sini * cossu;
+
+        const T radius = T(RADIUS_KM);
+        const T vkmpersec = T(RADIUS_KM) * xke / T(60);
+        r[0] = mrt * ux * radius;
+        r[1] = mrt * uy * radius;
+        r[2] = mrt * uz * radius;
+        v[0] = (mvt * ux + rvdot * vx) * vkmpersec;
+        v[1] = (mvt * uy + rvdot * vy) * vkmpersec;
+        v[2] = (mvt * uz + rvdot * vz) * vkmpersec;
+
+        if (mrt < T(1)) return SGP4_ERR_DECAYED;
+        return SGP4_OK;
+    }
+};
+
+#endif
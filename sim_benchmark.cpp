@@ -0,0 +1,197 @@
+#include "sim_benchmark.h"
+#include "config.h"
+#if MT6701_ENABLED
+#include "absolute_encoder.h"
+#endif
+
+SimBenchmark simBenchmark;
+
+// Roteiro dos cenarios (posicoes no referencial absoluto ±180° do moveToAngle)
+static const SimScenario SCENARIOS[] = {
+    // nome               inicio   alvo    realvo  t_realvo  vento  t_ini  t_fim
+    {"passo 5",            0.0,    5.0,    NAN,    0,        0.0,   0,     0},
+    {"passo 45",           0.0,   45.0,    NAN,    0,        0.0,   0,     0},
+    {"passo 179",        -90.0,   89.0,    NAN,    0,        0.0,   0,     0},
+    {"caminho longo",    170.0, -170.0,    NAN,    0,        0.0,   0,     0},  // Protecao do cabo: 340° CCW
+    {"vento 90",           0.0,   90.0,    NAN,    0,       80.0, 500,  4000},
+    {"realvo no meio",     0.0,  120.0,   30.0, 1500,        0.0,   0,     0},
+};
+static const int SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+void SimBenchmark::begin(MotorController* motorController, Encoder* enc) {
+    motor = motorController;
+    encoder = enc;
+}
+
+bool SimBenchmark::start() {
+    if (running || motor == nullptr) return false;
+    running = true;
+    xTaskCreatePinnedToCore(taskEntry, "SimBench", 4096, this, 1, &taskHandle, 1);
+    return true;
+}
+
+bool SimBenchmark::isRunning() {
+    return running;
+}
+
+void SimBenchmark::taskEntry(void* param) {
+    SimBenchmark* self = static_cast<SimBenchmark*>(param);
+    self->runAll();
+    self->running = false;
+    self->taskHandle = NULL;
+    vTaskDelete(NULL);
+}
+
+void SimBenchmark::recordUpdateTime(uint32_t us) {
+    if (!running) return;
+    updateSumUs += us;
+    updateCount++;
+    if (us > updateMaxUs) updateMaxUs = us;
+}
+
+void SimBenchmark::waitIdle() {
+    while (motor->isInMotion()) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    vTaskDelay(pdMS_TO_TICKS(200)); // Deixar filtros do encoder assentarem
+}
+
+// moveToAngle so enfileira: esperar a motorTask aplicar antes de ler o alvo
+void SimBenchmark::commandMove(float target) {
+    uint32_t applied = motor->getCommandsApplied();
+    motor->moveToAngle(target, COMMAND_SOURCE_BENCH);
+    while (motor->getCommandsApplied() == applied) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+}
+
+// Eixo simulado sem ruido, com as mesmas inversoes do Encoder
+float SimBenchmark::truePositionDeg() {
+    float degrees = plantSimulator.getPositionDeg();
+    #if INVERT_ENCODER_DIRECTION
+    degrees = -degrees;
+    #endif
+    if (encoder->isRuntimeInverted()) degrees = -degrees;
+    return degrees;
+}
+
+void SimBenchmark::runAll() {
+    Serial.println("\n[SIM] Iniciando benchmark de cenarios...");
+    resultCount = 0;
+    for (int i = 0; i < SCENARIO_COUNT && i < SIM_MAX_SCENARIOS; i++) {
+        runScenario(SCENARIOS[i], results[i]);
+        resultCount = i + 1;
+        Serial.printf("[SIM] %-16s concluido em %lu ms\n", SCENARIOS[i].name, results[i].settleMs);
+    }
+    printReport();
+}
+
+void SimBenchmark::runScenario(const SimScenario& scenario, SimScenarioResult& result) {
+    memset(&result, 0, sizeof(result));
+    result.name = scenario.name;
+
+    waitIdle();
+    plantSimulator.setWind(0.0f);
+    // Mesmo fluxo da calibracao: encoder acumulado e posicao absoluta coincidem
+    encoder->setCalibrationOffset(scenario.startAbsolute - encoder->getRawAngle());
+    motor->resetAbsolutePosition(scenario.startAbsolute);
+    #if MT6701_ENABLED
+    absoluteEncoder.rephase();  // Posicao teleportada: o eixo simulado nao mudou
+    #endif
+    vTaskDelay(pdMS_TO_TICKS(50)); // Tracking absoluto reinicializa no proximo update
+
+    uint32_t pulsesBefore = motor->getPulseCycleCount();
+    // Posicao real no referencial absoluto: deslocamento do eixo desde aqui
+    float trueStart = truePositionDeg();
+    float absoluteStart = motor->getAbsolutePosition();
+    updateSumUs = 0;
+    updateCount = 0;
+    updateMaxUs = 0;
+
+    unsigned long start = millis();
+    unsigned long lastCommand = start;
+    commandMove(scenario.target);
+
+    float targetAbs = motor->getTargetAbsolutePosition();
+    result.movementDeg = targetAbs - motor->getAbsolutePosition();
+    float direction = (result.movementDeg >= 0.0f) ? 1.0f : -1.0f;
+    float overshoot = 0.0f;
+    bool retargetPending = !isnan(scenario.retarget);
+    bool windActive = false;
+
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+        unsigned long elapsed = millis() - start;
+
+        if (retargetPending && elapsed >= scenario.retargetAtMs) {
+            float absNow = motor->getAbsolutePosition();
+            commandMove(scenario.retarget);
+            targetAbs = motor->getTargetAbsolutePosition();
+            result.movementDeg = targetAbs - absNow;
+            direction = (result.movementDeg >= 0.0f) ? 1.0f : -1.0f;
+            overshoot = 0.0f;
+            lastCommand = millis();
+            retargetPending = false;
+        }
+
+        if (scenario.windPWM != 0.0f) {
+            bool windNow = elapsed >= scenario.windStartMs && elapsed < scenario.windEndMs;
+            if (windNow != windActive) {
+                plantSimulator.setWind(windNow ? scenario.windPWM : 0.0f);
+                windActive = windNow;
+            }
+        }
+
+        // Ultrapassagem medida no referencial absoluto, no sentido do movimento
+        float position = absoluteStart + (truePositionDeg() - trueStart);
+        float past = (position - targetAbs) * direction;
+        if (past > overshoot) overshoot = past;
+
+        if (!retargetPending && !motor->isInMotion()) break;
+
+        if (elapsed > SIM_SCENARIO_TIMEOUT_MS) {
+            motor->stop(COMMAND_SOURCE_BENCH);
+            result.timedOut = true;
+            break;
+        }
+    }
+
+    result.settleMs = millis() - lastCommand;
+    plantSimulator.setWind(0.0f);
+
+    vTaskDelay(pdMS_TO_TICKS(50));
+    result.finalErrorDeg = fabs(absoluteStart + (truePositionDeg() - trueStart) - targetAbs);
+    result.overshootDeg = overshoot;
+    result.pulseCycles = motor->getPulseCycleCount() - pulsesBefore;
+    result.updateAvgUs = updateCount > 0 ? updateSumUs / updateCount : 0;
+    result.updateMaxUs = updateMaxUs;
+}
+
+void SimBenchmark::printReport() {
+    Serial.println("\n=================== BENCHMARK SIMULADO ===================");
+    Serial.println("Cenario           Mov(°)  Acomod(ms)  Over(°)  Erro(°)  Pulsos  CPU med/max(us)");
+    for (int i = 0; i < resultCount; i++) {
+        const SimScenarioResult& r = results[i];
+        Serial.printf("%-16s %7.1f  %10lu  %7.3f  %7.3f  %6u  %5u/%u%s\n",
+                      r.name, r.movementDeg, r.settleMs, r.overshootDeg, r.finalErrorDeg,
+                      (unsigned)r.pulseCycles, (unsigned)r.updateAvgUs, (unsigned)r.updateMaxUs,
+                      r.timedOut ? "  TIMEOUT" : "");
+    }
+    Serial.println("==========================================================\n");
+}
+
+void SimBenchmark::writeResultsJSON(JsonArray out) {
+    for (int i = 0; i < resultCount; i++) {
+        const SimScenarioResult& r = results[i];
+        JsonObject o = out.createNestedObject();
+        o["name"] = r.name;
+        o["movement"] = r.movementDeg;
+        o["settleMs"] = r.settleMs;
+        o["overshoot"] = r.overshootDeg;
+        o["finalError"] = r.finalErrorDeg;
+        o["pulseCycles"] = r.pulseCycles;
+        o["updateAvgUs"] = r.updateAvgUs;
+        o["updateMaxUs"] = r.updateMaxUs;
+        o["timedOut"] = r.timedOut;
+    }
+}
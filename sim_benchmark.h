@@ -0,0 +1,79 @@
+#ifndef SIM_BENCHMARK_H
+#define SIM_BENCHMARK_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "encoder.h"
+#include "motor_control.h"
+#include "plant_simulator.h"
+
+// ==================================================================================
+// BENCHMARK DE CENARIOS DE MOVIMENTO (roda contra o PlantSimulator)
+// ==================================================================================
+// Executa o MotorController::update() real contra o modelo fisico e mede:
+// tempo de acomodacao, overshoot, ciclos na zona de pulsos e CPU por update.
+// Overshoot e erro final saem da posicao real do eixo simulado, nao da
+// estimativa do controlador (filtro/observador tambem estao sendo avaliados).
+
+struct SimScenario {
+    const char* name;
+    float startAbsolute;          // Posicao absoluta inicial (graus, ±180)
+    float target;                 // Alvo (mesmo referencial do moveToAngle)
+    float retarget;               // Novo alvo no meio do movimento (NAN = sem)
+    unsigned long retargetAtMs;
+    float windPWM;                // Perturbacao equivalente em PWM (0 = sem vento)
+    unsigned long windStartMs;
+    unsigned long windEndMs;
+};
+
+struct SimScenarioResult {
+    const char* name;
+    float movementDeg;            // Deslocamento comandado (caminho escolhido pelo controlador)
+    unsigned long settleMs;       // Comando -> motor parado
+    float overshootDeg;           // Maior ultrapassagem do alvo no sentido do movimento
+    float finalErrorDeg;          // Erro absoluto apos parar
+    uint32_t pulseCycles;         // Pulsos ON emitidos na zona de pulsos
+    uint32_t updateAvgUs;         // CPU media por ciclo (encoder + motor)
+    uint32_t updateMaxUs;
+    bool timedOut;
+};
+
+#define SIM_MAX_SCENARIOS 8
+
+class SimBenchmark {
+private:
+    MotorController* motor = nullptr;
+    Encoder* encoder = nullptr;
+    TaskHandle_t taskHandle = NULL;
+    volatile bool running = false;
+
+    // Estatisticas de CPU alimentadas pela motorTask
+    volatile uint32_t updateSumUs = 0;
+    volatile uint32_t updateCount = 0;
+    volatile uint32_t updateMaxUs = 0;
+
+    SimScenarioResult results[SIM_MAX_SCENARIOS];
+    int resultCount = 0;
+
+    static void taskEntry(void* param);
+    void runAll();
+    void runScenario(const SimScenario& scenario, SimScenarioResult& result);
+    void waitIdle();
+    void commandMove(float target);
+    float truePositionDeg();
+
+public:
+    void begin(MotorController* motorController, Encoder* enc);
+    bool start();
+    bool isRunning();
+    void recordUpdateTime(uint32_t us);
+    void printReport();
+    void writeResultsJSON(JsonArray out);
+    int getResultCount() { return resultCount; }
+    const SimScenarioResult& getResult(int index) { return results[index]; }
+};
+
+extern SimBenchmark simBenchmark;
+
+#endif
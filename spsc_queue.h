@@ -0,0 +1,69 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// ==================================================================================
+// FILA SEM BLOQUEIO DE UM PRODUTOR / UM CONSUMIDOR (anel)
+// ==================================================================================
+// O produtor so escreve head e o consumidor so escreve tail, entao nenhum dos
+// dois espera pelo outro: push() e pop() sao O(1) e nunca travam a motorTask.
+// N deve ser potencia de 2 (indices livres, mascarados na leitura).
+// Um slot fica sempre livre para distinguir cheio de vazio: capacidade = N - 1.
+template <typename T, uint32_t N>
+class SpscQueue {
+    static_assert((N & (N - 1)) == 0, "SpscQueue: N deve ser potencia de 2");
+
+private:
+    T slots[N];
+    std::atomic<uint32_t> head{0};     // Proximo slot a escrever (produtor)
+    std::atomic<uint32_t> tail{0};     // Proximo slot a ler (consumidor)
+    std::atomic<uint32_t> drops{0};    // push() com a fila cheia
+
+public:
+    bool push(const T& item) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) >= N - 1) {
+            drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slots[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) return false;
+        item = slots[t & (N - 1)];
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Marca do produtor (posicao do proximo push), para descartar o que veio antes
+    uint32_t producerPosition() {
+        return head.load(std::memory_order_relaxed);
+    }
+
+    // Consumidor: joga fora os itens empurrados antes da marca; retorna quantos
+    uint32_t discardBefore(uint32_t mark) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t h = head.load(std::memory_order_acquire);
+        uint32_t count = 0;
+        while (t != h && (int32_t)(mark - t) > 0) {
+            t++;
+            count++;
+        }
+        tail.store(t, std::memory_order_release);
+        return count;
+    }
+
+    uint32_t size() {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_acquire);
+    }
+
+    uint32_t getDrops() { return drops.load(std::memory_order_relaxed); }
+};
+
+#endif
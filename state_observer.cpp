@@ -0,0 +1,45 @@
+#include "state_observer.h"
+
+StateObserver::StateObserver() {
+    beta = OBSERVER_ALPHA * OBSERVER_ALPHA / (2.0f - OBSERVER_ALPHA);
+}
+
+void StateObserver::update(float measuredDeg, int signedPWM, float dt, const ControlTuning& tuning) {
+    if (!initialized) {
+        position = measuredDeg;
+        velocity = 0.0f;
+        residual = 0.0f;
+        initialized = true;
+        return;
+    }
+
+    // Previsao: velocidade de regime do feedforward para o PWM aplicado
+    float modelVelocity = 0.0f;
+    float tau = OBSERVER_BRAKE_TIME_CONSTANT_S;
+    if (signedPWM != 0) {
+        float drive = max(abs(signedPWM) - tuning.ffStaticPWM, 0) / tuning.ffPwmPerDps;
+        modelVelocity = signedPWM > 0 ? drive : -drive;
+        tau = tuning.timeConstantS;
+    }
+    position += velocity * dt;
+    velocity += (modelVelocity - velocity) * dt / (tau + dt);
+
+    // Correcao pela contagem bruta
+    residual = measuredDeg - position;
+    if (fabs(residual) > OBSERVER_RESYNC_DEG) {
+        // Salto que o modelo nao explica (reset do encoder, inversao): recomeca na medida
+        position = measuredDeg;
+        velocity = 0.0f;
+        resyncs++;
+        return;
+    }
+    position += OBSERVER_ALPHA * residual;
+    velocity += beta / dt * residual;
+}
+
+void StateObserver::writeJSON(JsonObject out) {
+    out["positionDeg"] = position;
+    out["velocityDps"] = velocity;
+    out["residualDeg"] = residual;
+    out["resyncs"] = resyncs;
+}
@@ -0,0 +1,43 @@
+#ifndef STATE_OBSERVER_H
+#define STATE_OBSERVER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "config.h"
+#include "autotune.h"
+
+// ==================================================================================
+// OBSERVADOR DE ESTADO (alfa-beta com entrada de PWM)
+// ==================================================================================
+// A mediana 3 + media movel do encoder atrasa o angulo alguns ciclos. O
+// observador preve posicao e velocidade pelo PWM aplicado no ciclo anterior,
+// com o mesmo modelo de 1a ordem do feedforward (atrito, ganho e constante de
+// tempo de ControlTuning), e corrige com a contagem bruta:
+//
+//   previsao:  x += v*dt;  v += (v_modelo(u) - v) * dt / (tau + dt)
+//   correcao:  r = z - x;  x += alfa*r;  v += (beta/dt)*r
+//
+// beta = alfa^2 / (2 - alfa) (Benedict-Bordner). O erro do modelo (vento,
+// setor pegajoso) vira residuo e a correcao de velocidade absorve. Com PWM 0 o
+// modelo freia com OBSERVER_BRAKE_TIME_CONSTANT_S. Float, ~20 operacoes por ciclo.
+class StateObserver {
+private:
+    float position = 0.0f;         // Graus, referencial da contagem (sem offset)
+    float velocity = 0.0f;         // Graus/s
+    float residual = 0.0f;         // Medida - previsao do ultimo ciclo
+    bool initialized = false;
+    uint32_t resyncs = 0;
+    float beta;
+
+public:
+    StateObserver();
+    void reset() { initialized = false; }
+    // signedPWM: + = CW (contagem crescente), aplicado desde a ultima chamada
+    void update(float measuredDeg, int signedPWM, float dt, const ControlTuning& tuning);
+
+    float getPosition() { return position; }
+    float getVelocity() { return velocity; }
+    void writeJSON(JsonObject out);
+};
+
+#endif
@@ -1,35 +1,359 @@
 #include "storage.h"
 #include "config.h"
+#include "crc32.h"
+#include "deferred_log.h"
+#include <stddef.h>
 
 StorageManager::StorageManager() {
+    setDefaults();
+    flushed = state;
 }
 
 bool StorageManager::begin() {
     // Abre namespace "rotor" em modo leitura/escrita
     bool success = preferences.begin("rotor", false);
+    flashMutex = xSemaphoreCreateMutex();
+    
+    if (success) {
+        if (readRecord()) {
+            if (!dirty) loadSource = "record";
+        } else {
+            migrateLegacyKeys();
+        }
+        readSectorTable();
+    }
     
     #if DEBUG_SERIAL
     if (success) {
-        Serial.println("Storage initialized");
+        Serial.printf("Storage initialized (estado: %s, %u bytes)\n", loadSource, (unsigned)sizeof(StateRecord));
     } else {
         Serial.println("Storage initialization failed!");
     }
     #endif
     
+    // Write-behind no Core 0, abaixo da motorTask (commit NVS bloqueia por ms)
+    xTaskCreatePinnedToCore(writeBehindEntry, "StorageWB", 3072, this, 1, &writeBehindTask, 0);
+    
     return success;
 }
 
-void StorageManager::saveLastPosition(float angle) {
-    preferences.putFloat(POSITION_KEY, angle);
+// ==================================================================================
+// REGISTRO DE ESTADO: CRC, MIGRACAO E WRITE-BEHIND
+// ==================================================================================
+
+void StorageManager::setDefaults() {
+    memset(&state, 0, sizeof(state));
+    state.magic = STATE_RECORD_MAGIC;
+    state.version = STATE_RECORD_VERSION;
+    state.inertiaFactor = 1.0;       // Sem compensação
+    state.brakingDistance = 0.1;     // 0.1 grau de frenagem por grau/s
+    state.tuning = defaultControlTuning();
+}
+
+bool StorageManager::readRecord() {
+    size_t length = preferences.getBytesLength(STATE_RECORD_KEY);
+    if (length == STATE_RECORD_V1_SIZE || length == STATE_RECORD_V2_SIZE || length == STATE_RECORD_V3_SIZE) {
+        return readLegacyRecord(length);
+    }
+    if (length != sizeof(StateRecord)) return false;
     
-    #if DEBUG_SERIAL
-    Serial.print("Position saved: ");
-    Serial.println(angle);
-    #endif
+    StateRecord record;
+    preferences.getBytes(STATE_RECORD_KEY, &record, sizeof(record));
+    if (record.magic != STATE_RECORD_MAGIC || record.version != STATE_RECORD_VERSION) return false;
+    if (record.crc != crc32Ieee((const uint8_t*)&record, offsetof(StateRecord, crc))) {
+        loadSource = "crc_error";
+        Serial.println("Storage: registro de estado com CRC invalido, usando padroes");
+        return false;
+    }
+    
+    state = record;
+    flushed = record;
+    return true;
+}
+
+// Versoes anteriores: mesmo layout ate o campo que cada uma acrescentou
+bool StorageManager::readLegacyRecord(size_t length) {
+    uint8_t version = length == STATE_RECORD_V1_SIZE ? 1 : length == STATE_RECORD_V2_SIZE ? 2 : 3;
+    uint8_t raw[STATE_RECORD_V3_SIZE];
+    preferences.getBytes(STATE_RECORD_KEY, raw, length);
+    const size_t fieldsSize = length - sizeof(uint32_t);
+    uint32_t crc;
+    memcpy(&crc, raw + fieldsSize, sizeof(crc));
+    
+    StateRecord record;
+    memcpy(&record, raw, fieldsSize);
+    if (record.magic != STATE_RECORD_MAGIC || record.version != version) return false;
+    if (crc != crc32Ieee(raw, fieldsSize)) {
+        loadSource = "crc_error";
+        Serial.println("Storage: registro de estado com CRC invalido, usando padroes");
+        return false;
+    }
+    
+    record.version = STATE_RECORD_VERSION;
+    if (version < 2) {
+        record.valid &= ~STATE_VALID_TUNING;
+        record.tuning = defaultControlTuning();
+    }
+    if (version < 3) {
+        record.valid &= ~STATE_VALID_BRAKING;
+        memset(record.braking, 0, sizeof(record.braking));
+    }
+    record.valid &= ~STATE_VALID_ABS_PHASE;
+    record.absolutePhase = 0.0f;
+    state = record;
+    static const char* const SOURCES[] = {"migrated_v1", "migrated_v2", "migrated_v3"};
+    loadSource = SOURCES[version - 1];
+    // Regravar ja no formato novo
+    dirty = true;
+    dirtySinceMs = millis();
+    Serial.printf("Storage: registro v%u atualizado para v%u\n", version, STATE_RECORD_VERSION);
+    return true;
+}
+
+void StorageManager::migrateLegacyKeys() {
+    // Firmware anterior: uma chave NVS por valor
+    static const char* LEGACY_KEYS[] = {
+        POSITION_KEY, "lasttarget", "abspos", CALIBRATION_KEY,
+        "inertia_f", "brake_dist", "overshoot", "learn_cyc"
+    };
+    bool corrupt = strcmp(loadSource, "crc_error") == 0;
+    setDefaults();
+    
+    bool found = false;
+    for (const char* key : LEGACY_KEYS) {
+        if (preferences.isKey(key)) found = true;
+    }
+    if (!found) {
+        flushed = state;
+        return;
+    }
+    
+    if (preferences.isKey(POSITION_KEY)) {
+        state.lastPosition = preferences.getFloat(POSITION_KEY, 0.0);
+        state.valid |= STATE_VALID_POSITION;
+    }
+    state.lastTarget = preferences.getFloat("lasttarget", 0.0);
+    state.absolutePosition = preferences.getFloat("abspos", 0.0);
+    if (preferences.isKey(CALIBRATION_KEY)) {
+        state.calibrationOffset = preferences.getFloat(CALIBRATION_KEY, 0.0);
+        state.valid |= STATE_VALID_CALIBRATION;
+    }
+    if (preferences.isKey("inertia_f")) {
+        state.inertiaFactor = preferences.getFloat("inertia_f", 1.0);
+        state.valid |= STATE_VALID_LEARNING;
+    }
+    state.brakingDistance = preferences.getFloat("brake_dist", 0.1);
+    state.overshootHistory = preferences.getFloat("overshoot", 0.0);
+    state.learningCycles = preferences.getInt("learn_cyc", 0);
+    
+    // Gravar o registro antes de apagar as chaves antigas
+    dirty = true;
+    flush();
+    if (!dirty) {
+        for (const char* key : LEGACY_KEYS) preferences.remove(key);
+        loadSource = corrupt ? "crc_error" : "migrated";
+        Serial.println("Storage: chaves antigas migradas para o registro unico");
+    }
+}
+
+void StorageManager::readSectorTable() {
+    if (preferences.getBytesLength(DYNAMICS_NVS_KEY) != sizeof(SectorTableRecord)) return;
+    SectorTableRecord table;
+    preferences.getBytes(DYNAMICS_NVS_KEY, &table, sizeof(table));
+    if (table.crc != crc32Ieee((const uint8_t*)&table, offsetof(SectorTableRecord, crc))) {
+        Serial.println("Storage: tabela de setores com CRC invalido, descartada");
+        return;
+    }
+    sectorTable = table;
+    sectorTableValid = true;
+}
+
+void StorageManager::markDirtyLocked() {
+    if (!pendingLocked()) dirtySinceMs = millis();
+    dirty = true;
+    updateCount++;
+}
+
+void StorageManager::flush() {
+    if (flashMutex && xSemaphoreTake(flashMutex, portMAX_DELAY) != pdTRUE) return;
+    
+    StateRecord snapshot;
+    SectorTableRecord tableSnapshot;
+    char name[STORAGE_SAT_NAME_MAX];
+    char line1[STORAGE_TLE_LINE_MAX];
+    char line2[STORAGE_TLE_LINE_MAX];
+    float lat = 0.0f, lon = 0.0f, alt = 0.0f;
+    portENTER_CRITICAL(&stateMux);
+    bool wasDirty = dirty;
+    bool tableWasDirty = sectorTableDirty;
+    bool tleWasDirty = tleDirty;
+    bool qthWasDirty = qthDirty;
+    snapshot = state;
+    if (tableWasDirty) tableSnapshot = sectorTable;
+    if (tleWasDirty) {
+        memcpy(name, tleName, sizeof(name));
+        memcpy(line1, tleLine1, sizeof(line1));
+        memcpy(line2, tleLine2, sizeof(line2));
+    }
+    if (qthWasDirty) {
+        lat = qthLat;
+        lon = qthLon;
+        alt = qthAlt;
+    }
+    dirty = false;
+    sectorTableDirty = false;
+    tleDirty = false;
+    qthDirty = false;
+    portEXIT_CRITICAL(&stateMux);
+    
+    if (wasDirty) {
+        snapshot.crc = crc32Ieee((const uint8_t*)&snapshot, offsetof(StateRecord, crc));
+        if (memcmp(&snapshot, &flushed, sizeof(snapshot)) == 0) {
+            skippedFlushes++;  // Ex.: alvo repetido, posicao salva de novo no mesmo lugar
+        } else {
+            uint32_t start = micros();
+            size_t written = preferences.putBytes(STATE_RECORD_KEY, &snapshot, sizeof(snapshot));
+            uint32_t elapsed = micros() - start;
+            lastFlushUs = elapsed;
+            if (elapsed > maxFlushUs) maxFlushUs = elapsed;
+            
+            if (written == sizeof(snapshot)) {
+                flushed = snapshot;
+                flashWrites++;
+                flashBytes += written;
+                #if DEBUG_SERIAL
+                LOG_INFO("Estado gravado na NVS (%u us)", (unsigned)elapsed);
+                #endif
+            } else {
+                // Falha: tentar de novo na proxima janela
+                portENTER_CRITICAL(&stateMux);
+                if (!dirty) {
+                    dirty = true;
+                    dirtySinceMs = millis();
+                }
+                portEXIT_CRITICAL(&stateMux);
+                LOG_ERROR("Storage: falha ao gravar registro de estado");
+            }
+        }
+    }
+    
+    // Tabela de setores: so quando mudou (aprendizado), o resto do tempo nao grava
+    if (tableWasDirty) {
+        tableSnapshot.crc = crc32Ieee((const uint8_t*)&tableSnapshot, offsetof(SectorTableRecord, crc));
+        size_t written = preferences.putBytes(DYNAMICS_NVS_KEY, &tableSnapshot, sizeof(tableSnapshot));
+        if (written == sizeof(tableSnapshot)) {
+            flashWrites++;
+            flashBytes += written;
+        } else {
+            portENTER_CRITICAL(&stateMux);
+            if (!pendingLocked()) dirtySinceMs = millis();
+            sectorTableDirty = true;
+            portEXIT_CRITICAL(&stateMux);
+            LOG_ERROR("Storage: falha ao gravar tabela de setores");
+        }
+    }
+    
+    // TLE/QTH do rastreador: raros, chaves proprias fora do registro
+    if (tleWasDirty) {
+        const char* keys[] = { "sat_name", "sat_tle1", "sat_tle2" };
+        const char* values[] = { name, line1, line2 };
+        bool ok = true;
+        size_t tleBytes = 0;
+        for (int i = 0; i < 3; i++) {
+            size_t written = preferences.putString(keys[i], values[i]);
+            if (written != strlen(values[i])) {
+                ok = false;
+                continue;
+            }
+            flashWrites++;
+            tleBytes += written;
+        }
+        flashBytes += tleBytes;
+        if (ok) {
+            #if DEBUG_SERIAL
+            LOG_INFO("TLE gravada na NVS (%u bytes)", (unsigned)tleBytes);  // Sem o nome: %s so com literal
+            #endif
+        } else {
+            portENTER_CRITICAL(&stateMux);
+            if (!pendingLocked()) dirtySinceMs = millis();
+            tleDirty = true;
+            portEXIT_CRITICAL(&stateMux);
+            LOG_ERROR("Storage: falha ao gravar TLE");
+        }
+    }
+    if (qthWasDirty) {
+        const char* keys[] = { "qth_lat", "qth_lon", "qth_alt" };
+        float values[] = { lat, lon, alt };
+        bool ok = true;
+        for (int i = 0; i < 3; i++) {
+            size_t written = preferences.putFloat(keys[i], values[i]);
+            if (written != sizeof(float)) {
+                ok = false;
+                continue;
+            }
+            flashWrites++;
+            flashBytes += written;
+        }
+        if (ok) {
+            #if DEBUG_SERIAL
+            LOG_INFO("QTH gravado: %.5f, %.5f, %.0fm", lat, lon, alt);
+            #endif
+        } else {
+            portENTER_CRITICAL(&stateMux);
+            if (!pendingLocked()) dirtySinceMs = millis();
+            qthDirty = true;
+            portEXIT_CRITICAL(&stateMux);
+            LOG_ERROR("Storage: falha ao gravar QTH");
+        }
+    }
+    
+    if (flashMutex) xSemaphoreGive(flashMutex);
+}
+
+void StorageManager::writeBehindEntry(void* param) {
+    StorageManager* self = static_cast<StorageManager*>(param);
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(STORAGE_WRITEBACK_POLL_MS));
+        portENTER_CRITICAL(&self->stateMux);
+        bool due = self->pendingLocked() &&
+                   (millis() - self->dirtySinceMs >= STORAGE_WRITEBACK_DELAY_MS);
+        portEXIT_CRITICAL(&self->stateMux);
+        if (due) self->flush();
+    }
+}
+
+void StorageManager::writeStatsJSON(JsonObject out) {
+    portENTER_CRITICAL(&stateMux);
+    bool pending = pendingLocked();
+    uint32_t updates = updateCount;
+    portEXIT_CRITICAL(&stateMux);
+    
+    out["source"] = loadSource;
+    out["recordBytes"] = (uint32_t)sizeof(StateRecord);
+    out["sectorTableBytes"] = (uint32_t)sizeof(SectorTableRecord);
+    out["updates"] = updates;
+    out["flashWrites"] = flashWrites;
+    out["flashBytes"] = flashBytes;
+    out["skippedFlushes"] = skippedFlushes;
+    out["pending"] = pending;
+    out["lastFlushUs"] = lastFlushUs;
+    out["maxFlushUs"] = maxFlushUs;
+}
+
+// ==================================================================================
+// POSICAO, ALVO E CALIBRACAO (somente RAM; a gravacao fica com o write-behind)
+// ==================================================================================
+
+void StorageManager::saveLastPosition(float angle) {
+    portENTER_CRITICAL(&stateMux);
+    state.lastPosition = angle;
+    state.valid |= STATE_VALID_POSITION;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadLastPosition() {
-    float angle = preferences.getFloat(POSITION_KEY, 0.0);
+    float angle = state.lastPosition;
     
     #if DEBUG_SERIAL
     Serial.print("Position loaded: ");
@@ -40,24 +364,25 @@ float StorageManager::loadLastPosition() {
 }
 
 void StorageManager::saveLastTarget(float angle) {
-    preferences.putFloat("lasttarget", angle);
+    portENTER_CRITICAL(&stateMux);
+    state.lastTarget = angle;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadLastTarget() {
-    return preferences.getFloat("lasttarget", 0.0);
+    return state.lastTarget;
 }
 
 void StorageManager::saveAbsolutePosition(float angle) {
-    preferences.putFloat("abspos", angle);
-    
-    #if DEBUG_SERIAL
-    Serial.print("Absolute position saved: ");
-    Serial.println(angle);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.absolutePosition = angle;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadAbsolutePosition() {
-    float angle = preferences.getFloat("abspos", 0.0);
+    float angle = state.absolutePosition;
     
     #if DEBUG_SERIAL
     Serial.print("Absolute position loaded: ");
@@ -68,16 +393,15 @@ float StorageManager::loadAbsolutePosition() {
 }
 
 void StorageManager::saveCalibrationOffset(float offset) {
-    preferences.putFloat(CALIBRATION_KEY, offset);
-    
-    #if DEBUG_SERIAL
-    Serial.print("Calibration offset saved: ");
-    Serial.println(offset);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.calibrationOffset = offset;
+    state.valid |= STATE_VALID_CALIBRATION;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadCalibrationOffset() {
-    float offset = preferences.getFloat(CALIBRATION_KEY, 0.0);
+    float offset = state.calibrationOffset;
     
     #if DEBUG_SERIAL
     Serial.print("Calibration offset loaded: ");
@@ -88,11 +412,11 @@ float StorageManager::loadCalibrationOffset() {
 }
 
 bool StorageManager::hasLastPosition() {
-    return preferences.isKey(POSITION_KEY);
+    return (state.valid & STATE_VALID_POSITION) != 0;
 }
 
 bool StorageManager::hasCalibrationOffset() {
-    return preferences.isKey(CALIBRATION_KEY);
+    return (state.valid & STATE_VALID_CALIBRATION) != 0;
 }
 
 // ==================================================================================
@@ -100,59 +424,212 @@ bool StorageManager::hasCalibrationOffset() {
 // ==================================================================================
 
 void StorageManager::saveInertiaFactor(float factor) {
-    preferences.putFloat("inertia_f", factor);
-    #if DEBUG_SERIAL
-    Serial.printf("Inertia factor saved: %.3f\n", factor);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.inertiaFactor = factor;
+    state.valid |= STATE_VALID_LEARNING;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadInertiaFactor() {
     // Default 1.0 = sem compensação. Valores > 1.0 = motor com mais inércia
-    return preferences.getFloat("inertia_f", 1.0);
+    return state.inertiaFactor;
 }
 
 void StorageManager::saveBrakingDistance(float distance) {
-    preferences.putFloat("brake_dist", distance);
-    #if DEBUG_SERIAL
-    Serial.printf("Braking distance saved: %.3f deg/(deg/s)\n", distance);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.brakingDistance = distance;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadBrakingDistance() {
     // Default: 0.1 graus de frenagem para cada grau/segundo de velocidade
-    return preferences.getFloat("brake_dist", 0.1);
+    return state.brakingDistance;
 }
 
 void StorageManager::saveOvershootHistory(float avgOvershoot) {
-    preferences.putFloat("overshoot", avgOvershoot);
-    #if DEBUG_SERIAL
-    Serial.printf("Average overshoot saved: %.3f deg\n", avgOvershoot);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.overshootHistory = avgOvershoot;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 float StorageManager::loadOvershootHistory() {
-    return preferences.getFloat("overshoot", 0.0);
+    return state.overshootHistory;
 }
 
 void StorageManager::saveLearningCycles(int cycles) {
-    preferences.putInt("learn_cyc", cycles);
-    #if DEBUG_SERIAL
-    Serial.printf("Learning cycles saved: %d\n", cycles);
-    #endif
+    portENTER_CRITICAL(&stateMux);
+    state.learningCycles = cycles;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
 }
 
 int StorageManager::loadLearningCycles() {
-    return preferences.getInt("learn_cyc", 0);
+    return state.learningCycles;
 }
 
 bool StorageManager::hasLearnedParameters() {
-    return preferences.isKey("inertia_f") && loadLearningCycles() > 0;
+    return (state.valid & STATE_VALID_LEARNING) && loadLearningCycles() > 0;
+}
+
+// ==================================================================================
+// AJUSTE DO CONTROLE (AUTOTUNE)
+// ==================================================================================
+
+void StorageManager::saveControlTuning(const ControlTuning& tuning) {
+    portENTER_CRITICAL(&stateMux);
+    state.tuning = tuning;
+    state.valid |= STATE_VALID_TUNING;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadControlTuning(ControlTuning& tuning) {
+    if (!(state.valid & STATE_VALID_TUNING)) {
+        tuning = defaultControlTuning();
+        return false;
+    }
+    tuning = state.tuning;
+    return true;
+}
+
+void StorageManager::clearControlTuning() {
+    portENTER_CRITICAL(&stateMux);
+    state.tuning = defaultControlTuning();
+    state.valid &= ~STATE_VALID_TUNING;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
+}
+
+void StorageManager::saveBrakingModels(const BrakingModelState models[2]) {
+    portENTER_CRITICAL(&stateMux);
+    memcpy(state.braking, models, sizeof(state.braking));
+    state.valid |= STATE_VALID_BRAKING;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadBrakingModels(BrakingModelState models[2]) {
+    if (!(state.valid & STATE_VALID_BRAKING)) return false;
+    memcpy(models, state.braking, sizeof(state.braking));
+    return true;
+}
+
+void StorageManager::saveAbsolutePhase(float phaseDeg) {
+    portENTER_CRITICAL(&stateMux);
+    state.absolutePhase = phaseDeg;
+    state.valid |= STATE_VALID_ABS_PHASE;
+    markDirtyLocked();
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadAbsolutePhase(float& phaseDeg) {
+    if (!(state.valid & STATE_VALID_ABS_PHASE)) return false;
+    phaseDeg = state.absolutePhase;
+    return true;
+}
+
+void StorageManager::saveSectorTable(const SectorTableRecord& table) {
+    portENTER_CRITICAL(&stateMux);
+    sectorTable = table;
+    sectorTableValid = true;
+    if (!pendingLocked()) dirtySinceMs = millis();
+    sectorTableDirty = true;
+    updateCount++;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadSectorTable(SectorTableRecord& table) {
+    if (!sectorTableValid) return false;
+    table = sectorTable;
+    return true;
+}
+
+// ==================================================================================
+// RASTREIO DE SATELITES
+// ==================================================================================
+
+static void copyText(char* dst, const char* src, size_t size) {
+    strncpy(dst, src, size - 1);
+    dst[size - 1] = '\0';
+}
+
+// Handlers /api/sat/*: so a copia em RAM (o write-behind grava as chaves proprias)
+void StorageManager::saveSatelliteTle(const char* name, const char* line1, const char* line2) {
+    portENTER_CRITICAL(&stateMux);
+    copyText(tleName, name, sizeof(tleName));
+    copyText(tleLine1, line1, sizeof(tleLine1));
+    copyText(tleLine2, line2, sizeof(tleLine2));
+    if (!pendingLocked()) dirtySinceMs = millis();
+    tleDirty = true;
+    updateCount++;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadSatelliteTle(char* name, size_t nameSize, char* line1, char* line2, size_t lineSize) {
+    // Ainda nao gravada: a copia em RAM e a mais recente
+    portENTER_CRITICAL(&stateMux);
+    bool staged = tleDirty;
+    if (staged) {
+        copyText(name, tleName, nameSize);
+        copyText(line1, tleLine1, lineSize);
+        copyText(line2, tleLine2, lineSize);
+    }
+    portEXIT_CRITICAL(&stateMux);
+    if (staged) return true;
+    
+    if (!preferences.isKey("sat_tle1") || !preferences.isKey("sat_tle2")) return false;
+    name[0] = '\0';
+    preferences.getString("sat_name", name, nameSize);
+    preferences.getString("sat_tle1", line1, lineSize);
+    preferences.getString("sat_tle2", line2, lineSize);
+    return true;
+}
+
+void StorageManager::saveQth(float latDeg, float lonDeg, float altMeters) {
+    portENTER_CRITICAL(&stateMux);
+    qthLat = latDeg;
+    qthLon = lonDeg;
+    qthAlt = altMeters;
+    if (!pendingLocked()) dirtySinceMs = millis();
+    qthDirty = true;
+    updateCount++;
+    portEXIT_CRITICAL(&stateMux);
+}
+
+bool StorageManager::loadQth(float& latDeg, float& lonDeg, float& altMeters) {
+    portENTER_CRITICAL(&stateMux);
+    bool staged = qthDirty;
+    latDeg = qthLat;
+    lonDeg = qthLon;
+    altMeters = qthAlt;
+    portEXIT_CRITICAL(&stateMux);
+    if (staged) return true;
+    
+    if (!preferences.isKey("qth_lat")) return false;
+    latDeg = preferences.getFloat("qth_lat", 0.0);
+    lonDeg = preferences.getFloat("qth_lon", 0.0);
+    altMeters = preferences.getFloat("qth_alt", 0.0);
+    return true;
 }
 
 void StorageManager::clearAll() {
+    xSemaphoreTake(flashMutex, portMAX_DELAY);
     preferences.clear();
+    portENTER_CRITICAL(&stateMux);
+    setDefaults();
+    flushed = state;
+    dirty = false;
+    sectorTableValid = false;
+    sectorTableDirty = false;
+    tleDirty = false;
+    qthDirty = false;
+    portEXIT_CRITICAL(&stateMux);
+    xSemaphoreGive(flashMutex);
     
     #if DEBUG_SERIAL
-    Serial.println("Storage cleared");
+    LOG_INFO("Storage cleared");
     #endif
 }
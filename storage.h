@@ -3,15 +3,122 @@
 
 #include <Arduino.h>
 #include <Preferences.h>
+#include <ArduinoJson.h>
+#include <stddef.h>
 #include "config.h"
+#include "autotune.h"
+#include "braking_model.h"
+#include "sector_dynamics.h"
+
+// ==================================================================================
+// REGISTRO UNICO DE ESTADO (NVS)
+// ==================================================================================
+// Posicao, alvo, calibracao e aprendizado ficam num unico blob versionado com
+// CRC32. Os save*() so atualizam a copia em RAM e marcam como sujo; a task de
+// write-behind grava o registro inteiro de uma vez, agrupando as atualizacoes
+// de STORAGE_WRITEBACK_DELAY_MS. TLE e QTH do rastreador (chaves proprias)
+// seguem o mesmo caminho. Assim handlers web nunca esperam a flash.
+// Ao mudar o layout: incrementar STATE_RECORD_VERSION (versao antiga = migra
+// das chaves individuais, se ainda existirem, ou volta aos padroes).
+
+#define STATE_RECORD_MAGIC 0x5253      // 'RS'
+#define STATE_RECORD_VERSION 4
+// Versoes anteriores sao prefixos desta (campos novos vao antes do CRC) e
+// migram no boot: v1 = ate learningCycles, v2 = + ControlTuning, v3 = + frenagem
+#define STATE_RECORD_V1_SIZE 40
+#define STATE_RECORD_V2_SIZE 71
+#define STATE_RECORD_V3_SIZE 195
+#define STATE_RECORD_KEY "state"
+
+// TLE/QTH do rastreador: chaves NVS proprias, tamanhos de sat_tracker.h
+#define STORAGE_SAT_NAME_MAX 25
+#define STORAGE_TLE_LINE_MAX 70
+
+// Bits de validRecord.valid (equivalente ao isKey() das chaves antigas)
+#define STATE_VALID_POSITION     0x01
+#define STATE_VALID_CALIBRATION  0x02
+#define STATE_VALID_LEARNING     0x04
+#define STATE_VALID_TUNING       0x08
+#define STATE_VALID_BRAKING      0x10
+#define STATE_VALID_ABS_PHASE    0x20
+
+struct __attribute__((packed)) StateRecord {
+    uint16_t magic;
+    uint8_t version;
+    uint8_t valid;                 // STATE_VALID_*
+    float lastPosition;
+    float lastTarget;
+    float absolutePosition;
+    float calibrationOffset;
+    float inertiaFactor;
+    float brakingDistance;
+    float overshootHistory;
+    int32_t learningCycles;
+    ControlTuning tuning;          // Versao 2: resultado do autotune
+    BrakingModelState braking[2];  // Versao 3: modelo de frenagem CW, CCW
+    float absolutePhase;           // Versao 4: angulo do MT6701 na posicao absoluta 0 (graus do eixo)
+    uint32_t crc;                  // CRC32 de todos os bytes anteriores
+};
+
+static_assert(sizeof(StateRecord) == 199, "StateRecord: layout gravado na flash");
+static_assert(offsetof(StateRecord, tuning) == STATE_RECORD_V1_SIZE - 4, "StateRecord: v2 estende a v1");
+static_assert(offsetof(StateRecord, braking) == STATE_RECORD_V2_SIZE - 4, "StateRecord: v3 estende a v2");
+static_assert(offsetof(StateRecord, absolutePhase) == STATE_RECORD_V3_SIZE - 4, "StateRecord: v4 estende a v3");
 
 class StorageManager {
 private:
     Preferences preferences;
     
+    // Copia em RAM (fonte da verdade) e ultima versao gravada
+    portMUX_TYPE stateMux = portMUX_INITIALIZER_UNLOCKED;
+    StateRecord state;
+    StateRecord flushed;
+    bool dirty = false;
+    uint32_t dirtySinceMs = 0;
+    
+    // Tabela de dinamica por setor: blob proprio (DYNAMICS_NVS_KEY), mesmo write-behind
+    SectorTableRecord sectorTable;
+    bool sectorTableValid = false;
+    bool sectorTableDirty = false;
+    
+    // TLE e QTH novos (acao do usuario): copia em RAM ate o write-behind gravar
+    char tleName[STORAGE_SAT_NAME_MAX] = "";
+    char tleLine1[STORAGE_TLE_LINE_MAX] = "";
+    char tleLine2[STORAGE_TLE_LINE_MAX] = "";
+    float qthLat = 0.0f;
+    float qthLon = 0.0f;
+    float qthAlt = 0.0f;
+    bool tleDirty = false;
+    bool qthDirty = false;
+    
+    // Metricas de desgaste da flash
+    uint32_t updateCount = 0;          // Chamadas save*() (antes: uma gravacao cada)
+    uint32_t flashWrites = 0;          // Commits NVS (registro + TLE/QTH)
+    uint32_t flashBytes = 0;
+    uint32_t skippedFlushes = 0;       // Registro sujo mas igual ao gravado
+    uint32_t lastFlushUs = 0;
+    uint32_t maxFlushUs = 0;
+    const char* loadSource = "defaults";   // "record", "migrated", "migrated_vN", "crc_error" ou "defaults"
+    
+    SemaphoreHandle_t flashMutex = NULL;   // flush() da task vs flush() explicito
+    TaskHandle_t writeBehindTask = NULL;
+    
+    static void writeBehindEntry(void* param);
+    void setDefaults();
+    void migrateLegacyKeys();
+    bool readRecord();
+    bool readLegacyRecord(size_t length);
+    void readSectorTable();
+    void markDirtyLocked();            // Chamar com stateMux
+    bool pendingLocked() { return dirty || sectorTableDirty || tleDirty || qthDirty; }
+    
 public:
     StorageManager();
     bool begin();
+    void flush();                                // Grava ja o que estiver pendente (antes de reiniciar)
+    void writeStatsJSON(JsonObject out);
+    uint32_t getFlashWrites() { return flashWrites; }
+    uint32_t getFlashBytes() { return flashBytes; }
     void saveLastPosition(float angle);
     float loadLastPosition();
     void saveLastTarget(float angle);
@@ -32,6 +139,29 @@ public:
     int loadLearningCycles();
     bool hasLearnedParameters();                 // Verifica se já aprendeu algo
     
+    // Ajuste do controle (autotune)
+    void saveControlTuning(const ControlTuning& tuning);
+    bool loadControlTuning(ControlTuning& tuning);   // false = padroes do config.h
+    void clearControlTuning();
+    
+    // Modelo de frenagem (RLS, um por sentido)
+    void saveBrakingModels(const BrakingModelState models[2]);
+    bool loadBrakingModels(BrakingModelState models[2]);
+    
+    // Fase do encoder absoluto (MT6701) em relacao a posicao absoluta
+    void saveAbsolutePhase(float phaseDeg);
+    bool loadAbsolutePhase(float& phaseDeg);
+    
+    // Dinamica por setor de azimute (blob separado do registro de estado)
+    void saveSectorTable(const SectorTableRecord& table);
+    bool loadSectorTable(SectorTableRecord& table);
+    
+    // Rastreio de satelites
+    void saveSatelliteTle(const char* name, const char* line1, const char* line2);
+    bool loadSatelliteTle(char* name, size_t nameSize, char* line1, char* line2, size_t lineSize);
+    void saveQth(float latDeg, float lonDeg, float altMeters);
+    bool loadQth(float& latDeg, float& lonDeg, float& altMeters);
+    
     bool hasLastPosition();
     bool hasCalibrationOffset();
     void clearAll();
@@ -0,0 +1,41 @@
+#include "telemetry.h"
+#include <stddef.h>
+
+// Campos variaveis do TelemetryFrame, na ordem dos bits da mascara delta
+static const uint8_t FIELD_OFFSETS[TELEMETRY_FIELD_COUNT] = {
+    offsetof(TelemetryFrame, angleCdeg),
+    offsetof(TelemetryFrame, targetCdeg),
+    offsetof(TelemetryFrame, errorMdeg),
+    offsetof(TelemetryFrame, absPositionCdeg),
+    offsetof(TelemetryFrame, calibrationCdeg),
+    offsetof(TelemetryFrame, learningCycles),
+    offsetof(TelemetryFrame, inertiaMilli),
+    offsetof(TelemetryFrame, brakingE4)
+};
+static const uint8_t FIELD_SIZES[TELEMETRY_FIELD_COUNT] = { 2, 4, 4, 4, 4, 2, 2, 2 };
+
+size_t telemetryEncodeDelta(const TelemetryFrame& prev, const TelemetryFrame& cur, uint8_t* out) {
+    const uint8_t* a = (const uint8_t*)&prev;
+    const uint8_t* b = (const uint8_t*)&cur;
+    size_t pos = TELEMETRY_DELTA_HEADER_SIZE;
+    uint8_t mask = 0;
+
+    for (int i = 0; i < TELEMETRY_FIELD_COUNT; i++) {
+        const uint8_t off = FIELD_OFFSETS[i];
+        const uint8_t size = FIELD_SIZES[i];
+        if (memcmp(a + off, b + off, size) != 0) {
+            mask |= (1 << i);
+            memcpy(out + pos, b + off, size);
+            pos += size;
+        }
+    }
+
+    if (mask == 0 && prev.flags == cur.flags) return 0;
+
+    out[0] = TELEMETRY_MAGIC;
+    out[1] = TELEMETRY_VERSION;
+    out[2] = TELEMETRY_TYPE_DELTA;
+    out[3] = cur.flags;
+    out[4] = mask;
+    return pos;
+}
@@ -0,0 +1,45 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+// ==================================================================================
+// FRAME BINARIO DE TELEMETRIA (WebSocket WS_BINARY)
+// ==================================================================================
+// Struct empacotada little-endian (nativo do ESP32), decodificada em app.js.
+// Clientes pedem o formato com {"format":"binary"}; os demais seguem em JSON.
+// Ao mudar o layout: incrementar TELEMETRY_VERSION e atualizar decodeTelemetry().
+
+#define TELEMETRY_MAGIC 0x52        // 'R'
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_TYPE_STATUS 1     // Frame completo de status (keyframe)
+#define TELEMETRY_TYPE_DELTA 2      // Cabecalho + mascara + apenas os campos que mudaram
+
+struct __attribute__((packed)) TelemetryFrame {
+    uint8_t magic;
+    uint8_t version;
+    uint8_t type;
+    uint8_t flags;                  // MOTOR_FLAG_* (motor_control.h)
+    int16_t angleCdeg;              // Angulo atual (centesimos de grau, ±180°)
+    int32_t targetCdeg;             // Alvo no referencial acumulado do encoder
+    int32_t errorMdeg;              // Erro normalizado (milesimos de grau)
+    int32_t absPositionCdeg;        // Posicao absoluta (protecao do cabo)
+    int32_t calibrationCdeg;        // Offset de calibracao
+    uint16_t learningCycles;
+    uint16_t inertiaMilli;          // Fator de inercia x1000
+    uint16_t brakingE4;             // Distancia de frenagem x10000
+};
+
+static_assert(sizeof(TelemetryFrame) == 28, "TelemetryFrame: layout faz parte do protocolo");
+
+// Frame delta: magic, version, type, flags, mascara (bit i = campo i presente),
+// seguido dos campos marcados na mesma ordem e tamanho do TelemetryFrame.
+// E sempre relativo ao ultimo frame efetivamente enfileirado para aquele cliente.
+#define TELEMETRY_FIELD_COUNT 8
+#define TELEMETRY_DELTA_HEADER_SIZE 5
+#define TELEMETRY_DELTA_MAX_SIZE (TELEMETRY_DELTA_HEADER_SIZE + sizeof(TelemetryFrame) - 4)
+
+// Retorna o tamanho do frame delta em 'out' (0 = nada mudou desde 'prev')
+size_t telemetryEncodeDelta(const TelemetryFrame& prev, const TelemetryFrame& cur, uint8_t* out);
+
+#endif
@@ -0,0 +1,165 @@
+#include "trace_recorder.h"
+
+#if TRACE_ENABLED
+
+TraceRecorder traceRecorder;
+
+static const char* const STATE_NAMES[] = {"idle", "recording", "reading"};
+static const char* const ZONE_NAMES[] = {"idle", "manual", "coast", "profile", "trajectory", "pid", "pulse", "arrived", "autotune"};
+
+void TraceRecorder::begin() {
+    uint32_t count = TRACE_PSRAM_SAMPLES;
+    if (psramFound()) {
+        samples = (TraceSample*)ps_malloc(count * sizeof(TraceSample));
+        inPsram = samples != nullptr;
+    }
+    if (!samples) {
+        count = TRACE_FALLBACK_SAMPLES;
+        samples = (TraceSample*)malloc(count * sizeof(TraceSample));
+    }
+    capacity = samples ? count : 0;
+    Serial.printf("[Trace] %u amostras (%u KB) na %s\n", (unsigned)capacity,
+                  (unsigned)(capacity * sizeof(TraceSample) / 1024), inPsram ? "PSRAM" : "RAM interna");
+}
+
+// ==================================================================================
+// CAPTURA (motorTask)
+// ==================================================================================
+
+void TraceRecorder::startCapture(bool manual) {
+    if (capacity == 0) return;
+    uint8_t expected = TRACE_IDLE;
+    if (!state.compare_exchange_strong(expected, TRACE_RECORDING)) {
+        if (expected == TRACE_READING) skippedTriggers++;
+        // Ja gravando: o novo alvo entra na mesma captura
+        if (expected == TRACE_RECORDING && manual) manualCapture = true;
+        return;
+    }
+    written = 0;
+    startUs = micros();
+    startMs = millis();
+    lastMotionUs = startUs;
+    manualCapture = manual;
+    captures++;
+}
+
+void TraceRecorder::onMoveStarted() {
+    if (autoTrigger) startCapture(false);
+}
+
+bool TraceRecorder::service(bool inMotion) {
+    if (startRequested) {
+        startRequested = false;
+        startCapture(true);
+    }
+    if (state.load(std::memory_order_relaxed) != TRACE_RECORDING) {
+        stopRequested = false;
+        return false;
+    }
+
+    uint32_t now = micros();
+    if (inMotion) lastMotionUs = now;
+    bool settled = !manualCapture && (now - lastMotionUs) >= TRACE_POST_MOTION_MS * 1000UL;
+    if (stopRequested || settled) {
+        stopRequested = false;
+        // release: amostras visiveis para quem fizer beginRead()
+        state.store(TRACE_IDLE, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+// ==================================================================================
+// LEITURA (servidor web)
+// ==================================================================================
+
+bool TraceRecorder::beginRead() {
+    if (capacity == 0) return false;
+    if (state.load() == TRACE_RECORDING) {
+        // Mesmo esquema do profiler: pedir e esperar a motorTask atender
+        stopRequested = true;
+        for (int i = 0; i < 50 && state.load() == TRACE_RECORDING; i++) vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    uint8_t expected = TRACE_IDLE;
+    return state.compare_exchange_strong(expected, TRACE_READING, std::memory_order_acquire);
+}
+
+void TraceRecorder::endRead() {
+    state.store(TRACE_IDLE, std::memory_order_release);
+}
+
+uint32_t TraceRecorder::getCount() {
+    return min(written, capacity);
+}
+
+// Fluxo virtual: cabecalho + amostras da mais antiga para a mais nova
+size_t TraceRecorder::readBinary(uint32_t offset, uint8_t* out, size_t maxLen) {
+    uint32_t count = getCount();
+    uint32_t first = written - count;
+    size_t used = 0;
+
+    if (offset < sizeof(TraceFileHeader)) {
+        TraceFileHeader header;
+        memcpy(header.magic, "RTRC", 4);
+        header.version = 1;
+        header.sampleSize = sizeof(TraceSample);
+        header.count = count;
+        header.periodUs = CONTROL_LOOP_PERIOD_US;
+        header.startMs = startMs;
+        size_t n = min(sizeof(header) - offset, maxLen);
+        memcpy(out, (const uint8_t*)&header + offset, n);
+        used += n;
+        offset += n;
+    }
+
+    uint32_t total = sizeof(TraceFileHeader) + count * sizeof(TraceSample);
+    while (used < maxLen && offset < total) {
+        uint32_t byteInSamples = offset - sizeof(TraceFileHeader);
+        uint32_t index = byteInSamples / sizeof(TraceSample);
+        uint32_t within = byteInSamples % sizeof(TraceSample);
+        // Trecho contiguo ate o fim do anel
+        uint32_t slot = (first + index) & (capacity - 1);
+        size_t n = (capacity - slot) * sizeof(TraceSample) - within;
+        n = min(n, (size_t)(total - offset));
+        n = min(n, maxLen - used);
+        memcpy(out + used, (const uint8_t*)&samples[slot] + within, n);
+        used += n;
+        offset += n;
+    }
+    return used;
+}
+
+size_t TraceRecorder::formatCsvHeader(char* out, size_t size) {
+    int n = snprintf(out, size, "t_us,angle,error,vel_dps,target_pwm,current_pwm,abs_pos,zone,pulse_on,dir,control\n");
+    return n > 0 ? min((size_t)n, size - 1) : 0;
+}
+
+size_t TraceRecorder::formatCsvLine(uint32_t index, char* out, size_t size) {
+    uint32_t count = getCount();
+    if (index >= count) return 0;
+    const TraceSample& s = samples[(written - count + index) & (capacity - 1)];
+    int dir = (s.flags & TRACE_FLAG_DIR_CW) ? 1 : (s.flags & TRACE_FLAG_DIR_CCW) ? -1 : 0;
+    int n = snprintf(out, size, "%u,%.3f,%.3f,%.2f,%d,%d,%.2f,%s,%d,%d,%d\n",
+                     (unsigned)s.timeUs, s.angle, s.error, s.velDegPerSec, s.targetPWM, s.currentPWM,
+                     s.absolutePositionCenti / 100.0f, ZONE_NAMES[s.zone < TRACE_ZONE_COUNT ? s.zone : 0],
+                     (s.flags & TRACE_FLAG_PULSE_ON) ? 1 : 0, dir, (s.flags & TRACE_FLAG_CONTROL) ? 1 : 0);
+    return n > 0 ? min((size_t)n, size - 1) : 0;
+}
+
+void TraceRecorder::writeStatusJSON(JsonObject out) {
+    uint8_t current = state.load();
+    out["state"] = STATE_NAMES[current < 3 ? current : 0];
+    out["autoTrigger"] = (bool)autoTrigger;
+    out["capacity"] = capacity;
+    out["psram"] = inPsram;
+    out["sampleBytes"] = sizeof(TraceSample);
+    out["captures"] = captures;
+    out["skippedTriggers"] = skippedTriggers;
+    // Com a captura em andamento estes valores mudam a cada ciclo (so informativos)
+    uint32_t count = getCount();
+    out["samples"] = count;
+    out["overwritten"] = written - count;
+    out["durationMs"] = count > 0 ? samples[(written - 1) & (capacity - 1)].timeUs / 1000 : 0;
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <atomic>
+#include "config.h"
+
+// ==================================================================================
+// GRAVADOR DE TRACE DO MOVIMENTO (uma amostra por ciclo da motorTask)
+// ==================================================================================
+// Para ajustar o controle e preciso a serie temporal inteira, nao so o numero
+// final do benchmark. A motorTask grava 24 bytes por ciclo num anel na PSRAM
+// (sem PSRAM: anel pequeno na RAM interna). A gravacao e uma copia de struct,
+// sem lock nem alocacao; o custo aparece na etapa "trace" de /api/profile.
+//
+// Disparo: cada alvo ponto a ponto (se armado) ou manual; a captura termina
+// TRACE_POST_MOTION_MS depois que o motor para (manual: so com stop). Anel
+// cheio sobrescreve as amostras mais antigas.
+//
+// Leitura: o download muda o estado para READING; enquanto isso a motorTask
+// nao inicia captura nova (o disparo e perdido e contado), entao o servidor
+// le o anel direto, sem copia e sem lock no caminho de controle.
+
+enum TraceState : uint8_t {
+    TRACE_IDLE,                    // Parado (pode ter uma captura pronta)
+    TRACE_RECORDING,               // motorTask gravando
+    TRACE_READING                  // Download em andamento
+};
+
+enum TraceZone : uint8_t {
+    TRACE_ZONE_IDLE,
+    TRACE_ZONE_MANUAL,
+    TRACE_ZONE_COAST,              // Desacelerando depois de stop
+    TRACE_ZONE_PROFILE,            // Seguindo o perfil curva S
+    TRACE_ZONE_TRAJECTORY,
+    TRACE_ZONE_PID,
+    TRACE_ZONE_PULSE,
+    TRACE_ZONE_ARRIVED,            // Ciclo em que a chegada foi detectada
+    TRACE_ZONE_AUTOTUNE,           // Experimento do autotune (malha aberta)
+    TRACE_ZONE_COUNT
+};
+
+#define TRACE_FLAG_PULSE_ON   0x01 // Fase ON do gerador de pulsos
+#define TRACE_FLAG_DIR_CW     0x02 // Sentido aplicado na ponte H
+#define TRACE_FLAG_DIR_CCW    0x04
+#define TRACE_FLAG_LIMIT      0x08 // Posicao absoluta alem de ±180°
+#define TRACE_FLAG_CONTROL    0x10 // A lei de controle rodou neste ciclo (UPDATE_INTERVAL)
+
+struct TraceSample {
+    uint32_t timeUs;               // Desde o inicio da captura
+    float angle;                   // Angulo calibrado acumulado (sem normalizar)
+    float error;                   // Alvo (ou referencia da trajetoria) - posicao
+    float velDegPerSec;            // Velocidade publicada pelo encoder
+    int16_t targetPWM;
+    int16_t currentPWM;
+    int16_t absolutePositionCenti; // Posicao absoluta em centesimos de grau
+    uint8_t zone;                  // TraceZone
+    uint8_t flags;                 // TRACE_FLAG_*
+};
+
+static_assert(sizeof(TraceSample) == 24, "TraceSample: formato do download binario");
+
+// Cabecalho do download binario (seguido de count amostras, little-endian)
+struct __attribute__((packed)) TraceFileHeader {
+    char magic[4];                 // "RTRC"
+    uint16_t version;
+    uint16_t sampleSize;
+    uint32_t count;
+    uint32_t periodUs;             // Periodo nominal entre amostras
+    uint32_t startMs;              // millis() no inicio da captura
+};
+
+#if TRACE_ENABLED
+
+class TraceRecorder {
+private:
+    TraceSample* samples = nullptr;
+    uint32_t capacity = 0;         // Potencia de 2
+    bool inPsram = false;
+
+    std::atomic<uint8_t> state{TRACE_IDLE};
+    volatile bool autoTrigger = TRACE_AUTO_ON_MOVE;
+    volatile bool startRequested = false;
+    volatile bool stopRequested = false;
+
+    // Somente a motorTask (o leitor so acessa com o estado em READING)
+    uint32_t written = 0;          // Amostras da captura atual (inclui sobrescritas)
+    uint32_t startUs = 0;
+    uint32_t startMs = 0;
+    uint32_t lastMotionUs = 0;
+    bool manualCapture = false;
+    uint32_t captures = 0;
+    uint32_t skippedTriggers = 0;  // Disparos durante um download
+
+    void startCapture(bool manual);
+
+public:
+    void begin();                  // Aloca o anel (antes de criar a motorTask)
+
+    // motorTask: atende pedidos e fim da captura; true = gravar este ciclo
+    bool service(bool inMotion);
+    void onMoveStarted();          // Novo alvo ponto a ponto (motorTask)
+    inline void push(TraceSample& sample) {
+        sample.timeUs = micros() - startUs;
+        samples[written & (capacity - 1)] = sample;
+        written++;
+    }
+
+    // Outras tasks
+    void requestStart() { startRequested = true; }
+    void requestStop() { stopRequested = true; }
+    void setAutoTrigger(bool enable) { autoTrigger = enable; }
+    void writeStatusJSON(JsonObject out);
+
+    // Download: beginRead() para a captura em andamento e trava o anel ate endRead()
+    bool beginRead();
+    void endRead();
+    uint32_t getCount();
+    size_t readBinary(uint32_t offset, uint8_t* out, size_t maxLen);
+    static size_t formatCsvHeader(char* out, size_t size);
+    size_t formatCsvLine(uint32_t index, char* out, size_t size);
+};
+
+extern TraceRecorder traceRecorder;
+
+#endif
+
+#endif
@@ -179,15 +179,73 @@ let map, towerMarker, targetMarker, line;
 let towerPos = {lat: -22.8, lng: -47.0};
 let targetPos = null;
 
+// Frames binarios de telemetria (telemetry.h), little-endian:
+// tipo 1 = completo (campos a partir do byte 4), tipo 2 = delta (mascara no byte 4)
+const TELEMETRY_MAGIC = 0x52;
+const TELEMETRY_VERSION = 1;
+const FLAG_IN_MOTION = 0x04;
+const STREAM_HZ = 20;
+// [nome, bytes, escala, com sinal] na ordem dos bits da mascara
+const TELEMETRY_FIELDS = [
+    ['angle', 2, 100, true], ['target', 4, 100, true], ['error', 4, 1000, true],
+    ['absolutePosition', 4, 100, true], ['calibration', 4, 100, true],
+    ['learningCycles', 2, 1, false], ['inertia', 2, 1000, false], ['braking', 2, 10000, false]
+];
+let telemetry = null; // Ultimo estado completo (base dos deltas)
+
+function readTelemetryFields(v, pos, mask, out) {
+    for (let i = 0; i < TELEMETRY_FIELDS.length; i++) {
+        if (!(mask & (1 << i))) continue;
+        let [name, size, scale, signed] = TELEMETRY_FIELDS[i];
+        let raw = size === 4 ? v.getInt32(pos, true) : (signed ? v.getInt16(pos, true) : v.getUint16(pos, true));
+        out[name] = raw / scale;
+        pos += size;
+    }
+}
+
+function decodeTelemetry(buf) {
+    let v = new DataView(buf);
+    if (v.byteLength < 5 || v.getUint8(0) !== TELEMETRY_MAGIC || v.getUint8(1) !== TELEMETRY_VERSION) {
+        return null;
+    }
+    let type = v.getUint8(2);
+    if (type === 1 && v.byteLength >= 28) {
+        telemetry = {};
+        readTelemetryFields(v, 4, 0xFF, telemetry);
+    } else if (type === 2) {
+        if (!telemetry) return {}; // Aguardar keyframe
+        readTelemetryFields(v, 5, v.getUint8(4), telemetry);
+    } else {
+        return null;
+    }
+    telemetry.moving = (v.getUint8(3) & FLAG_IN_MOTION) !== 0;
+    return telemetry;
+}
+
 function connect() {
     ws = new WebSocket('ws://' + location.host + '/ws');
+    ws.binaryType = 'arraybuffer';
     ws.onopen = function() {
+        // Pedir telemetria binaria (menor e sem parse de texto) em streaming,
+        // para a bussola acompanhar a antena durante o movimento
+        telemetry = null;
+        send({format: 'binary', stream: STREAM_HZ});
         // Enviar configuracoes salvas apos conexao
         loadInvertSettings();
     };
     ws.onmessage = function(e) {
         try {
-            let d = JSON.parse(e.data);
+            let d;
+            if (e.data instanceof ArrayBuffer) {
+                d = decodeTelemetry(e.data);
+                if (!d) {
+                    // Versao desconhecida: voltar para JSON
+                    send({format: 'json'});
+                    return;
+                }
+            } else {
+                d = JSON.parse(e.data);
+            }
             
             // Se temos a chave 'angle', atualizar a posição
             if (d.angle !== undefined) {
@@ -0,0 +1,422 @@
+#pragma once
+// GERADO por build_web_assets.py a partir de web_assets.h - NAO EDITAR
+// Fonte: sha256 c27855303c067cbb
+// STYLE_CSS    3481 ->   1065 bytes (gzip), etag c145e680bb009afb
+// APP_JS      17885 ->   3811 bytes (gzip), etag e56c5970372eaf43
+// INDEX_HTML   4849 ->   1389 bytes (gzip), etag 513b1c7ac4ef0c3a
+
+#include <Arduino.h>
+
+const uint8_t STYLE_CSS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xad, 0x57, 0xeb, 0x6e, 0xa3, 0x3a,
+    0x10, 0xfe, 0x9f, 0xa7, 0xb0, 0x54, 0x55, 0xea, 0x1e, 0x15, 0x04, 0x24, 0x6c, 0xb3, 0xe4, 0xcf,
+    0x79, 0x15, 0x03, 0x86, 0x78, 0x0b, 0xb6, 0xe5, 0x4b, 0x93, 0x9c, 0x6a, 0xdf, 0xfd, 0x8c, 0x0d,
+    0x04, 0x73, 0xeb, 0x45, 0xda, 0x56, 0x8d, 0x88, 0x99, 0xf9, 0x66, 0xe6, 0x9b, 0x9b, 0xfb, 0x0f,
+    0x7a, 0x47, 0x39, 0xbf, 0x06, 0x8a, 0xfe, 0x47, 0x59, 0x9d, 0xc1, 0xb3, 0x2c, 0x89, 0x0c, 0xe0,
+    0xe8, 0x84, 0x5a, 0x2c, 0x6b, 0xca, 0x32, 0x14, 0x9d, 0x90, 0xc0, 0x65, 0xe9, 0xde, 0xc3, 0xf3,
+    0x9f, 0x5d, 0x26, 0x39, 0xd7, 0xe8, 0x7d, 0x17, 0x04, 0x42, 0x52, 0x90, 0xba, 0x65, 0xe8, 0x21,
+    0x8a, 0xca, 0x43, 0x55, 0x9d, 0x50, 0x10, 0x28, 0x52, 0x70, 0x56, 0x76, 0xa7, 0x2f, 0xc5, 0x1e,
+    0x93, 0xd2, 0x9e, 0x96, 0x98, 0xd5, 0x44, 0xc2, 0x11, 0xa9, 0x0e, 0xf0, 0xe3, 0x04, 0x4d, 0x51,
+    0x10, 0xa5, 0xe0, 0x2c, 0x49, 0x8a, 0x34, 0x25, 0x27, 0x00, 0xcc, 0x6b, 0x8b, 0x55, 0x45, 0x55,
+    0xb2, 0xb7, 0x22, 0x05, 0x96, 0x65, 0x86, 0x64, 0x9d, 0xe3, 0xa7, 0x24, 0x4d, 0x9f, 0x87, 0xbf,
+    0x28, 0x8c, 0xd2, 0x1f, 0xf6, 0xbd, 0x26, 0x57, 0x0d, 0x0a, 0x55, 0x67, 0xb9, 0x35, 0x9a, 0x80,
+    0xf8, 0xc3, 0xaf, 0x03, 0xde, 0xe7, 0xc7, 0xd3, 0xee, 0xcf, 0x2e, 0xe7, 0xe5, 0x0d, 0x22, 0xac,
+    0x38, 0xd3, 0x41, 0x85, 0x5b, 0xda, 0x80, 0x53, 0xea, 0xa6, 0x34, 0x69, 0x03, 0x43, 0x9f, 0x91,
+    0xc2, 0x4c, 0x81, 0xbf, 0x92, 0x82, 0x7a, 0x8e, 0x8b, 0xd7, 0x5a, 0x72, 0xc3, 0x00, 0xe1, 0x0d,
+    0xcb, 0x27, 0xeb, 0x0b, 0xd8, 0x28, 0x78, 0xc3, 0xe5, 0x70, 0x62, 0xcd, 0xfd, 0xf0, 0xd8, 0x88,
+    0x23, 0x71, 0xb5, 0x84, 0x84, 0x10, 0xb1, 0xc6, 0x94, 0x11, 0x09, 0xc6, 0x5a, 0x7c, 0x0d, 0x2e,
+    0xb4, 0xd4, 0xe7, 0x0c, 0xa5, 0x91, 0x13, 0xb8, 0x13, 0x89, 0xb0, 0xd1, 0xdc, 0x2a, 0x9c, 0x63,
+    0x10, 0xb4, 0x68, 0x01, 0x6e, 0x68, 0x0d, 0xaf, 0x0a, 0xc2, 0x34, 0x91, 0x33, 0x73, 0x3d, 0xbb,
+    0x60, 0xd1, 0x05, 0x00, 0x39, 0x22, 0x60, 0x33, 0x3c, 0x90, 0x76, 0xc0, 0x84, 0x44, 0x69, 0xcd,
+    0x5b, 0xb0, 0xd4, 0x3b, 0xa2, 0x4c, 0xae, 0xa9, 0x6e, 0xc8, 0x57, 0xe0, 0x1d, 0x5d, 0x53, 0xf0,
+    0x28, 0x3c, 0xae, 0x80, 0xc7, 0x03, 0xba, 0x4d, 0x87, 0x2d, 0x98, 0x05, 0x55, 0xf6, 0x05, 0x20,
+    0xf5, 0xd5, 0x23, 0x71, 0x49, 0x8d, 0x1a, 0xf4, 0x46, 0xb6, 0xd2, 0x91, 0x8c, 0x11, 0x3b, 0xf1,
+    0xb0, 0x83, 0xc1, 0xf7, 0x89, 0x4b, 0x2f, 0xd6, 0x25, 0x17, 0x8d, 0x96, 0x90, 0xb0, 0x8a, 0x4b,
+    0xd0, 0x33, 0x42, 0x10, 0x59, 0x60, 0x45, 0x36, 0x82, 0x9a, 0x9b, 0xb1, 0x89, 0xd8, 0xf5, 0xae,
+    0x04, 0x0d, 0xa9, 0xa0, 0x6c, 0x8e, 0xd6, 0x72, 0xef, 0x72, 0x77, 0xb2, 0x17, 0x57, 0xa4, 0x78,
+    0x43, 0xcb, 0x45, 0x02, 0xc0, 0x41, 0x28, 0xe0, 0x86, 0x04, 0x25, 0x55, 0xa2, 0xc1, 0xb7, 0x0d,
+    0x7e, 0x87, 0x4c, 0x27, 0x10, 0x6a, 0xd7, 0x2b, 0xbd, 0x5a, 0x4e, 0xeb, 0x69, 0x58, 0x2e, 0x89,
+    0xee, 0xfb, 0x85, 0xd0, 0xfa, 0xac, 0x6d, 0xeb, 0x35, 0xe5, 0x66, 0x01, 0xd8, 0xd4, 0x6a, 0xac,
+    0x8d, 0xda, 0x30, 0x3c, 0x21, 0xec, 0x97, 0xc5, 0x9e, 0x00, 0xf5, 0xad, 0xe6, 0xd7, 0xee, 0x71,
+    0xa8, 0x18, 0x07, 0x1b, 0xb6, 0xfc, 0x0d, 0x8e, 0x01, 0x7d, 0xc3, 0x01, 0xcc, 0xe0, 0x49, 0x53,
+    0x0e, 0x36, 0x85, 0x69, 0x14, 0x41, 0xb1, 0x42, 0x94, 0x55, 0x94, 0x51, 0x4d, 0x2c, 0xce, 0xbf,
+    0xaf, 0xe4, 0x56, 0x49, 0xdc, 0x12, 0xd5, 0xbf, 0x7f, 0x87, 0xea, 0x7f, 0x84, 0x4f, 0x2e, 0x70,
+    0x41, 0xf5, 0xcd, 0xfa, 0x95, 0x82, 0xe0, 0x54, 0x34, 0x6f, 0x28, 0x7b, 0x05, 0xa1, 0xe8, 0xf1,
+    0x19, 0x52, 0x34, 0x95, 0x8f, 0xad, 0xf4, 0x02, 0x63, 0xdf, 0x61, 0x84, 0x60, 0x19, 0x58, 0xd5,
+    0xcc, 0x12, 0xd2, 0xe7, 0x24, 0x43, 0x55, 0x43, 0x20, 0xa8, 0x1a, 0x8b, 0xbe, 0x21, 0xec, 0xf7,
+    0xe0, 0x22, 0xed, 0x77, 0xfb, 0x79, 0x42, 0xbf, 0x8d, 0xd2, 0xb4, 0xba, 0x05, 0xb6, 0x5f, 0x81,
+    0xb9, 0x65, 0xe2, 0x6c, 0x9d, 0xf4, 0x89, 0x1b, 0x2c, 0x80, 0x81, 0xb1, 0x84, 0xa1, 0x5a, 0x51,
+    0xfc, 0x73, 0x2c, 0x1c, 0x38, 0xba, 0xd7, 0xcc, 0xca, 0x98, 0x4a, 0x96, 0x4d, 0x61, 0x79, 0xdf,
+    0x6d, 0x76, 0xd0, 0xda, 0xb8, 0xf1, 0x9b, 0xdf, 0x65, 0xd6, 0x48, 0x65, 0x85, 0x04, 0xa7, 0x9d,
+    0xf3, 0x9e, 0xb3, 0x19, 0x2e, 0x34, 0x7d, 0x23, 0xab, 0x4d, 0x3a, 0x26, 0xb3, 0xb7, 0x02, 0x43,
+    0xbb, 0x0b, 0x95, 0x32, 0x61, 0x74, 0x20, 0xf9, 0x65, 0x83, 0xcc, 0xa3, 0xd7, 0xb8, 0x9a, 0x0b,
+    0x6f, 0xf0, 0x8d, 0x9a, 0xee, 0xc9, 0xd6, 0x38, 0xa8, 0xb9, 0xe4, 0x8d, 0xa4, 0x1d, 0xfe, 0x2a,
+    0x5f, 0x4e, 0x2d, 0x7a, 0x76, 0xbf, 0xe1, 0xfe, 0x0b, 0x9c, 0x85, 0xc9, 0x7d, 0x80, 0xcc, 0xba,
+    0x66, 0x19, 0x40, 0x56, 0xf1, 0xc2, 0x35, 0x19, 0x37, 0x1a, 0x6a, 0x13, 0xd4, 0x19, 0x67, 0xe4,
+    0xee, 0xd4, 0x76, 0x77, 0xce, 0x0b, 0x05, 0x62, 0x46, 0x49, 0xe4, 0x07, 0x3e, 0x01, 0xf2, 0xa3,
+    0x5b, 0x1d, 0x03, 0xf3, 0x1c, 0xcf, 0x8b, 0xa0, 0x33, 0x39, 0xf8, 0xf0, 0xcd, 0x7c, 0x5b, 0xcd,
+    0x6e, 0x21, 0xaf, 0x2a, 0x76, 0xaf, 0x3c, 0x3d, 0xb7, 0x5f, 0x7b, 0xbd, 0xfb, 0x7a, 0x9f, 0xa9,
+    0xae, 0x64, 0x33, 0xde, 0x48, 0x4e, 0x87, 0x34, 0x96, 0xaa, 0x37, 0xd6, 0x55, 0x81, 0x1b, 0xf2,
+    0x04, 0x23, 0x2c, 0xed, 0xe4, 0x84, 0x24, 0x8a, 0xe8, 0x49, 0x93, 0xd7, 0x92, 0x02, 0x41, 0xf6,
+    0x13, 0xf0, 0x5a, 0x38, 0xd3, 0xc4, 0xe6, 0xc5, 0xb4, 0x0c, 0xf8, 0x94, 0x44, 0x10, 0xac, 0x9f,
+    0x0e, 0x30, 0x4e, 0x2a, 0x1b, 0x81, 0x2b, 0xdf, 0x9f, 0xfe, 0x12, 0xf6, 0x3a, 0xbc, 0x03, 0x5f,
+    0xf4, 0x77, 0xfa, 0xe5, 0x72, 0x8d, 0xbf, 0xdb, 0xde, 0xab, 0x3b, 0xf9, 0x83, 0x54, 0xc3, 0x3e,
+    0x4e, 0xfb, 0x6c, 0x77, 0xce, 0x7a, 0xfd, 0xfd, 0x59, 0x45, 0xf6, 0xd1, 0x85, 0xe5, 0xf6, 0x50,
+    0x5f, 0x29, 0x3c, 0x50, 0x6c, 0x31, 0x33, 0xb8, 0xf9, 0x68, 0xb8, 0x76, 0xed, 0xff, 0xf9, 0x30,
+    0x1d, 0xb7, 0xa0, 0x8f, 0x99, 0x1b, 0xd8, 0xc9, 0x6c, 0x7d, 0x54, 0x40, 0xaa, 0xbc, 0x9e, 0x98,
+    0x2c, 0xb4, 0xcb, 0x19, 0x56, 0x4d, 0xa0, 0x60, 0x15, 0xb8, 0xae, 0xec, 0x06, 0xfa, 0x0c, 0x7a,
+    0x5a, 0xd9, 0x1d, 0x7e, 0x74, 0xbf, 0x77, 0xb5, 0x30, 0xbe, 0xfa, 0x9b, 0xd9, 0xb1, 0x1f, 0x60,
+    0x0f, 0x2d, 0x16, 0x20, 0x79, 0xee, 0x39, 0xd8, 0x47, 0x5e, 0xcb, 0x8e, 0xf7, 0x98, 0x64, 0xa3,
+    0x80, 0x40, 0xd9, 0x45, 0x2f, 0x79, 0xa3, 0xbe, 0x30, 0x3a, 0x27, 0x97, 0x91, 0xe5, 0x72, 0x9a,
+    0x03, 0x2e, 0x79, 0x5a, 0x09, 0xc0, 0xa9, 0xc0, 0x22, 0xe6, 0x6b, 0xed, 0x38, 0x4c, 0xc9, 0x74,
+    0x72, 0x69, 0x4d, 0x56, 0x42, 0xdc, 0xe0, 0xdc, 0xc7, 0x0f, 0xdf, 0x70, 0xf3, 0xdd, 0x52, 0xaa,
+    0x05, 0xdc, 0xaf, 0x87, 0x7b, 0xcb, 0xf2, 0x9e, 0xf9, 0xd1, 0xcd, 0xcd, 0xed, 0x99, 0xe1, 0xe2,
+    0xd9, 0x10, 0x0c, 0x24, 0xe8, 0x40, 0x70, 0x61, 0xc4, 0x50, 0x70, 0x8e, 0x3c, 0xb1, 0x98, 0x61,
+    0x0f, 0x31, 0x8e, 0x71, 0x42, 0x96, 0xd3, 0x6b, 0x0a, 0xa2, 0xa9, 0xd8, 0x52, 0xb4, 0xfb, 0x14,
+    0xfe, 0xc3, 0x71, 0xc8, 0x6b, 0x1d, 0x3b, 0xbb, 0xd1, 0x7e, 0x7e, 0xa9, 0x7e, 0xe9, 0xb8, 0xfc,
+    0x1f, 0x67, 0xdd, 0x1c, 0x4b, 0x6d, 0x0d, 0x00, 0x00,
+};
+
+const size_t STYLE_CSS_GZ_LEN = 1065;
+
+#define STYLE_CSS_ETAG "\"c145e680bb009afb\""
+
+const uint8_t APP_JS_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x5a, 0x4b, 0x73, 0xe3, 0xc6,
+    0x11, 0xbe, 0xf3, 0x57, 0x8c, 0xec, 0xb2, 0x01, 0x58, 0x14, 0x44, 0x72, 0x25, 0xed, 0x86, 0x5c,
+    0xad, 0x8b, 0xd6, 0xc3, 0x61, 0x8a, 0x5a, 0x6d, 0x24, 0xca, 0x4e, 0xac, 0x6c, 0x6d, 0x8d, 0x80,
+    0x21, 0x09, 0x0b, 0xc4, 0x30, 0xc0, 0x80, 0x12, 0x25, 0xf3, 0x90, 0xca, 0x21, 0x97, 0xdc, 0x72,
+    0x73, 0x55, 0x2a, 0x49, 0xe5, 0x90, 0x1c, 0x9d, 0xbf, 0xe0, 0xfd, 0x27, 0xfe, 0x05, 0xf9, 0x09,
+    0xe9, 0x9e, 0x07, 0x08, 0x80, 0x0f, 0xad, 0x6c, 0x97, 0x73, 0x48, 0xd6, 0xe5, 0x5d, 0x62, 0xa6,
+    0xbb, 0xa7, 0xa7, 0x1f, 0xdf, 0xf4, 0x3c, 0x42, 0x26, 0xc8, 0x88, 0x0b, 0x1e, 0x77, 0xa2, 0x09,
+    0x8b, 0x05, 0xf3, 0xc9, 0x3e, 0xe9, 0xd3, 0x30, 0x61, 0xad, 0x4a, 0x08, 0x5d, 0x2c, 0xf2, 0xb8,
+    0xcf, 0x56, 0x74, 0xde, 0x24, 0xea, 0x5f, 0x2f, 0x8d, 0x63, 0x16, 0x89, 0x76, 0x34, 0x08, 0x19,
+    0x50, 0xd4, 0x54, 0x2b, 0xbd, 0x4a, 0x78, 0x98, 0x0a, 0xf6, 0x8a, 0x27, 0x81, 0x08, 0x78, 0x24,
+    0x7b, 0xc8, 0xf6, 0x36, 0xc1, 0x86, 0xb7, 0xff, 0x78, 0xfb, 0x77, 0x6e, 0x48, 0x28, 0x89, 0x69,
+    0x22, 0x62, 0x46, 0x7d, 0x2a, 0x39, 0x47, 0x74, 0x5c, 0x25, 0x82, 0xdf, 0xb0, 0xf8, 0x84, 0xc6,
+    0xd7, 0x2c, 0x86, 0x0f, 0x1a, 0x0f, 0x98, 0x30, 0x5f, 0x61, 0x10, 0x69, 0x0d, 0x24, 0x11, 0xc8,
+    0x03, 0xd9, 0xf7, 0x21, 0x15, 0x4d, 0xb2, 0xd5, 0x68, 0xb8, 0xcf, 0x80, 0x22, 0x1a, 0xc0, 0xef,
+    0x9d, 0xa7, 0x6e, 0x6d, 0xa6, 0x09, 0xa5, 0x00, 0x45, 0x19, 0xa5, 0x61, 0xd8, 0xaa, 0x78, 0x3c,
+    0x4a, 0x04, 0xe9, 0x1d, 0x75, 0x8f, 0x4e, 0x8e, 0x7a, 0x67, 0xbf, 0x7e, 0x73, 0xd2, 0xfe, 0xb4,
+    0x73, 0x80, 0x3a, 0xde, 0xee, 0x36, 0x16, 0x7b, 0x3f, 0x3b, 0x3a, 0x3b, 0xef, 0x9c, 0xbe, 0x84,
+    0xfe, 0xba, 0xe9, 0x3c, 0xee, 0xb6, 0x3f, 0x7d, 0xd3, 0x79, 0xf9, 0xe6, 0xe4, 0xb4, 0xa7, 0x7a,
+    0x6a, 0xb7, 0xb5, 0x1d, 0xd3, 0x79, 0xde, 0x3b, 0x3b, 0x6a, 0x9f, 0xbc, 0xf9, 0xf9, 0x17, 0xd0,
+    0xde, 0xa8, 0x2d, 0xca, 0x3b, 0xee, 0x1c, 0x75, 0x0f, 0xcf, 0xa1, 0xf3, 0xb2, 0x72, 0x69, 0x51,
+    0x34, 0x9c, 0x55, 0x25, 0x8d, 0x2a, 0xa9, 0xd7, 0x6a, 0x30, 0xdb, 0x38, 0x65, 0xaf, 0xab, 0xe4,
+    0xd2, 0x52, 0x5a, 0x43, 0xcf, 0x4e, 0xb9, 0x87, 0xc5, 0x31, 0x8f, 0xb3, 0x8e, 0xac, 0x07, 0x85,
+    0x95, 0xcc, 0xbe, 0x8c, 0xdb, 0xa3, 0x61, 0x70, 0x15, 0xd3, 0xa5, 0xdd, 0x20, 0x22, 0x64, 0x34,
+    0x8e, 0x82, 0x68, 0x70, 0x30, 0xf5, 0x42, 0x96, 0x68, 0xc5, 0xaa, 0xca, 0xf3, 0x92, 0x1f, 0xec,
+    0x1f, 0x8b, 0x80, 0x66, 0x2a, 0xd7, 0xf2, 0x9d, 0x20, 0xf8, 0x1a, 0x98, 0xe7, 0x9d, 0x59, 0x6f,
+    0xe5, 0xb5, 0x76, 0x06, 0x0b, 0xd9, 0x88, 0x89, 0x78, 0x6a, 0x9c, 0x81, 0x51, 0x71, 0x11, 0x8a,
+    0x60, 0xc4, 0x09, 0x4b, 0x04, 0xf5, 0x39, 0xf1, 0xf8, 0x68, 0x0c, 0xa4, 0x9c, 0xd8, 0x57, 0x34,
+    0x61, 0xc4, 0x07, 0xc7, 0xf9, 0x2c, 0x14, 0x34, 0x71, 0x2a, 0xfd, 0x34, 0xf2, 0x64, 0x3c, 0x61,
+    0xc0, 0xf4, 0x8c, 0xa8, 0xe3, 0x80, 0x85, 0x7e, 0x62, 0x4f, 0xaa, 0x64, 0xcc, 0x93, 0x2a, 0x84,
+    0x50, 0x72, 0x5d, 0x25, 0x3c, 0x15, 0x0e, 0xb9, 0xaf, 0xf4, 0x79, 0x4c, 0x6c, 0x1c, 0x38, 0x50,
+    0x31, 0x18, 0x90, 0xe7, 0x0b, 0xae, 0x70, 0x43, 0x16, 0x0d, 0xc4, 0x10, 0x3a, 0x37, 0x37, 0x91,
+    0x27, 0xe8, 0x13, 0x7b, 0xc3, 0x46, 0x31, 0xe4, 0x43, 0x62, 0xd7, 0xc9, 0xf3, 0xe7, 0x24, 0x70,
+    0x1c, 0x07, 0x14, 0x8b, 0x44, 0x10, 0xa5, 0x3a, 0xfe, 0x2e, 0x23, 0x3a, 0x62, 0x55, 0x92, 0x04,
+    0x77, 0xf8, 0x37, 0x98, 0x55, 0x7e, 0x0c, 0x22, 0xe6, 0xbf, 0x86, 0xa1, 0xca, 0x63, 0x5c, 0x06,
+    0xda, 0x00, 0x31, 0xbd, 0x81, 0x6e, 0xe4, 0x22, 0xfb, 0xfb, 0xfb, 0x64, 0x87, 0x7c, 0x4c, 0x26,
+    0x2e, 0x78, 0xba, 0x13, 0x89, 0x27, 0x0d, 0x5b, 0x4e, 0x00, 0x9d, 0xe1, 0x90, 0x26, 0xb1, 0x95,
+    0xb8, 0x1c, 0x45, 0x7d, 0xaf, 0x48, 0x21, 0xdb, 0x2f, 0x82, 0x52, 0x87, 0xd3, 0xaa, 0xc0, 0xec,
+    0xa5, 0x7e, 0xa8, 0x0a, 0x8e, 0xb8, 0xad, 0x34, 0x6c, 0x55, 0x80, 0x8a, 0x6c, 0xaa, 0xf1, 0x5b,
+    0x95, 0x19, 0xfc, 0x97, 0x99, 0xd4, 0x67, 0x98, 0xee, 0x99, 0x51, 0xed, 0xab, 0xb4, 0x8f, 0xc6,
+    0x40, 0x9d, 0x27, 0xe8, 0x2c, 0x76, 0x43, 0x0e, 0xa9, 0xa0, 0x9f, 0x05, 0xec, 0x46, 0xf6, 0xb5,
+    0xa4, 0x9d, 0x26, 0xee, 0xd5, 0x54, 0xb0, 0xae, 0x34, 0x20, 0x98, 0x76, 0x97, 0x7c, 0xf5, 0xd5,
+    0x5c, 0xab, 0x67, 0x76, 0xcd, 0x21, 0x1b, 0xfb, 0xfb, 0x0b, 0xa9, 0x56, 0x24, 0xaa, 0x97, 0x89,
+    0x74, 0xc6, 0xe1, 0xf0, 0x31, 0x13, 0x69, 0x1c, 0xe9, 0xbc, 0x9d, 0xa9, 0x10, 0x9a, 0x8e, 0x11,
+    0x6a, 0x72, 0x02, 0x1a, 0x5a, 0x19, 0xd5, 0x03, 0xa2, 0xea, 0xe4, 0xc3, 0x0f, 0x49, 0x41, 0xb5,
+    0x17, 0x90, 0x8b, 0xcf, 0x50, 0x60, 0x3e, 0x00, 0xef, 0x01, 0x21, 0x56, 0x44, 0x12, 0x24, 0x46,
+    0xed, 0xf6, 0xf8, 0xb8, 0x3a, 0x0f, 0x58, 0x18, 0x63, 0x46, 0x18, 0xc4, 0x32, 0x29, 0x0c, 0xd5,
+    0xc8, 0x22, 0x66, 0x4e, 0x49, 0xb4, 0xd6, 0x20, 0x1f, 0xc3, 0xbb, 0x3d, 0x48, 0x69, 0xec, 0xd3,
+    0x98, 0x5c, 0xb3, 0x69, 0x3f, 0x06, 0xaf, 0xac, 0x1a, 0x74, 0xb7, 0x9a, 0x9f, 0xd5, 0x8e, 0xb3,
+    0x74, 0xf4, 0x05, 0x9b, 0x64, 0x34, 0xee, 0x88, 0x4f, 0x20, 0xfb, 0x60, 0x62, 0x76, 0x4e, 0xcc,
+    0x13, 0x07, 0xa2, 0xb8, 0x08, 0x58, 0xca, 0xde, 0xb5, 0x96, 0x91, 0x94, 0x49, 0x68, 0xe5, 0x03,
+    0x02, 0xc2, 0x3d, 0x62, 0x9e, 0xb0, 0x71, 0x82, 0x37, 0x89, 0x0e, 0x81, 0xcf, 0xd9, 0xd5, 0x39,
+    0xf7, 0xae, 0x99, 0xb0, 0xad, 0x9b, 0xa4, 0xb9, 0xbd, 0x6d, 0x91, 0x4d, 0x12, 0x72, 0x4f, 0xe2,
+    0x89, 0x3b, 0xe4, 0x00, 0x74, 0x9b, 0xc4, 0xda, 0xbe, 0x49, 0x2c, 0x50, 0xf8, 0x26, 0x71, 0xaf,
+    0x82, 0x88, 0xc6, 0xd3, 0x9e, 0xf2, 0x98, 0x45, 0xe3, 0x98, 0x4e, 0x21, 0x76, 0xfa, 0x2c, 0xb6,
+    0x64, 0x37, 0x8f, 0xf8, 0x98, 0xe1, 0xea, 0x60, 0x06, 0xb5, 0xcb, 0x2e, 0x52, 0x93, 0x4c, 0x58,
+    0xe4, 0xdb, 0xf7, 0x90, 0xcb, 0x23, 0x04, 0x7a, 0x4b, 0x49, 0x05, 0x94, 0x91, 0x2b, 0xc7, 0xa8,
+    0x39, 0x87, 0xdc, 0x19, 0x0c, 0x1b, 0x72, 0xea, 0xab, 0x45, 0xeb, 0x9c, 0x09, 0x48, 0xd8, 0x41,
+    0x62, 0xa3, 0xf5, 0xf4, 0x80, 0x23, 0x96, 0x24, 0x74, 0xc0, 0xf2, 0x63, 0x32, 0x39, 0x28, 0x0c,
+    0xa7, 0xa2, 0xdd, 0x57, 0xc1, 0xc4, 0x5c, 0x1f, 0xc2, 0x9d, 0x04, 0x00, 0xde, 0x34, 0xf2, 0x18,
+    0xef, 0x93, 0x36, 0xaa, 0xff, 0x89, 0x54, 0x1f, 0x39, 0x70, 0x45, 0x2c, 0x27, 0x8d, 0x62, 0xd2,
+    0xe1, 0xb8, 0xe1, 0x23, 0x59, 0x49, 0xf7, 0x2f, 0x13, 0x00, 0x5e, 0x54, 0x53, 0xd9, 0x5e, 0x26,
+    0xa1, 0x71, 0x2c, 0x4a, 0xfc, 0xc5, 0xf9, 0xe9, 0x4b, 0x77, 0x4c, 0xe3, 0x84, 0xcd, 0x85, 0xcd,
+    0xa4, 0x38, 0xdf, 0x95, 0x8b, 0x85, 0xf4, 0x5d, 0x1a, 0xf9, 0xac, 0x0f, 0x50, 0x2c, 0x47, 0x28,
+    0xad, 0xc1, 0x9a, 0x4e, 0x86, 0xde, 0x09, 0x8d, 0x04, 0x8b, 0x61, 0x12, 0xf0, 0x77, 0x24, 0xa1,
+    0x95, 0x93, 0x6f, 0xff, 0x55, 0x7f, 0x56, 0xfb, 0xf6, 0x1b, 0x35, 0xd7, 0x20, 0x19, 0x87, 0x74,
+    0x5a, 0x66, 0x55, 0xe3, 0xe5, 0xfb, 0x9e, 0x93, 0x9a, 0x9c, 0x73, 0xbe, 0x0d, 0x70, 0xe4, 0xc9,
+    0x5e, 0xcd, 0x55, 0x2b, 0xfb, 0xd1, 0x2d, 0xac, 0xba, 0xf5, 0x5d, 0x10, 0x4c, 0x26, 0x41, 0x4c,
+    0x49, 0xa3, 0x8e, 0x63, 0xa8, 0x8c, 0x95, 0x42, 0x8f, 0xd0, 0x46, 0x91, 0xc0, 0x51, 0xb8, 0x97,
+    0xe2, 0x4f, 0x8c, 0x51, 0xdd, 0xfa, 0xc9, 0xb4, 0xe3, 0xdb, 0x56, 0x7e, 0x22, 0x96, 0x36, 0x62,
+    0x9e, 0x17, 0x35, 0xc8, 0x7f, 0xbb, 0x82, 0xdd, 0x8a, 0x03, 0x40, 0x65, 0x2d, 0x37, 0xa7, 0x9c,
+    0x2b, 0xf8, 0x71, 0x70, 0xcb, 0x7c, 0x89, 0x0d, 0xb3, 0xcc, 0x82, 0x72, 0xed, 0x5c, 0xb4, 0xa0,
+    0x2c, 0x77, 0xb0, 0xab, 0x7d, 0x85, 0x81, 0x7e, 0x42, 0xc5, 0xd0, 0x85, 0xc5, 0xd4, 0x30, 0x38,
+    0xad, 0x39, 0xc5, 0x01, 0x0f, 0x41, 0xc2, 0xfe, 0x9c, 0x1c, 0x2c, 0xe3, 0xd6, 0x01, 0xa3, 0xad,
+    0xf7, 0x6b, 0xb5, 0x7e, 0xbf, 0x56, 0xb3, 0x10, 0xb9, 0x0b, 0xbd, 0xbb, 0xb2, 0xb7, 0xdf, 0xa7,
+    0x54, 0xf5, 0xe2, 0xef, 0x27, 0xf0, 0xc7, 0xca, 0xcb, 0x3d, 0x0a, 0xd7, 0x59, 0x46, 0x92, 0x1c,
+    0xaa, 0xf9, 0x19, 0xcb, 0x68, 0x36, 0xd4, 0x5f, 0xff, 0x2c, 0xdb, 0x43, 0x69, 0x9f, 0x99, 0x02,
+    0x90, 0x00, 0x92, 0xf3, 0xdb, 0x6f, 0x20, 0xf7, 0x0c, 0x43, 0x22, 0xa6, 0x60, 0x2b, 0x2f, 0x3f,
+    0x27, 0x39, 0xc1, 0xbc, 0xcd, 0x16, 0x8a, 0xb9, 0x05, 0xf3, 0x2d, 0x29, 0xf7, 0x16, 0xd9, 0x14,
+    0x14, 0x8a, 0x14, 0xea, 0x8f, 0x3b, 0xc0, 0xc2, 0x09, 0x8d, 0x83, 0xb7, 0x7f, 0x9b, 0xb0, 0x90,
+    0x0c, 0x42, 0x7e, 0x45, 0x43, 0x53, 0x37, 0xaa, 0x3a, 0x6d, 0x09, 0x7b, 0x8e, 0x60, 0xbd, 0xad,
+    0x16, 0xaa, 0x20, 0x6d, 0xe6, 0x1b, 0x55, 0xd9, 0xac, 0x67, 0xf6, 0xe8, 0x55, 0xc8, 0x3e, 0x57,
+    0x94, 0x59, 0x08, 0xea, 0x41, 0x4d, 0xa4, 0xc0, 0xf7, 0x67, 0x34, 0x4c, 0x59, 0x3e, 0x52, 0x14,
+    0x8d, 0x1e, 0xc9, 0xd8, 0x33, 0x23, 0x7c, 0x41, 0x20, 0xe5, 0x74, 0x14, 0x60, 0x55, 0x24, 0x63,
+    0x24, 0xdf, 0xfb, 0xd4, 0xf4, 0xca, 0xb8, 0x28, 0xf7, 0xee, 0xd6, 0x16, 0x22, 0x48, 0xc7, 0x1a,
+    0xae, 0xf5, 0x46, 0xbd, 0x92, 0xf7, 0x55, 0x73, 0xe6, 0xfc, 0xfa, 0xdc, 0xf9, 0x19, 0x43, 0xd1,
+    0xfb, 0x9e, 0x71, 0x3c, 0xce, 0x39, 0x33, 0xd6, 0x3b, 0x4d, 0x5a, 0x5b, 0x29, 0x37, 0x59, 0xb9,
+    0x68, 0x18, 0x19, 0x25, 0xcd, 0x2c, 0xf2, 0xef, 0xbf, 0x7c, 0xfd, 0x4f, 0xd2, 0xed, 0x9c, 0x74,
+    0x7a, 0x47, 0xe4, 0xa2, 0xdb, 0x3b, 0x6b, 0xbf, 0x6a, 0x9f, 0x9f, 0xb7, 0x0f, 0x4f, 0x37, 0xc8,
+    0xd9, 0xd1, 0xc1, 0xc5, 0xab, 0xa3, 0xb3, 0xf6, 0xdb, 0x3f, 0xbc, 0xfd, 0xfd, 0x29, 0x69, 0x5f,
+    0xf4, 0x4e, 0x4f, 0xde, 0xfe, 0xae, 0xd7, 0x39, 0x68, 0xe3, 0x82, 0x91, 0xc9, 0x53, 0x8a, 0xeb,
+    0x7c, 0x47, 0x89, 0x41, 0x84, 0x1b, 0x83, 0x25, 0x34, 0x66, 0x72, 0x99, 0xe5, 0x17, 0x49, 0x68,
+    0x14, 0x8c, 0xa8, 0x0e, 0x5b, 0xeb, 0x0a, 0xe4, 0x5c, 0x93, 0x7a, 0x02, 0x90, 0x09, 0xe1, 0x1d,
+    0x08, 0x94, 0x99, 0x5b, 0xf6, 0xf3, 0x93, 0xdc, 0x7b, 0x60, 0x92, 0xdf, 0x7d, 0xfd, 0x57, 0xf2,
+    0xea, 0xec, 0xed, 0x9f, 0x7e, 0xd5, 0x39, 0x39, 0x25, 0x87, 0xa7, 0x7a, 0xbe, 0x1b, 0x3f, 0xc2,
+    0x44, 0xf6, 0xf6, 0x1e, 0x9e, 0x48, 0xc4, 0xa3, 0x9c, 0xee, 0xf7, 0xeb, 0xc6, 0x34, 0xa4, 0xf2,
+    0x3f, 0xf4, 0x75, 0xb2, 0x16, 0xa5, 0x61, 0x3d, 0x14, 0x69, 0x62, 0x92, 0x03, 0x68, 0xa1, 0xd6,
+    0xf2, 0x4d, 0xed, 0xb1, 0x80, 0x0d, 0x0a, 0x43, 0x54, 0x2f, 0x7c, 0x83, 0xec, 0xb2, 0xa1, 0x4e,
+    0xf8, 0x04, 0x96, 0x48, 0xee, 0xba, 0xae, 0xd5, 0xc2, 0x6e, 0x2f, 0xa4, 0x49, 0xf2, 0x12, 0xca,
+    0x24, 0xec, 0x54, 0x83, 0x11, 0xc5, 0x0f, 0xfd, 0xb3, 0x8a, 0x9a, 0xcf, 0x12, 0x39, 0xaf, 0x68,
+    0x0c, 0xdb, 0x87, 0x95, 0x32, 0x24, 0x33, 0x2e, 0xb6, 0x50, 0xac, 0x78, 0x43, 0x44, 0x4f, 0x54,
+    0x07, 0x37, 0x67, 0x1c, 0xcc, 0x21, 0xa1, 0xcf, 0xb6, 0x8e, 0xe0, 0x1f, 0x42, 0x39, 0x19, 0xc7,
+    0xdc, 0xc3, 0x42, 0x21, 0x26, 0x30, 0x6f, 0xac, 0x17, 0x46, 0x4d, 0x28, 0x37, 0x90, 0x47, 0x4a,
+    0xd1, 0xb5, 0x84, 0x17, 0xf2, 0x84, 0x95, 0xaa, 0x17, 0x92, 0x30, 0xd1, 0x0b, 0x46, 0x0c, 0x2a,
+    0x70, 0x5b, 0x57, 0x50, 0xb0, 0x1b, 0x82, 0xc8, 0x43, 0x4e, 0xcd, 0xa7, 0x56, 0xa1, 0x12, 0x1f,
+    0xf4, 0x48, 0x79, 0xb6, 0x22, 0xcc, 0x15, 0x62, 0xb2, 0x82, 0xe0, 0xc6, 0x98, 0x50, 0x8a, 0x81,
+    0xc1, 0x81, 0x1a, 0x8b, 0xc8, 0xe9, 0x39, 0xcc, 0x4d, 0xd7, 0xbc, 0xaa, 0x4e, 0x73, 0x25, 0xb5,
+    0xac, 0x22, 0xa0, 0x3a, 0x02, 0xa3, 0x05, 0xfd, 0x29, 0x30, 0x3b, 0xf3, 0x62, 0x2f, 0x4e, 0x65,
+    0xe9, 0xaf, 0x3f, 0xf5, 0x9e, 0x3e, 0x37, 0x1c, 0xf5, 0xbf, 0x4c, 0x13, 0x61, 0x4f, 0x4c, 0xe6,
+    0xab, 0xe2, 0x81, 0x86, 0xa6, 0x48, 0x90, 0x2b, 0x70, 0x8f, 0x77, 0x74, 0xb3, 0x9d, 0x5f, 0xb5,
+    0x35, 0x00, 0x42, 0xa5, 0x68, 0xa8, 0x8b, 0xdc, 0x9b, 0x64, 0x02, 0x36, 0x18, 0x06, 0xf0, 0xd3,
+    0xce, 0x88, 0x24, 0x60, 0xb8, 0x90, 0x4d, 0x59, 0xcb, 0x96, 0xa9, 0x2c, 0x16, 0x68, 0x9f, 0x43,
+    0x91, 0x51, 0x22, 0xce, 0xca, 0x10, 0x15, 0x8f, 0xb2, 0xdc, 0x92, 0x3a, 0x36, 0x33, 0x9a, 0x99,
+    0x63, 0x26, 0x53, 0x2a, 0x78, 0x72, 0x72, 0x11, 0x63, 0xe7, 0x32, 0x95, 0x48, 0x32, 0x17, 0xd1,
+    0xaa, 0xac, 0x4c, 0x08, 0xb5, 0x55, 0xd7, 0x55, 0x8b, 0x3b, 0xd1, 0x28, 0xb9, 0xb4, 0x1a, 0xa9,
+    0x3b, 0x6b, 0xe4, 0x98, 0xc4, 0x2a, 0x07, 0x76, 0x07, 0xb2, 0x83, 0x40, 0x49, 0x48, 0x09, 0x56,
+    0xdb, 0x2b, 0xe4, 0x22, 0xba, 0xcb, 0x14, 0x7a, 0x07, 0xf9, 0xeb, 0x32, 0xac, 0xb8, 0x29, 0x2c,
+    0xfb, 0x3a, 0x3f, 0xb8, 0x8c, 0x37, 0xe5, 0x9e, 0xc5, 0x52, 0x71, 0x79, 0xa1, 0xb8, 0x94, 0xfe,
+    0x85, 0xec, 0x2d, 0xb1, 0x6c, 0x15, 0x9c, 0x5a, 0xa4, 0x37, 0xe1, 0x92, 0xed, 0x84, 0x8a, 0x9c,
+    0x86, 0x71, 0xb6, 0xac, 0xbb, 0x10, 0xe9, 0xe0, 0xaa, 0x00, 0x4a, 0x6c, 0x86, 0x08, 0x84, 0x66,
+    0xb2, 0x73, 0x9e, 0x2c, 0x47, 0xff, 0x81, 0x8a, 0xf2, 0x77, 0x8b, 0x7f, 0xc3, 0xd4, 0x93, 0xf2,
+    0x96, 0xf0, 0xe4, 0x07, 0x52, 0x2c, 0x23, 0xad, 0x43, 0x2e, 0x65, 0x34, 0xf7, 0x56, 0x59, 0x07,
+    0xc5, 0x00, 0x08, 0x4b, 0x43, 0x55, 0x2d, 0x95, 0x75, 0xdc, 0xcc, 0xa4, 0x29, 0xf3, 0x65, 0xa4,
+    0xda, 0x74, 0xb8, 0xff, 0xce, 0xda, 0xe6, 0x19, 0x05, 0x85, 0x5c, 0x08, 0xbb, 0x26, 0xdb, 0xfa,
+    0xee, 0xcf, 0x7f, 0x24, 0x9f, 0x74, 0x4f, 0x7f, 0x79, 0x71, 0x04, 0x6b, 0x72, 0x93, 0x80, 0x79,
+    0x02, 0x14, 0xc6, 0x49, 0x1a, 0x8a, 0x98, 0x8e, 0x29, 0x02, 0x63, 0x40, 0x09, 0x27, 0x61, 0x30,
+    0x82, 0x25, 0x12, 0x76, 0x41, 0x08, 0x98, 0x82, 0xa9, 0x93, 0x3d, 0xf8, 0x82, 0x2a, 0x8a, 0x13,
+    0x5b, 0x6f, 0x34, 0x1c, 0xf7, 0x37, 0x11, 0x04, 0x6e, 0x05, 0x80, 0x5e, 0x70, 0x2c, 0xfc, 0x02,
+    0x82, 0x91, 0x0d, 0xd8, 0x1a, 0x33, 0x3f, 0x88, 0x99, 0x07, 0xae, 0x80, 0x0f, 0x19, 0xe0, 0xb0,
+    0x45, 0xa1, 0xa3, 0x20, 0x1a, 0x72, 0x00, 0xbd, 0x41, 0x1a, 0x73, 0xd7, 0x9a, 0x03, 0x57, 0x86,
+    0x54, 0x25, 0x20, 0xcb, 0xdc, 0x39, 0xe0, 0x3d, 0x6e, 0xd3, 0x77, 0x85, 0x2d, 0xb3, 0x4b, 0x2b,
+    0x00, 0x46, 0x81, 0x69, 0x25, 0x6a, 0x50, 0x0d, 0x17, 0x34, 0x87, 0x13, 0x74, 0x59, 0xa4, 0xae,
+    0x8f, 0xec, 0xff, 0x11, 0x40, 0xc1, 0xe3, 0x81, 0xf0, 0x1c, 0x5c, 0x0f, 0xcb, 0x28, 0xac, 0x4e,
+    0xa2, 0x23, 0xd8, 0xc8, 0xb6, 0x80, 0x43, 0xf4, 0x72, 0xf3, 0xac, 0x96, 0xf5, 0x38, 0x97, 0xab,
+    0x97, 0xed, 0x38, 0x25, 0x48, 0x4a, 0x34, 0x87, 0x9d, 0x55, 0xa6, 0xda, 0x2b, 0x72, 0xd3, 0x7c,
+    0x0c, 0xbb, 0x7f, 0x61, 0x3f, 0xc6, 0xb2, 0x3a, 0x0c, 0x02, 0xd0, 0xff, 0xa5, 0xda, 0x6d, 0x3a,
+    0xb9, 0x54, 0x00, 0xd2, 0x34, 0xe4, 0x10, 0x17, 0x12, 0x2b, 0xf8, 0x86, 0x55, 0xd8, 0xb9, 0x67,
+    0x1b, 0x54, 0x19, 0x10, 0x90, 0x55, 0x54, 0x23, 0xd4, 0x93, 0xbd, 0x7c, 0x3e, 0x1d, 0x06, 0x03,
+    0x4c, 0x93, 0x74, 0x84, 0xfd, 0x28, 0x0e, 0xf4, 0x89, 0x19, 0x70, 0x30, 0x24, 0x24, 0x83, 0x98,
+    0xa6, 0x49, 0x49, 0xf2, 0x3b, 0x45, 0xb0, 0x86, 0x8f, 0x77, 0x89, 0xe2, 0x1f, 0x18, 0x23, 0xf4,
+    0xbf, 0x1d, 0x1c, 0xf4, 0xa1, 0xa8, 0x10, 0x7c, 0x2c, 0xf1, 0xc5, 0x36, 0x75, 0x92, 0xb2, 0x08,
+    0xb6, 0x37, 0x25, 0x54, 0x7c, 0x4f, 0x3b, 0x98, 0xaa, 0xf2, 0xfb, 0x4d, 0xb4, 0xbc, 0x9e, 0x9a,
+    0xd3, 0x77, 0x19, 0xbd, 0xb0, 0xa3, 0xc0, 0x12, 0xb1, 0x1f, 0xc4, 0x30, 0xe5, 0x43, 0x2c, 0x99,
+    0x83, 0x18, 0x8f, 0xb0, 0x03, 0x0f, 0x2a, 0x50, 0x8a, 0x3b, 0x65, 0x75, 0x60, 0xf3, 0x92, 0xc7,
+    0x10, 0x3d, 0xb6, 0x0e, 0x14, 0xe7, 0x63, 0xd8, 0xf5, 0xa9, 0x9a, 0xf0, 0x3e, 0x13, 0x67, 0xa6,
+    0x88, 0xd5, 0x69, 0x36, 0x58, 0x9f, 0xc7, 0x1e, 0x3b, 0x63, 0x1e, 0xac, 0x05, 0xf1, 0x54, 0xdb,
+    0x65, 0x3e, 0xe0, 0xf1, 0xe9, 0xd9, 0x41, 0xfb, 0x0c, 0x8f, 0x2a, 0x39, 0x1e, 0x0d, 0xd1, 0x0c,
+    0xcd, 0x15, 0xf2, 0x4a, 0xf8, 0x7e, 0xba, 0x6b, 0xc6, 0x24, 0x17, 0x50, 0xe9, 0xd2, 0x31, 0x8b,
+    0x68, 0x02, 0x04, 0x12, 0xa7, 0xaf, 0xe4, 0x89, 0x7d, 0x00, 0xc2, 0x09, 0x88, 0xf0, 0x54, 0x76,
+    0x14, 0x4e, 0xbc, 0xe6, 0xa3, 0x67, 0xfa, 0x3d, 0xde, 0x01, 0x20, 0x22, 0x1d, 0xb3, 0x98, 0xca,
+    0x78, 0xd4, 0xc6, 0x91, 0x2a, 0xd2, 0x1f, 0xbf, 0xdc, 0x11, 0x7c, 0x00, 0x61, 0x36, 0x8f, 0xa3,
+    0xf2, 0xed, 0xd8, 0x46, 0xa1, 0xc1, 0x9c, 0x4b, 0x06, 0xf2, 0x5b, 0x72, 0x35, 0x8b, 0x17, 0x6a,
+    0x6b, 0x27, 0x9c, 0xa3, 0x2c, 0xcf, 0x5a, 0xaf, 0x95, 0x4d, 0x99, 0x7b, 0x76, 0x51, 0x8b, 0x8f,
+    0x31, 0x37, 0xf1, 0x37, 0x18, 0x5c, 0x9e, 0x05, 0xbc, 0xc4, 0xa3, 0xc5, 0x50, 0x9e, 0x72, 0x2c,
+    0x4d, 0xa6, 0x02, 0x3b, 0xa4, 0x52, 0xe1, 0xdb, 0x69, 0x2d, 0xce, 0xff, 0x48, 0x5d, 0xfc, 0x49,
+    0x0b, 0x2c, 0x5e, 0x02, 0x6e, 0x94, 0x9a, 0x8a, 0x56, 0xd0, 0xbc, 0xcd, 0xf2, 0xed, 0xe1, 0x5a,
+    0x4b, 0x14, 0x68, 0x17, 0x6d, 0x91, 0xc9, 0x94, 0xd6, 0x28, 0x6b, 0xf4, 0x68, 0x7b, 0x94, 0x04,
+    0xe0, 0xbe, 0xae, 0xd8, 0x52, 0xb4, 0xc9, 0xb2, 0xe3, 0xe4, 0x25, 0xa1, 0x51, 0x18, 0x6b, 0xb0,
+    0xdc, 0xf6, 0x8e, 0xdc, 0xa8, 0x59, 0x98, 0x0a, 0x78, 0x06, 0xb7, 0x60, 0xda, 0xe5, 0x32, 0xca,
+    0xfa, 0x16, 0xa5, 0xfc, 0x84, 0xe1, 0xf5, 0x93, 0xfb, 0x0f, 0x61, 0xbc, 0x18, 0xad, 0x19, 0xba,
+    0x14, 0x72, 0xce, 0x60, 0x8b, 0x5a, 0x90, 0xcb, 0xde, 0x2c, 0xf1, 0x64, 0xda, 0xcc, 0xb9, 0x4a,
+    0xde, 0xee, 0xc2, 0xea, 0x33, 0x2f, 0x31, 0xe6, 0x17, 0x03, 0x09, 0x9d, 0x30, 0xdf, 0x2c, 0xc6,
+    0xcb, 0x7d, 0x55, 0x5e, 0xb8, 0xcc, 0xea, 0x3c, 0xe7, 0xc4, 0x03, 0x12, 0xbc, 0xd4, 0xc0, 0x4d,
+    0x7c, 0xa9, 0xd9, 0xb2, 0x96, 0x35, 0x22, 0xb1, 0xb5, 0xa6, 0xd6, 0x99, 0xd3, 0x9b, 0x6b, 0x87,
+    0x72, 0x29, 0xf3, 0xc8, 0x3a, 0x93, 0x2e, 0x14, 0x98, 0xf3, 0x0b, 0x8a, 0xc7, 0x49, 0xb2, 0x6a,
+    0x56, 0xe1, 0x7e, 0x23, 0x77, 0xfa, 0x22, 0xef, 0x2d, 0x96, 0x9f, 0xbd, 0x78, 0x14, 0x76, 0x31,
+    0x03, 0xd8, 0x11, 0xa8, 0x62, 0x49, 0x1e, 0xbc, 0xac, 0x72, 0x93, 0x39, 0xe3, 0xfd, 0xbf, 0xa7,
+    0x94, 0xa7, 0x1e, 0x53, 0x36, 0xae, 0x2b, 0x19, 0xf5, 0x69, 0xe0, 0x63, 0xbc, 0x35, 0x36, 0x4f,
+    0x3b, 0x96, 0x3a, 0x0c, 0xcf, 0x52, 0x4f, 0xe8, 0x58, 0x41, 0x27, 0x1d, 0x83, 0x5a, 0x5d, 0x17,
+    0xfe, 0x05, 0x98, 0xa2, 0x63, 0x98, 0x11, 0x80, 0xb3, 0xbc, 0x58, 0xbe, 0x34, 0xaf, 0x3a, 0xdc,
+    0x90, 0x8a, 0x2a, 0x99, 0x7f, 0x45, 0x83, 0xd7, 0xf8, 0xa2, 0x00, 0xc4, 0x76, 0x5d, 0x11, 0x84,
+    0xac, 0x4b, 0xa7, 0xb0, 0x42, 0x59, 0x43, 0x21, 0xc6, 0x78, 0x0d, 0x79, 0x9f, 0xcc, 0x64, 0xb3,
+    0x8b, 0xf7, 0x89, 0x78, 0x2b, 0xc8, 0x04, 0x08, 0x76, 0x79, 0x3c, 0xd8, 0xbe, 0xbf, 0x9b, 0x6d,
+    0xdf, 0xdf, 0xc2, 0xff, 0xd3, 0x99, 0x3b, 0x96, 0x6f, 0x13, 0xa0, 0x2e, 0x17, 0x50, 0x46, 0x5e,
+    0xa5, 0xa8, 0x19, 0x00, 0xce, 0xe9, 0xf9, 0x09, 0x2e, 0x8b, 0xf4, 0xf6, 0x0b, 0xce, 0x47, 0x4d,
+    0x52, 0xff, 0x59, 0x65, 0xe6, 0xb8, 0xd4, 0xf7, 0x61, 0x37, 0x09, 0x42, 0x9c, 0xdc, 0x73, 0x93,
+    0x8e, 0x27, 0x0f, 0x57, 0xbb, 0xae, 0x1f, 0x4c, 0xf0, 0xb7, 0x0d, 0x66, 0x31, 0xc5, 0x05, 0x08,
+    0x92, 0x34, 0x5b, 0x81, 0x87, 0x4f, 0x2b, 0x2a, 0x43, 0x31, 0x0a, 0xa1, 0xed, 0x39, 0x90, 0x12,
+    0x79, 0xe4, 0xba, 0xff, 0xde, 0x4d, 0xe0, 0x8b, 0x61, 0xb3, 0x51, 0x1b, 0xdf, 0xb6, 0x86, 0x2c,
+    0x18, 0x0c, 0x85, 0xfa, 0x7d, 0x45, 0xbd, 0xeb, 0x41, 0xcc, 0xd3, 0xc8, 0x6f, 0xbe, 0x5f, 0xab,
+    0xf9, 0x3b, 0xfd, 0x7e, 0xeb, 0x8a, 0xc7, 0x88, 0x51, 0x4f, 0xc6, 0xb7, 0x04, 0x8c, 0x1e, 0xf8,
+    0xe4, 0xfd, 0x7e, 0xd6, 0xba, 0x05, 0x05, 0x69, 0x90, 0x26, 0xcd, 0xdd, 0xda, 0x07, 0xd0, 0x72,
+    0xbb, 0x95, 0x0c, 0xa1, 0x40, 0xbd, 0x69, 0xd6, 0x60, 0x3f, 0x51, 0x07, 0x71, 0xc4, 0xc8, 0x78,
+    0xef, 0xc5, 0xf3, 0x6d, 0x18, 0xfc, 0x05, 0xe8, 0x82, 0x2a, 0x9d, 0x07, 0x77, 0xa0, 0xe3, 0x65,
+    0xa3, 0x86, 0xc7, 0x91, 0x60, 0x4c, 0x6c, 0x6b, 0x47, 0xde, 0x10, 0x01, 0xf4, 0xb2, 0x5e, 0x43,
+    0xeb, 0xbe, 0xae, 0xa0, 0xe7, 0x73, 0xaf, 0x6f, 0xb4, 0x9b, 0xf0, 0xe7, 0x03, 0xae, 0xb9, 0x97,
+    0x63, 0x34, 0xe7, 0x66, 0xaa, 0x56, 0x7c, 0x48, 0xb8, 0x01, 0x5e, 0xa7, 0x28, 0xa8, 0x2d, 0x1a,
+    0x15, 0x6f, 0x86, 0xfd, 0x57, 0x7c, 0x9c, 0x42, 0x08, 0x9c, 0xa7, 0x94, 0xf4, 0x38, 0x84, 0x11,
+    0xd9, 0x92, 0x77, 0xac, 0x09, 0x14, 0xa1, 0x72, 0xe7, 0x81, 0xa7, 0x18, 0xb1, 0x55, 0x54, 0xc9,
+    0x05, 0xab, 0x5b, 0x28, 0x1a, 0xa2, 0x17, 0xbc, 0x56, 0xbc, 0xc4, 0x45, 0x47, 0x8d, 0xe5, 0x91,
+    0x08, 0xa4, 0x85, 0x4c, 0x19, 0xcc, 0xa4, 0x2e, 0x15, 0x5d, 0xdc, 0x33, 0x68, 0x39, 0x7a, 0x0a,
+    0x98, 0x9b, 0xea, 0x57, 0xbe, 0x5d, 0x5e, 0x9f, 0x8f, 0xd5, 0xaf, 0x75, 0x3b, 0x74, 0x64, 0x38,
+    0xe0, 0xe0, 0x8f, 0xc5, 0x8a, 0x55, 0x4b, 0xcd, 0xf2, 0x72, 0x47, 0xee, 0x96, 0xaa, 0x72, 0xf5,
+    0xd3, 0x92, 0x73, 0x7d, 0xfa, 0xe5, 0x82, 0x79, 0xa3, 0x84, 0xb3, 0x48, 0xc7, 0x78, 0x28, 0xd5,
+    0xbe, 0x0b, 0x46, 0xa9, 0x18, 0xa2, 0xda, 0xaa, 0xa1, 0x1b, 0x44, 0x4c, 0xde, 0x64, 0xaf, 0xa8,
+    0x6b, 0xa4, 0x4e, 0x30, 0x57, 0xab, 0x6a, 0x54, 0x58, 0x59, 0x02, 0x29, 0x52, 0x99, 0x0c, 0x5a,
+    0x23, 0x94, 0xab, 0x23, 0x5d, 0xc2, 0x54, 0x57, 0x1a, 0x68, 0x39, 0x74, 0x66, 0x03, 0x15, 0x18,
+    0xa4, 0xe5, 0xd6, 0x31, 0xcc, 0x2f, 0xd4, 0xb2, 0x11, 0x0c, 0x88, 0x76, 0xe5, 0xdd, 0xc0, 0x82,
+    0x7b, 0x4a, 0xd0, 0xd9, 0x95, 0x33, 0x2a, 0xfb, 0xaa, 0x4c, 0x24, 0xe7, 0x92, 0x0f, 0x98, 0x24,
+    0x8b, 0x80, 0x75, 0x21, 0xec, 0x7c, 0x4f, 0x6f, 0xe7, 0x45, 0x2e, 0x75, 0x79, 0x7e, 0x94, 0x82,
+    0xdf, 0x11, 0xa0, 0x1e, 0x81, 0x7b, 0x33, 0xc9, 0x80, 0xd1, 0xef, 0x85, 0x81, 0x77, 0xbd, 0x10,
+    0xfb, 0xf9, 0x67, 0x6e, 0xea, 0x41, 0x1c, 0x43, 0x61, 0x38, 0xaa, 0x94, 0x29, 0xdf, 0xc5, 0xcd,
+    0x9b, 0xa2, 0xc1, 0xec, 0xc1, 0x13, 0xa8, 0x55, 0x53, 0x36, 0x23, 0xad, 0x9e, 0xf3, 0x9c, 0x62,
+    0x65, 0xb0, 0x2b, 0xef, 0x38, 0xf8, 0xe2, 0xcf, 0x8d, 0x19, 0xa6, 0xba, 0xc2, 0xf4, 0x42, 0x6f,
+    0xfe, 0x05, 0xdf, 0x43, 0xe0, 0x2b, 0x89, 0x1e, 0x44, 0xdf, 0xfa, 0xde, 0x1c, 0x7d, 0xe5, 0xef,
+    0x3c, 0xfa, 0xb2, 0xfe, 0x0e, 0xfc, 0x31, 0xe8, 0xdb, 0x78, 0x08, 0x7d, 0x97, 0x23, 0x6c, 0x7d,
+    0x0f, 0x3c, 0xb6, 0x57, 0x46, 0xd8, 0x67, 0x55, 0xf2, 0x4c, 0xe3, 0x6b, 0x6e, 0x82, 0x45, 0x80,
+    0xcd, 0xdb, 0xb5, 0x5a, 0x34, 0x22, 0x42, 0xac, 0x46, 0xd8, 0xcc, 0x18, 0x2b, 0x01, 0xb5, 0x1d,
+    0x4e, 0xb8, 0x95, 0xe1, 0xc6, 0x6a, 0x20, 0x29, 0x6e, 0x74, 0x4a, 0xd4, 0xa6, 0x8e, 0xb9, 0xc3,
+    0xab, 0x61, 0x1a, 0x7a, 0xa6, 0x63, 0x75, 0xa4, 0x56, 0xc9, 0xba, 0x19, 0x68, 0x5f, 0xfa, 0x81,
+    0xbc, 0x5d, 0x44, 0x89, 0x87, 0x81, 0x7a, 0x5a, 0xf3, 0x43, 0x44, 0xae, 0x7e, 0x05, 0xa0, 0xd4,
+    0x5d, 0x08, 0x5e, 0x7a, 0x57, 0x3a, 0xc6, 0x52, 0x27, 0x1c, 0xeb, 0x76, 0x52, 0xbe, 0xd6, 0x73,
+    0x41, 0x16, 0x76, 0x94, 0xa5, 0x5d, 0x8f, 0xac, 0x47, 0x9f, 0xec, 0x16, 0x74, 0x7a, 0xc7, 0x22,
+    0xee, 0xce, 0x79, 0xc4, 0xe1, 0xd9, 0x5d, 0xf1, 0xe4, 0xec, 0xa1, 0xca, 0xaf, 0x14, 0x12, 0x2a,
+    0x5e, 0xf4, 0xb1, 0x1a, 0x5e, 0x4f, 0x2f, 0x26, 0xad, 0x6c, 0x05, 0x85, 0xe0, 0x1f, 0x19, 0xd2,
+    0x63, 0x1e, 0x4e, 0xf1, 0xc3, 0xbe, 0x5c, 0x8f, 0x6c, 0xeb, 0x63, 0x5e, 0xd6, 0x15, 0xf2, 0xe2,
+    0x5b, 0x3d, 0x79, 0xc0, 0xb2, 0x06, 0xa6, 0x73, 0xa3, 0xb2, 0x17, 0xdf, 0x98, 0xfa, 0x34, 0x19,
+    0xca, 0x67, 0x59, 0x40, 0xa0, 0x6a, 0x18, 0xab, 0x5c, 0xbc, 0x15, 0x4f, 0xdf, 0xb2, 0x30, 0x86,
+    0xe1, 0xea, 0x12, 0x14, 0xf1, 0x6f, 0x2a, 0x1a, 0xf2, 0x77, 0x23, 0x3b, 0xf0, 0x57, 0xcb, 0x99,
+    0x8d, 0x6d, 0x50, 0x95, 0x20, 0x99, 0x43, 0x3e, 0x52, 0x2f, 0x1f, 0x5e, 0x75, 0xc8, 0x36, 0xde,
+    0xa3, 0x28, 0x47, 0xa1, 0x1c, 0x4c, 0x63, 0xfc, 0x77, 0x25, 0x45, 0x43, 0x53, 0x34, 0x96, 0x53,
+    0xdc, 0x9a, 0x47, 0x15, 0x49, 0x10, 0xd9, 0x6a, 0x31, 0xd4, 0x74, 0x1e, 0x4f, 0x6c, 0xc9, 0xaf,
+    0xc3, 0x62, 0x6a, 0x28, 0x75, 0x47, 0x3d, 0xce, 0x48, 0x91, 0x57, 0x91, 0x82, 0xc2, 0xf9, 0x96,
+    0x1c, 0xcd, 0x5c, 0x5c, 0xbe, 0x45, 0xaf, 0x99, 0x59, 0xb6, 0xab, 0xf7, 0x1d, 0x10, 0xf2, 0x0d,
+    0xfb, 0xb6, 0x4a, 0xa6, 0x48, 0x8b, 0xcf, 0x57, 0xb6, 0x8d, 0xea, 0xd9, 0x8d, 0x0c, 0x44, 0xa1,
+    0xba, 0x01, 0x71, 0xc8, 0x07, 0xf8, 0xcf, 0x82, 0xb1, 0xb3, 0x0c, 0x5f, 0x6f, 0xed, 0x33, 0x18,
+    0x74, 0xef, 0xc9, 0xd3, 0xba, 0x46, 0x08, 0x55, 0x7b, 0x48, 0x45, 0xd1, 0xf6, 0xc0, 0xba, 0xc2,
+    0xf6, 0xef, 0xee, 0x25, 0x5a, 0xb4, 0x30, 0x15, 0xdb, 0x8d, 0x82, 0xe1, 0x4c, 0xd3, 0x66, 0xd1,
+    0xba, 0x1f, 0x69, 0x51, 0xdb, 0xf2, 0x45, 0x4b, 0xc9, 0x88, 0x4b, 0x3b, 0x8d, 0x07, 0x17, 0xe4,
+    0xcb, 0xa6, 0xcc, 0x72, 0x67, 0xd0, 0x99, 0x05, 0x83, 0x32, 0xb5, 0xa2, 0xfd, 0x6d, 0x2c, 0x6c,
+    0xea, 0x54, 0xc9, 0xfc, 0xab, 0xbe, 0x45, 0x9d, 0x62, 0x18, 0xdf, 0xc1, 0x36, 0xa5, 0xa3, 0x1e,
+    0x0d, 0x60, 0x1e, 0x9a, 0xcf, 0xc2, 0xd9, 0x2f, 0x36, 0x9e, 0xa6, 0xa2, 0x40, 0x24, 0xbf, 0x0b,
+    0x54, 0x1e, 0xc3, 0xe4, 0xd7, 0xfb, 0x32, 0xf2, 0xb8, 0x82, 0x04, 0xe4, 0xdc, 0xc0, 0x92, 0xc3,
+    0x6f, 0xa0, 0x26, 0xc1, 0xed, 0x78, 0xf9, 0x15, 0x67, 0xf6, 0x7c, 0xb4, 0x45, 0xf2, 0x7f, 0xb6,
+    0xb7, 0x09, 0x00, 0x28, 0xbb, 0x85, 0xad, 0x63, 0xf6, 0x96, 0x14, 0x3c, 0x58, 0xda, 0xcf, 0x93,
+    0x84, 0x41, 0xfd, 0xef, 0x0d, 0xe9, 0x08, 0x5f, 0x84, 0x47, 0x9c, 0xa8, 0x97, 0xa2, 0x4e, 0x25,
+    0xdb, 0x47, 0x2e, 0x48, 0xed, 0x44, 0x81, 0x17, 0xe8, 0xc7, 0x65, 0x30, 0x13, 0x5a, 0x29, 0x1d,
+    0xe5, 0xb4, 0x72, 0x0a, 0x98, 0x3d, 0x6b, 0xaa, 0x1e, 0x9e, 0xeb, 0x5b, 0x99, 0x34, 0xc1, 0xc1,
+    0x6c, 0x7d, 0xca, 0x7d, 0xd1, 0x71, 0xf0, 0xa1, 0xc7, 0x7f, 0x00, 0x78, 0xcf, 0x05, 0xf8, 0x25,
+    0x31, 0x00, 0x00,
+};
+
+const size_t APP_JS_GZ_LEN = 3811;
+
+#define APP_JS_ETAG "\"e56c5970372eaf43\""
+
+const uint8_t INDEX_HTML_GZ[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x58, 0xef, 0x52, 0xe3, 0x36,
+    0x10, 0xff, 0x7e, 0x4f, 0xa1, 0x53, 0xa7, 0x1d, 0x98, 0x3b, 0xc7, 0x0e, 0x49, 0x20, 0x84, 0x24,
+    0x6d, 0x8e, 0x83, 0x29, 0x33, 0x70, 0x30, 0xc0, 0xb5, 0xd3, 0x8f, 0xb2, 0xbd, 0x71, 0x74, 0xd8,
+    0x92, 0x2b, 0xc9, 0xe1, 0xc2, 0xa3, 0xf4, 0x53, 0x1f, 0xa1, 0xcf, 0xd0, 0x47, 0xe9, 0x93, 0x74,
+    0xe5, 0x3f, 0x9c, 0x93, 0x38, 0x5c, 0x02, 0x03, 0x38, 0x5a, 0x6b, 0x7f, 0xfa, 0x69, 0x77, 0xb5,
+    0xda, 0xcd, 0xf0, 0xed, 0xc7, 0xeb, 0xd3, 0xfb, 0x3f, 0x6e, 0xce, 0xc8, 0xcc, 0x24, 0xf1, 0xf8,
+    0xcd, 0xd0, 0x3e, 0x48, 0xcc, 0x44, 0x34, 0xa2, 0xa9, 0x71, 0x3e, 0xdc, 0x52, 0x2b, 0x03, 0x16,
+    0xe2, 0x23, 0x01, 0xc3, 0x48, 0x30, 0x63, 0x4a, 0x83, 0x19, 0xd1, 0xcf, 0xf7, 0xe7, 0x4e, 0x9f,
+    0x56, 0x62, 0xc1, 0x12, 0x18, 0xd1, 0x39, 0x87, 0xc7, 0x54, 0x2a, 0x43, 0x49, 0x20, 0x85, 0x01,
+    0x81, 0xd3, 0x1e, 0x79, 0x68, 0x66, 0xa3, 0x10, 0xe6, 0x3c, 0x00, 0x27, 0x1f, 0xbc, 0x27, 0x5c,
+    0x70, 0xc3, 0x59, 0xec, 0xe8, 0x80, 0xc5, 0x30, 0x6a, 0xb7, 0xbc, 0xf7, 0x24, 0x61, 0x5f, 0x79,
+    0x92, 0x25, 0x75, 0x51, 0xa6, 0x41, 0xe5, 0x63, 0xe6, 0xa3, 0x48, 0x48, 0xbb, 0x96, 0xe1, 0x26,
+    0x86, 0xf1, 0xad, 0x34, 0x52, 0x91, 0x10, 0xc8, 0xc4, 0x2e, 0xc2, 0xc8, 0x6f, 0xbf, 0x9e, 0x0f,
+    0xdd, 0xe2, 0xd5, 0x9b, 0x61, 0xcc, 0xc5, 0x03, 0x51, 0x10, 0x8f, 0xa8, 0x36, 0x8b, 0x18, 0xf4,
+    0x0c, 0x00, 0xf9, 0xcc, 0x14, 0x4c, 0x47, 0x74, 0x66, 0x4c, 0xaa, 0x07, 0xae, 0x9b, 0x89, 0xf4,
+    0x21, 0x6a, 0x05, 0x32, 0x71, 0x63, 0x60, 0xd3, 0x18, 0xcc, 0x2f, 0xed, 0xd6, 0x71, 0xab, 0xeb,
+    0x86, 0x5c, 0x9b, 0x4a, 0xd4, 0x0a, 0xb4, 0xa6, 0xee, 0x77, 0x00, 0xdd, 0x5c, 0x64, 0xa7, 0xfe,
+    0x3c, 0x1f, 0x05, 0xed, 0x6e, 0x0f, 0x0e, 0xfb, 0x9e, 0xef, 0x7b, 0xde, 0x31, 0x9b, 0xfa, 0x94,
+    0x58, 0x75, 0x1d, 0x28, 0x9e, 0x1a, 0xa2, 0x55, 0xb0, 0xe3, 0xfa, 0x5f, 0x34, 0x1d, 0x0f, 0xdd,
+    0x42, 0x1d, 0x71, 0xdc, 0xd2, 0x0b, 0xbe, 0x0c, 0x17, 0xf8, 0x08, 0xf9, 0x9c, 0x04, 0x31, 0xd3,
+    0x7a, 0x44, 0xad, 0xad, 0x19, 0x17, 0xa0, 0x72, 0x5f, 0xb5, 0x9b, 0xcd, 0x83, 0xf2, 0x25, 0x25,
+    0x9d, 0xf9, 0xb9, 0xc5, 0xe8, 0xf8, 0x14, 0xd5, 0x95, 0x8c, 0xc1, 0x6a, 0xdc, 0x48, 0xcd, 0x03,
+    0x2e, 0xad, 0x37, 0x85, 0x91, 0x43, 0x24, 0x34, 0x5f, 0x59, 0x8b, 0xa9, 0x90, 0xae, 0x8b, 0x9c,
+    0x12, 0x2b, 0xd7, 0x67, 0x92, 0x4c, 0x4c, 0xc6, 0xe2, 0x06, 0x75, 0x8c, 0xab, 0x18, 0x1c, 0xdc,
+    0x66, 0x1a, 0xb3, 0x85, 0xc5, 0xd1, 0x29, 0x13, 0xcb, 0x2f, 0x7d, 0x1e, 0x51, 0xc2, 0x43, 0xc4,
+    0xcd, 0x94, 0x42, 0x16, 0x13, 0x2b, 0xa5, 0x63, 0xaf, 0xe5, 0xa1, 0x31, 0x70, 0xf6, 0xb8, 0xd0,
+    0xc9, 0x0d, 0x3f, 0xa2, 0x53, 0x24, 0xef, 0x68, 0xfe, 0x04, 0x83, 0x76, 0xab, 0x07, 0x09, 0x1d,
+    0xff, 0x14, 0x42, 0x74, 0x52, 0xce, 0x7c, 0x53, 0x67, 0x50, 0x2a, 0x24, 0x4c, 0x45, 0x5c, 0x38,
+    0x46, 0xa6, 0x83, 0xb6, 0x97, 0x7e, 0x3d, 0x21, 0xdf, 0x10, 0xbc, 0xd6, 0x31, 0x24, 0x27, 0x18,
+    0xba, 0xb1, 0x54, 0x83, 0x39, 0x53, 0x7b, 0x8e, 0x93, 0x64, 0x06, 0xc2, 0x7d, 0x24, 0x7a, 0xa6,
+    0x94, 0x1c, 0x90, 0x62, 0x69, 0x4b, 0x0e, 0x70, 0xac, 0x3e, 0x96, 0xfb, 0xa8, 0xb0, 0xeb, 0x9a,
+    0x2c, 0x08, 0x90, 0xfc, 0x7e, 0x89, 0xff, 0x08, 0x3c, 0x9a, 0x99, 0x81, 0x2f, 0xe3, 0x30, 0xdf,
+    0x8a, 0xf7, 0xef, 0x3f, 0xdb, 0x71, 0xec, 0xad, 0x52, 0xec, 0xf7, 0x36, 0x72, 0x44, 0xe3, 0xb7,
+    0xc8, 0xc4, 0xd7, 0x32, 0xce, 0x0c, 0xab, 0x93, 0x65, 0x85, 0x0c, 0xac, 0x77, 0x0c, 0x7a, 0x97,
+    0x2e, 0x59, 0x6f, 0x95, 0x5b, 0x8d, 0xda, 0x33, 0x42, 0x60, 0xcf, 0xe0, 0xef, 0x4c, 0x09, 0x2e,
+    0xa2, 0x95, 0xed, 0xfe, 0x30, 0x9d, 0x76, 0xf0, 0x67, 0x7d, 0xa3, 0x27, 0xa4, 0xf4, 0xf3, 0x40,
+    0x48, 0x81, 0x1e, 0x24, 0xff, 0xfd, 0xf5, 0x37, 0xb9, 0xbc, 0xb8, 0xba, 0xb8, 0x3f, 0x7b, 0xdb,
+    0xb4, 0xf9, 0x2a, 0x30, 0x0d, 0x33, 0x99, 0x2e, 0x42, 0xa0, 0xfc, 0x3c, 0xbe, 0x61, 0x8a, 0x85,
+    0xcf, 0xe1, 0xb8, 0x73, 0x54, 0x4e, 0xbe, 0x64, 0xda, 0x00, 0x39, 0xe7, 0xa2, 0x29, 0xa4, 0xa7,
+    0x78, 0x74, 0x1c, 0xdf, 0x08, 0x6d, 0x11, 0xfc, 0xcc, 0x18, 0x29, 0x56, 0x5f, 0x51, 0x22, 0x45,
+    0x10, 0xf3, 0xe0, 0x01, 0x6d, 0x19, 0x5a, 0xb0, 0x3d, 0xa7, 0xed, 0xa1, 0xc9, 0xf1, 0xff, 0xd0,
+    0x2d, 0x54, 0x76, 0xd2, 0xcd, 0x55, 0x5f, 0xa1, 0x69, 0x15, 0xdf, 0xbd, 0x4a, 0xd1, 0xcb, 0x35,
+    0xeb, 0x6c, 0xd7, 0x0d, 0xc1, 0x45, 0x9a, 0x19, 0x47, 0xc9, 0x47, 0x6b, 0x88, 0x7c, 0x40, 0xcc,
+    0x22, 0x45, 0x47, 0x8b, 0x2c, 0xf1, 0x31, 0xbb, 0xe4, 0x2e, 0x31, 0x18, 0x9b, 0x50, 0x1e, 0x4a,
+    0x92, 0x70, 0x31, 0xa2, 0x1e, 0xb5, 0xd9, 0x7b, 0x44, 0x3b, 0x87, 0x9e, 0x0d, 0x0d, 0x48, 0x51,
+    0xd4, 0x6a, 0x53, 0x32, 0x67, 0x71, 0x06, 0xf6, 0xf5, 0x1a, 0x4f, 0xa4, 0x48, 0xf0, 0xcf, 0x49,
+    0x15, 0xc7, 0x50, 0x5f, 0xd4, 0xe8, 0xea, 0x12, 0x7a, 0x0f, 0xe9, 0x5e, 0xdc, 0xae, 0xb3, 0xdd,
+    0xd9, 0xf5, 0x1f, 0xb9, 0x82, 0x40, 0x82, 0x26, 0xb7, 0x2c, 0xe5, 0x21, 0xd3, 0x0d, 0x08, 0xa9,
+    0x02, 0x5c, 0x56, 0xd3, 0x26, 0x69, 0x8d, 0x5a, 0x24, 0xef, 0xe5, 0x9e, 0x35, 0xe3, 0x52, 0xce,
+    0xc2, 0xb5, 0x3f, 0x55, 0x79, 0xc9, 0x57, 0x63, 0x6f, 0x23, 0xfe, 0x2a, 0x52, 0xb7, 0xd7, 0x04,
+    0x75, 0x56, 0xc3, 0xea, 0xf6, 0xb6, 0x06, 0x3b, 0x6e, 0xe2, 0x75, 0x59, 0xc3, 0x3a, 0xde, 0x9e,
+    0x58, 0xbb, 0xd3, 0xc4, 0xec, 0xae, 0xce, 0x0c, 0xa7, 0x6c, 0x0f, 0xd7, 0x6f, 0xe2, 0x76, 0x57,
+    0x47, 0xeb, 0x6f, 0x4f, 0xee, 0xe0, 0xa0, 0x91, 0xdc, 0x75, 0x0d, 0x0e, 0xa7, 0x6c, 0x0f, 0x77,
+    0xd4, 0x44, 0x6e, 0x09, 0xed, 0x68, 0x7b, 0x72, 0x9d, 0x76, 0xa3, 0x4f, 0xeb, 0x70, 0x38, 0x65,
+    0x25, 0x94, 0x77, 0x8e, 0xe8, 0x2b, 0x96, 0x32, 0xe2, 0x90, 0xd3, 0x98, 0xff, 0x99, 0x01, 0x49,
+    0x31, 0x33, 0x92, 0x2b, 0xae, 0x98, 0x22, 0x2e, 0x99, 0x28, 0xc5, 0x6c, 0xa2, 0x63, 0xe4, 0x5e,
+    0xe2, 0xdd, 0xd9, 0x80, 0x9d, 0xb0, 0xd4, 0x09, 0x8a, 0xfb, 0x5e, 0x6f, 0x3e, 0x97, 0x1a, 0x8f,
+    0x8c, 0x08, 0x97, 0x4f, 0xe6, 0x93, 0x94, 0xc9, 0x85, 0xb0, 0xe7, 0xf2, 0xdd, 0xc6, 0xfc, 0xf3,
+    0x3d, 0xfd, 0xeb, 0xcc, 0x58, 0x00, 0xe7, 0x55, 0x00, 0xf6, 0x3a, 0x05, 0x85, 0xbb, 0xb7, 0x10,
+    0xa7, 0x38, 0x50, 0x2c, 0xe6, 0x4f, 0x4c, 0x35, 0xa7, 0x34, 0x9b, 0xaa, 0x70, 0xb3, 0xb6, 0x82,
+    0x6a, 0x34, 0x02, 0x17, 0x53, 0x59, 0x1a, 0x79, 0x9c, 0x1b, 0xab, 0xba, 0x2f, 0xcb, 0x39, 0x98,
+    0xbc, 0xca, 0x7c, 0x27, 0x1f, 0x41, 0x9d, 0x4a, 0xa9, 0x42, 0x34, 0x98, 0x73, 0x70, 0xd0, 0xea,
+    0xbf, 0x27, 0x4e, 0xf7, 0xe8, 0x5b, 0x35, 0xf2, 0x0d, 0x7f, 0x3c, 0x89, 0xe7, 0x72, 0x23, 0x4e,
+    0x9e, 0x37, 0x9f, 0x81, 0x9a, 0xb4, 0x9f, 0xb8, 0xbd, 0xca, 0x37, 0x01, 0xb0, 0xfc, 0xf5, 0xac,
+    0x59, 0x17, 0x2b, 0x11, 0xc3, 0x44, 0xc0, 0xd9, 0x26, 0xed, 0xb0, 0x98, 0x00, 0xeb, 0xea, 0xaf,
+    0x8d, 0xc3, 0x53, 0x34, 0xbf, 0xaf, 0x98, 0xad, 0xf6, 0x80, 0x60, 0x0d, 0x39, 0xe5, 0x51, 0x96,
+    0x0f, 0x2b, 0xa8, 0x1d, 0x5c, 0x5b, 0x40, 0x19, 0x9b, 0xf6, 0xab, 0xe2, 0x22, 0x6f, 0x15, 0xb0,
+    0x44, 0xf3, 0x7e, 0x3c, 0x21, 0x65, 0x3d, 0xe4, 0x4b, 0x04, 0x4c, 0xf2, 0xb2, 0x0d, 0x13, 0x3b,
+    0xe0, 0x6d, 0xc7, 0x15, 0xf9, 0x84, 0xed, 0x06, 0x90, 0x3d, 0x8f, 0x44, 0x8a, 0x65, 0x7a, 0xff,
+    0xa5, 0xd0, 0xaa, 0xad, 0x38, 0x95, 0x2a, 0x80, 0x5b, 0xa4, 0x32, 0x07, 0xb5, 0xd8, 0x7a, 0xd5,
+    0x13, 0xe2, 0xb3, 0xe0, 0x21, 0x52, 0x32, 0x13, 0xa1, 0xad, 0x7b, 0x0e, 0x0f, 0x3d, 0xbc, 0xdd,
+    0xce, 0x11, 0x0b, 0x8f, 0xdf, 0x2d, 0x60, 0xd5, 0x2d, 0x24, 0x41, 0x7b, 0x5c, 0xf2, 0x84, 0x23,
+    0xa9, 0x3b, 0x40, 0x8b, 0xc8, 0x1a, 0xa3, 0x66, 0x4b, 0x36, 0x55, 0xa6, 0x3d, 0xbb, 0xc5, 0x0b,
+    0x81, 0xec, 0x30, 0xe6, 0x49, 0x75, 0x89, 0x35, 0x94, 0x8a, 0x55, 0x89, 0x85, 0x1d, 0x03, 0xd2,
+    0x8b, 0x58, 0x55, 0xd5, 0xae, 0x94, 0xb9, 0xbb, 0x9d, 0x75, 0x23, 0x23, 0xbc, 0x83, 0xaf, 0x6c,
+    0x1b, 0x51, 0xb3, 0x8d, 0x5d, 0x62, 0xd0, 0xa6, 0xf5, 0xb2, 0x30, 0xb1, 0x53, 0x0a, 0x9a, 0x98,
+    0x98, 0xec, 0x60, 0x60, 0x1d, 0x92, 0xd8, 0xda, 0xbf, 0x2a, 0xf0, 0x5e, 0x71, 0xd4, 0x8b, 0xf5,
+    0xcf, 0x44, 0x20, 0x43, 0xf8, 0x0e, 0x03, 0x28, 0x26, 0x55, 0x1c, 0x4a, 0x9d, 0x17, 0x58, 0xac,
+    0x9b, 0x70, 0xa9, 0xba, 0x6e, 0x2e, 0xae, 0x97, 0xec, 0xd9, 0xb7, 0xf6, 0x35, 0xf0, 0xd5, 0x38,
+    0x18, 0xb6, 0x91, 0x18, 0x14, 0x89, 0x09, 0x59, 0x7d, 0xd6, 0x40, 0xf0, 0x57, 0x92, 0xdc, 0x2c,
+    0x24, 0xca, 0xb3, 0x32, 0x86, 0x43, 0x9e, 0x70, 0x99, 0xe2, 0x92, 0xc8, 0xac, 0x98, 0x80, 0x9d,
+    0x4e, 0x16, 0xe3, 0x23, 0xb3, 0x6d, 0x16, 0x53, 0xc8, 0x09, 0x2b, 0xa9, 0x0c, 0xa3, 0x99, 0xe7,
+    0xfb, 0xe0, 0xa1, 0x7c, 0xe1, 0x5c, 0x4e, 0xa5, 0xcc, 0xd7, 0x2b, 0xda, 0x3c, 0x6c, 0xee, 0xc8,
+    0xd9, 0xdd, 0x4d, 0xe7, 0xc0, 0xb9, 0xeb, 0xe0, 0xb5, 0x70, 0x7d, 0x3f, 0xc1, 0xe6, 0x8b, 0xcf,
+    0x57, 0x8b, 0xe5, 0x7a, 0x17, 0xea, 0xb2, 0x34, 0xc5, 0xee, 0x12, 0x3b, 0x56, 0xe8, 0x1d, 0x06,
+    0xbd, 0xe3, 0x23, 0xaf, 0x73, 0x74, 0x80, 0x4d, 0x67, 0xb7, 0xb3, 0xdc, 0x70, 0x96, 0x9d, 0xa6,
+    0x5b, 0x7c, 0x33, 0xf0, 0x3f, 0x81, 0xec, 0x4d, 0x56, 0x2a, 0x10, 0x00, 0x00,
+};
+
+const size_t INDEX_HTML_GZ_LEN = 1389;
+
+#define INDEX_HTML_ETAG "\"513b1c7ac4ef0c3a\""
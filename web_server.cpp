@@ -1,6 +1,25 @@
 #include "web_server.h"
 #include "config.h"
-#include "web_assets.h"
+#include "web_assets_gz.h"  // Gerado por build_web_assets.py a partir de web_assets.h
+#include "control_loop.h"
+#include "deferred_log.h"
+#include "profiler.h"
+#include "metrics_writer.h"
+#if PLANT_SIMULATION
+#include "sim_benchmark.h"
+#endif
+#if SAT_TRACKER_ENABLED
+#include "sat_tracker.h"
+#endif
+#if JOURNAL_ENABLED
+#include "position_journal.h"
+#endif
+#if MT6701_ENABLED
+#include "absolute_encoder.h"
+#endif
+#if TRACE_ENABLED
+#include <memory>
+#endif
 
 WebServerManager::WebServerManager(MotorController* motor, Encoder* enc, StorageManager* store)
     : motorController(motor), encoder(enc), storage(store) {
@@ -18,11 +37,15 @@ void WebServerManager::begin() {
     server->on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
         this->handleRoot(request);
     });
-    server->on("/style.css", HTTP_GET, [](AsyncWebServerRequest *request) {
-        request->send_P(200, "text/css", STYLE_CSS);
+    // CSS/JS sao referenciados pelo index com "?v=<hash>": a URL muda a cada
+    // conteudo novo, entao podem ficar em cache indefinidamente
+    server->on("/style.css", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        this->sendGzipAsset(request, "text/css", STYLE_CSS_GZ, STYLE_CSS_GZ_LEN,
+                            STYLE_CSS_ETAG, ASSET_CACHE_IMMUTABLE);
     });
-    server->on("/app.js", HTTP_GET, [](AsyncWebServerRequest *request) {
-        request->send_P(200, "application/javascript", APP_JS);
+    server->on("/app.js", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        this->sendGzipAsset(request, "application/javascript", APP_JS_GZ, APP_JS_GZ_LEN,
+                            APP_JS_ETAG, ASSET_CACHE_IMMUTABLE);
     });
     server->on("/api/status", HTTP_GET, [this](AsyncWebServerRequest *request) {
         this->handleStatus(request);
@@ -39,6 +62,170 @@ void WebServerManager::begin() {
     server->on("/api/stop", HTTP_POST, [this](AsyncWebServerRequest *request) {
         this->handleStop(request);
     });
+    server->on("/api/trajectory", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        this->handleTrajectory(request);
+    });
+    server->on("/api/diag", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        this->handleDiag(request);
+    });
+    server->on("/metrics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        this->handleMetrics(request);
+    });
+    server->on("/api/autotune", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        StaticJsonDocument<1024> doc;
+        motorController->writeAutotuneJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    server->on("/api/autotune", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        // Experimento em malha aberta nos dois sentidos; acompanhar por GET /api/autotune
+        if (!motorController->startAutotune(COMMAND_SOURCE_NETWORK)) {
+            request->send(503, "application/json", "{\"error\":\"fila de comandos cheia\"}");
+            return;
+        }
+        request->send(202, "application/json", "{\"status\":\"started\"}");
+    });
+    server->on("/api/autotune/reset", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        if (!motorController->resetTuning(COMMAND_SOURCE_NETWORK)) {
+            request->send(503, "application/json", "{\"error\":\"fila de comandos cheia\"}");
+            return;
+        }
+        request->send(200, "application/json", "{\"status\":\"defaults\"}");
+    });
+    server->on("/api/dynamics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        // Tabela de dinamica por setor de azimute e sentido (ver sector_dynamics.h)
+        DynamicJsonDocument doc(6144);
+        motorController->writeSectorJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    server->on("/api/loop", HTTP_GET, [](AsyncWebServerRequest *request) {
+        // Histograma de jitter/overrun do timer de controle (?reset=1 zera)
+        StaticJsonDocument<768> doc;
+        controlLoop.writeStatsJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+        if (request->hasParam("reset")) controlLoop.resetStats();
+    });
+    #if PROFILER_ENABLED
+    server->on("/api/profile", HTTP_GET, [](AsyncWebServerRequest *request) {
+        // Ciclos de CPU por etapa da motorTask (?reset=1 zera depois de responder)
+        DynamicJsonDocument doc(3072);
+        cycleProfiler.writeJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+        if (request->hasParam("reset")) cycleProfiler.requestReset();
+    });
+    #endif
+    #if PLANT_SIMULATION
+    server->on("/api/sim", HTTP_GET, [](AsyncWebServerRequest *request) {
+        DynamicJsonDocument doc(2048);
+        doc["running"] = simBenchmark.isRunning();
+        simBenchmark.writeResultsJSON(doc.createNestedArray("results"));
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    server->on("/api/sim/run", HTTP_POST, [](AsyncWebServerRequest *request) {
+        if (simBenchmark.start()) request->send(200, "application/json", "{\"status\":\"started\"}");
+        else request->send(409, "application/json", "{\"error\":\"already running\"}");
+    });
+    #endif
+    #if SAT_TRACKER_ENABLED
+    server->on("/api/sat", HTTP_GET, [](AsyncWebServerRequest *request) {
+        DynamicJsonDocument doc(2048);
+        satTracker.writeStatusJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    server->on("/api/sat/tle", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        // name (opcional), line1, line2 - formato NORAD de 69 colunas
+        if (!request->hasParam("line1", true) || !request->hasParam("line2", true)) {
+            request->send(400, "application/json", "{\"error\":\"missing line1/line2\"}");
+            return;
+        }
+        String name = request->hasParam("name", true) ? request->getParam("name", true)->value() : String("SAT");
+        String line1 = request->getParam("line1", true)->value();
+        String line2 = request->getParam("line2", true)->value();
+        line1.trim();
+        line2.trim();
+        if (!satTracker.setTle(name.c_str(), line1.c_str(), line2.c_str())) {
+            request->send(400, "application/json", "{\"error\":\"invalid or deep-space TLE\"}");
+            return;
+        }
+        storage->saveSatelliteTle(name.c_str(), line1.c_str(), line2.c_str());
+        request->send(200, "application/json", "{\"status\":\"ok\"}");
+    });
+    server->on("/api/sat/qth", HTTP_POST, [this](AsyncWebServerRequest *request) {
+        if (!request->hasParam("lat", true) || !request->hasParam("lon", true)) {
+            request->send(400, "application/json", "{\"error\":\"missing lat/lon\"}");
+            return;
+        }
+        float lat = request->getParam("lat", true)->value().toFloat();
+        float lon = request->getParam("lon", true)->value().toFloat();
+        float alt = request->hasParam("alt", true) ? request->getParam("alt", true)->value().toFloat() : 0.0f;
+        if (lat < -90 || lat > 90 || lon < -180 || lon > 180) {
+            request->send(400, "application/json", "{\"error\":\"lat/lon out of range\"}");
+            return;
+        }
+        satTracker.setQth(lat, lon, alt);
+        storage->saveQth(lat, lon, alt);
+        request->send(200, "application/json", "{\"status\":\"ok\"}");
+    });
+    server->on("/api/sat/track", HTTP_POST, [](AsyncWebServerRequest *request) {
+        bool enable = request->hasParam("enable", true) &&
+                      request->getParam("enable", true)->value().toInt() != 0;
+        satTracker.setTracking(enable);
+        request->send(200, "application/json", enable ? "{\"tracking\":true}" : "{\"tracking\":false}");
+    });
+    server->on("/api/sat/selftest", HTTP_GET, [](AsyncWebServerRequest *request) {
+        StaticJsonDocument<512> doc;
+        satTracker.runSelfTest(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    #endif
+    #if JOURNAL_ENABLED
+    server->on("/api/journal/selftest", HTTP_GET, [](AsyncWebServerRequest *request) {
+        StaticJsonDocument<256> doc;
+        positionJournal.runSelfTest(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    #endif
+    #if TRACE_ENABLED
+    server->on("/api/trace", HTTP_GET, [](AsyncWebServerRequest *request) {
+        StaticJsonDocument<384> doc;
+        traceRecorder.writeStatusJSON(doc.to<JsonObject>());
+        String output;
+        serializeJson(doc, output);
+        request->send(200, "application/json", output);
+    });
+    server->on("/api/trace/start", HTTP_POST, [](AsyncWebServerRequest *request) {
+        traceRecorder.requestStart();
+        request->send(200, "application/json", "{\"status\":\"started\"}");
+    });
+    server->on("/api/trace/stop", HTTP_POST, [](AsyncWebServerRequest *request) {
+        traceRecorder.requestStop();
+        request->send(200, "application/json", "{\"status\":\"stopped\"}");
+    });
+    server->on("/api/trace/arm", HTTP_POST, [](AsyncWebServerRequest *request) {
+        bool enable = request->hasParam("enable", true) &&
+                      request->getParam("enable", true)->value().toInt() != 0;
+        traceRecorder.setAutoTrigger(enable);
+        request->send(200, "application/json", enable ? "{\"autoTrigger\":true}" : "{\"autoTrigger\":false}");
+    });
+    server->on("/api/trace/download", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        this->handleTraceDownload(request);
+    });
+    #endif
     server->begin();
     Serial.println("WebServer started");
 }
@@ -51,12 +238,13 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketCl
                                         AwsEventType type, void *arg, uint8_t *data, size_t len) {
     if (type == WS_EVT_CONNECT) {
         Serial.printf("WS client #%u connected\n", client->id());
-    // Enviar estado inicial ao cliente recém-conectado para evitar valores defasados
-        String status = getStatusJSON();
-        Serial.printf("Enviando status inicial: %s\n", status.c_str());
-        client->text(status);
+        registerClient(client->id());
+        // Enviar estado inicial ao cliente recém-conectado para evitar valores defasados
+        // (JSON ate o cliente negociar o formato binario)
+        sendStatusTo(client, false);
     } else if (type == WS_EVT_DISCONNECT) {
         Serial.printf("WS client #%u disconnected\n", client->id());
+        unregisterClient(client->id());
     } else if (type == WS_EVT_DATA) {
         AwsFrameInfo *info = (AwsFrameInfo*)arg;
         if (info->final && info->index == 0 && info->len == len && info->opcode == WS_TEXT) {
@@ -64,21 +252,51 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketCl
             String msg = (char*)data;
             Serial.printf("WS received: %s\n", msg.c_str());
             
-            StaticJsonDocument<256> doc;
+            StaticJsonDocument<WS_COMMAND_JSON_SIZE> doc;
             DeserializationError error = deserializeJson(doc, msg);
             if (!error) {
+                if (doc.containsKey("format")) {
+                    // Negociacao: {"format":"binary"} ou {"format":"json"}
+                    const char* format = doc["format"];
+                    bool binary = format && strcmp(format, "binary") == 0;
+                    setClientBinary(client->id(), binary);
+                    sendStatusTo(client, binary);
+                    Serial.printf("WS client #%u: formato %s\n", client->id(), binary ? "binario" : "JSON");
+                }
+                if (doc.containsKey("stream")) {
+                    // {"stream":hz} = envio periodico tambem durante o movimento; 0 = modo legado
+                    int hz = doc["stream"];
+                    hz = constrain(hz, 0, WS_STREAM_MAX_HZ);
+                    setClientStream(client->id(), (uint16_t)hz);
+                    Serial.printf("WS client #%u: stream %d Hz\n", client->id(), hz);
+                }
                 if (doc.containsKey("angle")) {
                     float angle = doc["angle"];
-                    // Motor fará validação e reroteamento automático
-                    motorController->moveToAngle(angle);
-                    Serial.printf("Moving to angle: %.1f\n", angle);
+                    // Motor fará validação e reroteamento automático (arrasto do
+                    // slider: alvos seguidos se fundem na fila, sem log por mensagem)
+                    motorController->moveToAngle(angle, COMMAND_SOURCE_NETWORK);
+                }
+                if (doc.containsKey("trajectory")) {
+                    // {"trajectory":[[ms,az],...],"append":false} - ms relativo ao recebimento
+                    TrajectoryWaypoint points[TRAJECTORY_MAX_WAYPOINTS];
+                    uint32_t now = millis();
+                    int count = 0;
+                    for (JsonVariant point : doc["trajectory"].as<JsonArray>()) {
+                        if (count >= TRAJECTORY_MAX_WAYPOINTS || point.size() < 2) break;
+                        points[count].timeMs = now + point[0].as<uint32_t>();
+                        points[count].azimuth = point[1].as<float>();
+                        count++;
+                    }
+                    bool append = doc["append"].as<bool>();
+                    int accepted = motorController->loadTrajectory(points, count, append, COMMAND_SOURCE_NETWORK);
+                    Serial.printf("Trajectory: %d/%d waypoints%s\n", accepted, count, append ? " (append)" : "");
                 }
                 if (doc.containsKey("manual")) {
                     int speed = doc["manual"];
-                    motorController->manualMove(speed);
+                    motorController->manualMove(speed, COMMAND_SOURCE_NETWORK);
                 }
                 if (doc.containsKey("stop")) {
-                    motorController->stop();
+                    motorController->stop(COMMAND_SOURCE_NETWORK);
                 }
                 if (doc.containsKey("calibrate")) {
                     float offset = -encoder->getRawAngle();
@@ -87,12 +305,15 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketCl
                     // Resetar posição absoluta para 0° (norte)
                     motorController->resetAbsolutePosition(0.0);
                     storage->saveAbsolutePosition(0.0);
+                    #if MT6701_ENABLED
+                    absoluteEncoder.rephase();  // Fase do MT6701 relativa ao novo norte
+                    #endif
                     Serial.println("Calibrated to North (absolute position reset to 0)");
                 }
                 if (doc.containsKey("forceRecovery")) {
                     // Forçar recuperação: mover para 0° (qualquer comando dispara recuperação automática)
                     Serial.println("RECUPERACAO FORCADA pelo usuario");
-                    motorController->moveToAngle(0.0); // Tentar ir para 0°, recuperação automática ativará
+                    motorController->moveToAngle(0.0, COMMAND_SOURCE_NETWORK); // Tentar ir para 0°, recuperação automática ativará
                 }
                 if (doc.containsKey("invertMotor")) {
                     runtimeMotorInvert = doc["invertMotor"].as<bool>();
@@ -102,14 +323,18 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketCl
                 if (doc.containsKey("invertEncoder")) {
                     runtimeEncoderInvert = doc["invertEncoder"].as<bool>();
                     encoder->setRuntimeInvert(runtimeEncoderInvert);
+                    #if MT6701_ENABLED
+                    absoluteEncoder.rephase();
+                    #endif
                     Serial.printf("Encoder inversion: %s\n", runtimeEncoderInvert ? "INVERTED" : "NORMAL");
                 }
                 // Controle de velocidade removido para simplificar
                 
                 // Comandos do sistema de aprendizado
                 if (doc.containsKey("resetLearning")) {
-                    motorController->resetLearning();
-                    Serial.println("Motor learning reset!");
+                    if (motorController->resetLearning(COMMAND_SOURCE_NETWORK)) {
+                        Serial.println("Motor learning reset!");
+                    }
                 }
                 if (doc.containsKey("getLearning")) {
                     // Enviar status do aprendizado
@@ -127,83 +352,249 @@ void WebServerManager::onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketCl
 }
 
 void WebServerManager::broadcastStatus() { 
-    // Limpar fila antiga e enviar apenas se tiver espaco
+    // Chamado a cada passada do loop(); cada cliente tem seu proprio agendamento
     ws->cleanupClients();
 
-    static unsigned long lastSend = 0;
-    static bool wasMoving = false;
     unsigned long now = millis();
     bool isMoving = motorController->isInMotion();
 
-    // Logica solicitada: "atualize o angulo do site somente apos finalizar o movimento"
-    // Se estiver movendo, NAO envia updates (exceto talvez o primeiro para indicar inicio)
-    // Se parou (borda de descida), envia update final.
-    
-    // Se esta movendo e ja estava movendo, ignora (silencio durante movimento)
+    // Clientes legados (sem {"stream":hz}): "atualize o angulo do site somente apos
+    // finalizar o movimento" - silencio durante o movimento, envio imediato nas
+    // bordas (Parou->Andou, Andou->Parou) e heartbeat lento de 1Hz parado.
+    bool legacyDue;
     if (isMoving && wasMoving) {
-        return;
-    }
-
-    // Se nao esta movendo e ja nao estava (idle), limita frequencia (heartbeat lento 1Hz)
-    if (!isMoving && !wasMoving) {
-        if (now - lastSend < 1000) return;
+        legacyDue = false;
+    } else if (!isMoving && !wasMoving) {
+        legacyDue = (now - lastLegacySend >= 1000);
+    } else {
+        legacyDue = true;
     }
     
-    // Se mudou de estado (Parou->Andou ou Andou->Parou), envia imediatamente
-    // Ou se eh o heartbeat
-    
     // Se o motor parou (estava movendo e agora não está mais), salvar posição
     if (wasMoving && !isMoving) {
-        float currentPos = encoder->getAngle();
-        float absPos = motorController->getAbsolutePosition();
+        MotorState state = motorController->getState();
+        float currentPos = state.angle;
+        float absPos = state.absolutePosition;
         storage->saveLastPosition(currentPos);
         storage->saveAbsolutePosition(absPos);
         Serial.printf("Movimento finalizado. Pos: %.1f | Abs: %.1f\n", currentPos, absPos);
     }
+    wasMoving = isMoving;
+    if (legacyDue) lastLegacySend = now;
     
-    if (ws->count() > 0) {
-        if (ws->availableForWriteAll()) {
-            ws->textAll(getStatusJSON());
-            lastSend = now;
+    if (ws->count() == 0) return;
+
+    WsClientState clients[WS_MAX_CLIENTS];
+    portENTER_CRITICAL(&clientsMux);
+    memcpy(clients, wsClients, sizeof(clients));
+    portEXIT_CRITICAL(&clientsMux);
+
+    // Quem recebe algo nesta passada (e em qual formato)
+    bool due[WS_MAX_CLIENTS];
+    bool needJson = false;
+    bool needFrame = false;
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        WsStreamState& stream = wsStream[i];
+        if (stream.id != clients[i].id || stream.binary != clients[i].binary) {
+            // Slot novo/reutilizado ou troca de formato: recomecar com keyframe
+            uint32_t dropped = (stream.id == clients[i].id) ? stream.dropped : 0;
+            memset(&stream, 0, sizeof(stream));
+            stream.id = clients[i].id;
+            stream.binary = clients[i].binary;
+            stream.dropped = dropped;
+        }
+        if (clients[i].id == 0) {
+            due[i] = false;
+        } else if (clients[i].streamHz == 0) {
+            due[i] = legacyDue;
+        } else {
+            due[i] = (now - stream.lastSendMs >= 1000UL / clients[i].streamHz);
+        }
+        if (due[i]) {
+            if (clients[i].binary) needFrame = true;
+            else needJson = true;
         }
     }
     
-    wasMoving = isMoving;
+    // Cada formato e serializado no maximo uma vez por passada
+    char json[WS_JSON_BUFFER_SIZE];
+    size_t jsonLen = 0;
+    TelemetryFrame frame;
+    if (needJson) jsonLen = writeStatusJSON(json, sizeof(json));
+    if (needFrame) buildTelemetryFrame(frame);
+
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (!due[i]) continue;
+        uint32_t id = clients[i].id;
+        WsStreamState& stream = wsStream[i];
+        stream.lastSendMs = now;
+        
+        // Controle de fluxo por cliente: um cliente lento perde o proprio frame,
+        // os demais continuam recebendo
+        if (!ws->availableForWrite(id)) {
+            stream.dropped++;
+            wsDroppedFrames++;
+            continue;
+        }
+        
+        if (!clients[i].binary) {
+            ws->text(id, json, jsonLen);
+        } else if (clients[i].streamHz == 0) {
+            ws->binary(id, (uint8_t*)&frame, sizeof(frame));
+        } else {
+            sendStreamFrame(id, stream, now, frame);
+        }
+    }
+}
+
+void WebServerManager::sendStreamFrame(uint32_t id, WsStreamState& stream, unsigned long now, const TelemetryFrame& frame) {
+    if (!stream.hasKeyframe || now - stream.lastKeyframeMs >= WS_STREAM_KEYFRAME_MS) {
+        ws->binary(id, (uint8_t*)&frame, sizeof(frame));
+        stream.hasKeyframe = true;
+        stream.lastKeyframeMs = now;
+    } else {
+        uint8_t delta[TELEMETRY_DELTA_MAX_SIZE];
+        size_t len = telemetryEncodeDelta(stream.lastSent, frame, delta);
+        if (len == 0) return;  // Nada mudou: nao gasta banda
+        ws->binary(id, delta, len);
+    }
+    stream.lastSent = frame;
 }
 
 String WebServerManager::getStatusJSON() {
+    char json[WS_JSON_BUFFER_SIZE];
+    writeStatusJSON(json, sizeof(json));
+    return String(json);
+}
+
+size_t WebServerManager::writeStatusJSON(char* out, size_t size) {
     StaticJsonDocument<384> doc;  // Aumentado para incluir dados de aprendizado
-    float currentAngle = encoder->getAngle();
-    float targetAngle = motorController->getTargetAngle();
+    // Um unico snapshot publicado pela motorTask (sem locks, valores consistentes entre si)
+    MotorState state = motorController->getState();
+    float currentAngle = state.angle;
+    float targetAngle = state.targetAngle;
     float error = targetAngle - currentAngle;
     
     // Normalizar erro para -180 a 180
     while (error > 180.0) error -= 360.0;
     while (error <= -180.0) error += 360.0;
     
-    // Normalizar erro para -180 a 180
-    while (error > 180.0) error -= 360.0;
-    while (error <= -180.0) error += 360.0;
-    
     doc["angle"] = currentAngle;
     doc["target"] = targetAngle;
     doc["error"] = error;
-    doc["moving"] = motorController->isInMotion();
+    doc["moving"] = (state.flags & MOTOR_FLAG_IN_MOTION) != 0;
     doc["calibration"] = encoder->getCalibrationOffset();
-    doc["absolutePosition"] = motorController->getAbsolutePosition();
+    doc["absolutePosition"] = state.absolutePosition;
     
-    // Dados do sistema de aprendizado
+    // Dados do sistema de aprendizado (formatados na pilha, sem String temporaria;
+    // os buffers precisam viver ate o serializeJson abaixo)
+    char inertia[12];
+    char braking[12];
+    snprintf(inertia, sizeof(inertia), "%.3f", motorController->getInertiaFactor());
+    snprintf(braking, sizeof(braking), "%.4f", motorController->getBrakingDistance());
     doc["learning"]["cycles"] = motorController->getLearningCycles();
-    doc["learning"]["inertia"] = serialized(String(motorController->getInertiaFactor(), 3));
-    doc["learning"]["braking"] = serialized(String(motorController->getBrakingDistance(), 4));
+    doc["learning"]["inertia"] = serialized((const char*)inertia);
+    doc["learning"]["braking"] = serialized((const char*)braking);
     
-    String output;
-    serializeJson(doc, output);
-    return output;
+    return serializeJson(doc, out, size);
+}
+
+void WebServerManager::buildTelemetryFrame(TelemetryFrame& frame) {
+    MotorState state = motorController->getState();
+    float error = state.targetAngle - state.angle;
+    while (error > 180.0) error -= 360.0;
+    while (error <= -180.0) error += 360.0;
+    
+    frame.magic = TELEMETRY_MAGIC;
+    frame.version = TELEMETRY_VERSION;
+    frame.type = TELEMETRY_TYPE_STATUS;
+    frame.flags = state.flags;
+    frame.angleCdeg = (int16_t)lroundf(state.angle * 100.0f);
+    frame.targetCdeg = (int32_t)lroundf(state.targetAngle * 100.0f);
+    frame.errorMdeg = (int32_t)lroundf(error * 1000.0f);
+    frame.absPositionCdeg = (int32_t)lroundf(state.absolutePosition * 100.0f);
+    frame.calibrationCdeg = (int32_t)lroundf(encoder->getCalibrationOffset() * 100.0f);
+    frame.learningCycles = (uint16_t)constrain(motorController->getLearningCycles(), 0, 65535);
+    frame.inertiaMilli = (uint16_t)lroundf(motorController->getInertiaFactor() * 1000.0f);
+    frame.brakingE4 = (uint16_t)lroundf(motorController->getBrakingDistance() * 10000.0f);
+}
+
+void WebServerManager::sendStatusTo(AsyncWebSocketClient *client, bool binary) {
+    if (binary) {
+        TelemetryFrame frame;
+        buildTelemetryFrame(frame);
+        client->binary((uint8_t*)&frame, sizeof(frame));
+    } else {
+        char json[WS_JSON_BUFFER_SIZE];
+        size_t len = writeStatusJSON(json, sizeof(json));
+        client->text(json, len);
+    }
+}
+
+void WebServerManager::registerClient(uint32_t id) {
+    bool registered = false;
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (wsClients[i].id == 0) {
+            wsClients[i].id = id;
+            wsClients[i].binary = false;
+            wsClients[i].streamHz = 0;
+            registered = true;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&clientsMux);
+    if (!registered) {
+        Serial.printf("WS client #%u: tabela de clientes cheia\n", id);
+    }
+}
+
+void WebServerManager::unregisterClient(uint32_t id) {
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (wsClients[i].id == id) wsClients[i].id = 0;
+    }
+    portEXIT_CRITICAL(&clientsMux);
+}
+
+void WebServerManager::setClientStream(uint32_t id, uint16_t hz) {
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (wsClients[i].id == id) wsClients[i].streamHz = hz;
+    }
+    portEXIT_CRITICAL(&clientsMux);
+}
+
+void WebServerManager::setClientBinary(uint32_t id, bool binary) {
+    portENTER_CRITICAL(&clientsMux);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (wsClients[i].id == id) wsClients[i].binary = binary;
+    }
+    portEXIT_CRITICAL(&clientsMux);
 }
 
 void WebServerManager::handleRoot(AsyncWebServerRequest *request) {
-    request->send_P(200, "text/html", INDEX_HTML);
+    // O index tem URL fixa: o navegador sempre revalida (304 se nada mudou)
+    sendGzipAsset(request, "text/html", INDEX_HTML_GZ, INDEX_HTML_GZ_LEN,
+                  INDEX_HTML_ETAG, ASSET_CACHE_REVALIDATE);
+}
+
+void WebServerManager::sendGzipAsset(AsyncWebServerRequest *request, const char* contentType,
+                                     const uint8_t* data, size_t len, const char* etag,
+                                     const char* cacheControl) {
+    // Revalidacao: mesmo ETag = 304 sem corpo (nao ocupa a pilha TCP)
+    if (request->hasHeader("If-None-Match") && request->getHeader("If-None-Match")->value() == etag) {
+        AsyncWebServerResponse *response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", cacheControl);
+        request->send(response);
+        return;
+    }
+    AsyncWebServerResponse *response = request->beginResponse_P(200, contentType, data, len);
+    response->addHeader("Content-Encoding", "gzip");
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
 }
 
 void WebServerManager::handleStatus(AsyncWebServerRequest *request) {
@@ -213,7 +604,10 @@ void WebServerManager::handleStatus(AsyncWebServerRequest *request) {
 void WebServerManager::handleSetAngle(AsyncWebServerRequest *request) {
     if (request->hasParam("angle", true)) {
         float angle = request->getParam("angle", true)->value().toFloat();
-        motorController->moveToAngle(angle);
+        if (!motorController->moveToAngle(angle, COMMAND_SOURCE_NETWORK)) {
+            request->send(503, "application/json", "{\"error\":\"command queue full\"}");
+            return;
+        }
         storage->saveLastTarget(angle);  // Salvar alvo para restaurar após reboot
         request->send(200, "application/json", "{\"status\":\"ok\"}");
     } else request->send(400, "application/json", "{\"error\":\"missing angle\"}");
@@ -222,7 +616,10 @@ void WebServerManager::handleSetAngle(AsyncWebServerRequest *request) {
 void WebServerManager::handleManualControl(AsyncWebServerRequest *request) {
     if (request->hasParam("speed", true)) {
         int speed = request->getParam("speed", true)->value().toInt();
-        motorController->manualMove(speed);
+        if (!motorController->manualMove(speed, COMMAND_SOURCE_NETWORK)) {
+            request->send(503, "application/json", "{\"error\":\"command queue full\"}");
+            return;
+        }
         request->send(200, "application/json", "{\"status\":\"ok\"}");
     } else request->send(400, "application/json", "{\"error\":\"missing speed\"}");
 }
@@ -235,10 +632,295 @@ void WebServerManager::handleCalibrate(AsyncWebServerRequest *request) {
 }
 
 void WebServerManager::handleStop(AsyncWebServerRequest *request) {
-    motorController->stop();
+    motorController->stop(COMMAND_SOURCE_NETWORK);
     request->send(200, "application/json", "{\"status\":\"stopped\"}");
 }
 
-String WebServerManager::getHTMLPage() {
-    return FPSTR(INDEX_HTML);
+void WebServerManager::handleTrajectory(AsyncWebServerRequest *request) {
+    // points="ms:az,ms:az,..." (ms relativo ao recebimento), append=1 para estender a fila
+    if (!request->hasParam("points", true)) {
+        request->send(400, "application/json", "{\"error\":\"missing points\"}");
+        return;
+    }
+    String text = request->getParam("points", true)->value();
+    bool append = request->hasParam("append", true) &&
+                  request->getParam("append", true)->value().toInt() != 0;
+    
+    TrajectoryWaypoint points[TRAJECTORY_MAX_WAYPOINTS];
+    uint32_t now = millis();
+    int count = 0;
+    const char* p = text.c_str();
+    while (*p && count < TRAJECTORY_MAX_WAYPOINTS) {
+        char* end;
+        long offsetMs = strtol(p, &end, 10);
+        if (end == p || *end != ':' || offsetMs < 0) break;
+        p = end + 1;
+        float azimuth = strtof(p, &end);
+        if (end == p) break;
+        points[count].timeMs = now + (uint32_t)offsetMs;
+        points[count].azimuth = azimuth;
+        count++;
+        p = end;
+        if (*p == ',') p++;
+    }
+    if (count == 0) {
+        request->send(400, "application/json", "{\"error\":\"invalid points\"}");
+        return;
+    }
+    
+    int accepted = motorController->loadTrajectory(points, count, append, COMMAND_SOURCE_NETWORK);
+    char response[64];
+    snprintf(response, sizeof(response), "{\"accepted\":%d,\"received\":%d}", accepted, count);
+    request->send(accepted > 0 ? 200 : 400, "application/json", response);
+}
+
+// ==================================================================================
+// /metrics (formato de texto do Prometheus)
+// ==================================================================================
+// Resposta chunked: cada familia e renderizada num bloco fixo so quando o
+// chunk anterior saiu. O bloco fica no estado da resposta, entao uma familia
+// partida entre dois chunks nao e renderizada de novo com valores diferentes.
+
+struct MetricsStream {
+    uint8_t family;
+    uint16_t offset;
+    uint16_t length;
+    char block[METRICS_BLOCK_SIZE];
+};
+
+void WebServerManager::handleMetrics(AsyncWebServerRequest *request) {
+    MetricsStream stream = {};
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/plain; version=0.0.4",
+        [this, stream](uint8_t *buffer, size_t maxLen, size_t) mutable -> size_t {
+            size_t used = 0;
+            while (used < maxLen) {
+                if (stream.offset >= stream.length) {
+                    if (stream.family >= METRICS_FAMILY_COUNT) break;
+                    stream.length = renderMetricsFamily(stream.family++, stream.block, sizeof(stream.block));
+                    stream.offset = 0;
+                    continue;
+                }
+                size_t n = min((size_t)(stream.length - stream.offset), maxLen - used);
+                memcpy(buffer + used, stream.block + stream.offset, n);
+                stream.offset += n;
+                used += n;
+            }
+            return used;  // 0 = fim da resposta
+        });
+    request->send(response);
+}
+
+size_t WebServerManager::renderMetricsFamily(uint8_t family, char* out, size_t size) {
+    MetricsWriter m(out, size);
+    switch (family) {
+        case 0:
+            m.family("rotor_uptime_seconds", "gauge", "Tempo desde o boot");
+            m.sample("rotor_uptime_seconds", (uint32_t)(millis() / 1000));
+            break;
+        case 1:
+            m.family("rotor_moves_started_total", "counter", "Movimentos ponto a ponto iniciados");
+            m.sample("rotor_moves_started_total", motorController->getCounters().movesStarted);
+            break;
+        case 2: {
+            MotorCounters c = motorController->getCounters();
+            m.family("rotor_moves_completed_total", "counter",
+                     "Chegadas ao alvo por criterio (tolerancia ou banda morta de 0.3 graus da zona de pulsos)");
+            m.sample("rotor_moves_completed_total", c.arrivalsTolerance, "reason=\"tolerance\"");
+            m.sample("rotor_moves_completed_total", c.arrivalsDeadband, "reason=\"deadband\"");
+            break;
+        }
+        case 3:
+            m.family("rotor_trajectories_started_total", "counter", "Trajetorias de waypoints iniciadas");
+            m.sample("rotor_trajectories_started_total", motorController->getCounters().trajectoriesStarted);
+            break;
+        case 4:
+            m.family("rotor_stops_total", "counter", "Paradas (freio ativo) aplicadas");
+            m.sample("rotor_stops_total", motorController->getCommandStats().stops);
+            break;
+        case 5: {
+            MotorCounters c = motorController->getCounters();
+            m.family("rotor_cable_limit_excursions_total", "counter", "Posicao absoluta alem de +-180 graus");
+            m.sample("rotor_cable_limit_excursions_total", c.limitExcursionsCW, "direction=\"cw\"");
+            m.sample("rotor_cable_limit_excursions_total", c.limitExcursionsCCW, "direction=\"ccw\"");
+            break;
+        }
+        case 6:
+            m.family("rotor_absolute_position_degrees", "gauge", "Posicao absoluta (protecao do cabo)");
+            m.sample("rotor_absolute_position_degrees", motorController->getState().absolutePosition);
+            break;
+        case 7:
+            m.family("rotor_learning_cycles", "gauge", "Ciclos do aprendizado adaptativo");
+            m.sample("rotor_learning_cycles", (uint32_t)motorController->getLearningCycles());
+            break;
+        case 8:
+            m.family("rotor_ws_clients", "gauge", "Clientes WebSocket conectados");
+            m.sample("rotor_ws_clients", (uint32_t)ws->count());
+            break;
+        case 9:
+            m.family("rotor_ws_frames_dropped_total", "counter", "Frames WebSocket descartados (cliente sem espaco de envio)");
+            m.sample("rotor_ws_frames_dropped_total", wsDroppedFrames);
+            break;
+        case 10:
+            m.family("rotor_nvs_writes_total", "counter", "Gravacoes efetivas na NVS");
+            m.sample("rotor_nvs_writes_total", storage->getFlashWrites());
+            break;
+        case 11:
+            m.family("rotor_nvs_bytes_written_total", "counter", "Bytes gravados na NVS");
+            m.sample("rotor_nvs_bytes_written_total", storage->getFlashBytes());
+            break;
+        case 12:
+            m.family("rotor_heap_free_bytes", "gauge", "Heap livre");
+            m.sample("rotor_heap_free_bytes", ESP.getFreeHeap());
+            break;
+        case 13:
+            m.family("rotor_heap_largest_free_block_bytes", "gauge", "Maior bloco livre do heap (fragmentacao)");
+            m.sample("rotor_heap_largest_free_block_bytes", ESP.getMaxAllocHeap());
+            break;
+        case 14:
+            m.family("rotor_control_loop_cycles_total", "counter", "Ciclos do loop de controle");
+            m.sample("rotor_control_loop_cycles_total", controlLoop.getCycles());
+            break;
+        case 15:
+            m.family("rotor_control_loop_overruns_total", "counter", "Ticks do loop de controle perdidos");
+            m.sample("rotor_control_loop_overruns_total", controlLoop.getOverruns());
+            break;
+        case 16: {
+            MotorCommandStats c = motorController->getCommandStats();
+            m.family("rotor_commands_total", "counter", "Comandos das filas da motorTask por resultado");
+            m.sample("rotor_commands_total", c.applied, "result=\"applied\"");
+            m.sample("rotor_commands_total", c.coalesced, "result=\"coalesced\"");
+            m.sample("rotor_commands_total", c.discardedByStop, "result=\"discarded_by_stop\"");
+            m.sample("rotor_commands_total", c.dropped, "result=\"dropped\"");
+            break;
+        }
+        case 17:
+            m.family("rotor_log_records_dropped_total", "counter", "Registros de log perdidos por fila cheia");
+            m.sample("rotor_log_records_dropped_total", deferredLog.getDropped());
+            break;
+        case 18:
+            m.family("rotor_early_brakes_total", "counter", "Cortes antecipados pelo modelo de frenagem (zona PID)");
+            m.sample("rotor_early_brakes_total", motorController->getCounters().earlyBrakes);
+            break;
+    }
+    return m.length();
+}
+
+#if TRACE_ENABLED
+// ==================================================================================
+// DOWNLOAD DO TRACE (chunked, lido direto do anel)
+// ==================================================================================
+// O anel fica travado (TRACE_READING) enquanto existir a resposta: o estado
+// do download e compartilhado pelas copias do filler e o ultimo a sair libera.
+
+struct TraceDownload {
+    bool csv;
+    uint32_t offset;               // Binario: byte do fluxo; CSV: proxima amostra
+    uint16_t lineOffset;
+    uint16_t lineLength;
+    char line[TRACE_CSV_LINE_SIZE];
+    ~TraceDownload() { traceRecorder.endRead(); }
+};
+
+void WebServerManager::handleTraceDownload(AsyncWebServerRequest *request) {
+    if (!traceRecorder.beginRead()) {
+        request->send(409, "application/json", "{\"error\":\"trace ocupado\"}");
+        return;
+    }
+    if (traceRecorder.getCount() == 0) {
+        traceRecorder.endRead();
+        request->send(404, "application/json", "{\"error\":\"nenhuma captura\"}");
+        return;
+    }
+
+    std::shared_ptr<TraceDownload> download(new TraceDownload());
+    download->csv = request->hasParam("format") && request->getParam("format")->value() == "csv";
+    download->lineLength = download->csv ? TraceRecorder::formatCsvHeader(download->line, sizeof(download->line)) : 0;
+
+    AsyncWebServerResponse *response;
+    if (!download->csv) {
+        response = request->beginChunkedResponse("application/octet-stream",
+            [download](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+                size_t n = traceRecorder.readBinary(download->offset, buffer, maxLen);
+                download->offset += n;
+                return n;
+            });
+        response->addHeader("Content-Disposition", "attachment; filename=\"trace.bin\"");
+    } else {
+        response = request->beginChunkedResponse("text/csv",
+            [download](uint8_t *buffer, size_t maxLen, size_t) -> size_t {
+                TraceDownload& d = *download;
+                size_t used = 0;
+                while (used < maxLen) {
+                    if (d.lineOffset >= d.lineLength) {
+                        d.lineLength = traceRecorder.formatCsvLine(d.offset, d.line, sizeof(d.line));
+                        d.lineOffset = 0;
+                        if (d.lineLength == 0) break;
+                        d.offset++;
+                    }
+                    size_t n = min((size_t)(d.lineLength - d.lineOffset), maxLen - used);
+                    memcpy(buffer + used, d.line + d.lineOffset, n);
+                    d.lineOffset += n;
+                    used += n;
+                }
+                return used;
+            });
+        response->addHeader("Content-Disposition", "attachment; filename=\"trace.csv\"");
+    }
+    request->send(response);
+}
+#endif
+
+void WebServerManager::handleDiag(AsyncWebServerRequest *request) {
+    // Contadores de contencao entre a motorTask e as tasks de rede
+    DynamicJsonDocument doc(4096);
+    MotorState state = motorController->getState();
+    doc["stateCycle"] = state.cycle;
+    MotorCommandStats commands = motorController->getCommandStats();
+    JsonObject commandsOut = doc.createNestedObject("commands");
+    commandsOut["applied"] = commands.applied;
+    commandsOut["coalesced"] = commands.coalesced;
+    commandsOut["discardedByStop"] = commands.discardedByStop;
+    commandsOut["stops"] = commands.stops;
+    commandsOut["dropped"] = commands.dropped;
+    commandsOut["pending"] = commands.pending;
+    doc["motorSnapshotRetries"] = motorController->getSnapshotRetries();
+    doc["encoderSnapshotRetries"] = encoder->getSnapshotRetries();
+    // Captura de bordas: total desde o boot e origem da velocidade publicada agora
+    doc["encoderEdges"] = encoder->getEdgeCount();
+    doc["velocitySource"] = encoder->getState().velocitySource == ENCODER_VEL_SOURCE_EDGES ? "edges" : "counts";
+    motorController->writeObserverJSON(doc.createNestedObject("observer"));
+    #if MT6701_ENABLED
+    // Angulo absoluto I2C, fase e divergencias/correcoes da contagem
+    absoluteEncoder.writeJSON(doc.createNestedObject("absoluteEncoder"));
+    #endif
+    doc["trajectoryDepth"] = motorController->getTrajectoryDepth();
+    doc["trajectoryReference"] = motorController->getTrajectoryReference();
+    // Modelo de frenagem por sentido (parametros, incerteza, previsao de referencia)
+    motorController->writeBrakingJSON(doc.createNestedObject("brakingModel"));
+    
+    // Desgaste da flash: save*() recebidos x gravacoes NVS efetivas
+    storage->writeStatsJSON(doc.createNestedObject("storage"));
+    deferredLog.writeStatsJSON(doc.createNestedObject("log"));
+    #if JOURNAL_ENABLED
+    positionJournal.writeStatsJSON(doc.createNestedObject("journal"));
+    #endif
+    
+    // Clientes WebSocket e frames descartados por controle de fluxo
+    doc["wsDroppedFrames"] = wsDroppedFrames;
+    JsonArray clientsOut = doc.createNestedArray("wsClients");
+    WsClientState clients[WS_MAX_CLIENTS];
+    portENTER_CRITICAL(&clientsMux);
+    memcpy(clients, wsClients, sizeof(clients));
+    portEXIT_CRITICAL(&clientsMux);
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (clients[i].id == 0) continue;
+        JsonObject c = clientsOut.createNestedObject();
+        c["id"] = clients[i].id;
+        c["format"] = clients[i].binary ? "binary" : "json";
+        c["streamHz"] = clients[i].streamHz;
+        c["dropped"] = (wsStream[i].id == clients[i].id) ? wsStream[i].dropped : 0;
+    }
+    String output;
+    serializeJson(doc, output);
+    request->send(200, "application/json", output);
 }
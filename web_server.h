@@ -7,6 +7,36 @@
 #include "motor_control.h"
 #include "encoder.h"
 #include "storage.h"
+#include "telemetry.h"
+
+#define WS_MAX_CLIENTS 8             // Igual ao limite padrao do AsyncWebSocket
+#define WS_JSON_BUFFER_SIZE 384
+#define WS_COMMAND_JSON_SIZE 2048    // Comandos recebidos (cabe uma trajetoria cheia)
+#define METRICS_BLOCK_SIZE 512       // Uma familia do /metrics renderizada por vez
+#define METRICS_FAMILY_COUNT 19
+#define TRACE_CSV_LINE_SIZE 112      // Uma amostra do trace em CSV
+
+// Cache dos assets estaticos (web_assets_gz.h)
+#define ASSET_CACHE_IMMUTABLE "public, max-age=31536000, immutable"
+#define ASSET_CACHE_REVALIDATE "no-cache"
+
+// Estado por cliente WebSocket (formato negociado na conexao)
+struct WsClientState {
+    uint32_t id;                     // 0 = slot livre
+    bool binary;                     // true = recebe TelemetryFrame (WS_BINARY)
+    uint16_t streamHz;               // 0 = modo legado (heartbeat 1Hz + fim de movimento)
+};
+
+// Estado de envio por slot (somente loop(), sem lock)
+struct WsStreamState {
+    uint32_t id;                     // Cliente a que o estado pertence (slot reutilizado = reset)
+    bool binary;
+    bool hasKeyframe;                // Cliente ja recebeu um frame completo
+    unsigned long lastSendMs;
+    unsigned long lastKeyframeMs;
+    uint32_t dropped;                // Frames descartados por fila cheia
+    TelemetryFrame lastSent;         // Base dos deltas
+};
 
 class WebServerManager {
 private:
@@ -20,16 +50,38 @@ private:
     bool runtimeMotorInvert = false;
     bool runtimeEncoderInvert = false;
     
+    // Clientes WebSocket (async_tcp escreve, loop() le no broadcast)
+    WsClientState wsClients[WS_MAX_CLIENTS] = {};
+    portMUX_TYPE clientsMux = portMUX_INITIALIZER_UNLOCKED;
+    WsStreamState wsStream[WS_MAX_CLIENTS] = {};
+    uint32_t wsDroppedFrames = 0;
+    bool wasMoving = false;
+    unsigned long lastLegacySend = 0;
+    
     void handleRoot(AsyncWebServerRequest *request);
+    void sendGzipAsset(AsyncWebServerRequest *request, const char* contentType,
+                       const uint8_t* data, size_t len, const char* etag, const char* cacheControl);
     void handleStatus(AsyncWebServerRequest *request);
     void handleSetAngle(AsyncWebServerRequest *request);
     void handleManualControl(AsyncWebServerRequest *request);
     void handleCalibrate(AsyncWebServerRequest *request);
     void handleStop(AsyncWebServerRequest *request);
+    void handleDiag(AsyncWebServerRequest *request);
+    void handleTrajectory(AsyncWebServerRequest *request);
+    void handleMetrics(AsyncWebServerRequest *request);
+    size_t renderMetricsFamily(uint8_t family, char* out, size_t size);
+    void handleTraceDownload(AsyncWebServerRequest *request);
     void onWebSocketEvent(AsyncWebSocket *server, AsyncWebSocketClient *client,
                           AwsEventType type, void *arg, uint8_t *data, size_t len);
     String getStatusJSON();
-    String getHTMLPage();
+    size_t writeStatusJSON(char* out, size_t size);
+    void buildTelemetryFrame(TelemetryFrame& frame);
+    void sendStatusTo(AsyncWebSocketClient *client, bool binary);
+    void registerClient(uint32_t id);
+    void unregisterClient(uint32_t id);
+    void setClientBinary(uint32_t id, bool binary);
+    void setClientStream(uint32_t id, uint16_t hz);
+    void sendStreamFrame(uint32_t id, WsStreamState& stream, unsigned long now, const TelemetryFrame& frame);
     
 public:
     WebServerManager(MotorController* motor, Encoder* enc, StorageManager* store);